@@ -0,0 +1,559 @@
+/////////////////////////////////////
+// CPU backend benchmark suite
+//
+//   times the bundled Thrust algorithms on the OpenMP device backend
+//   (device_vector) and on the host path (host_vector) against their
+//   std:: equivalents, sweeping sizes, key types and thread counts
+//
+//   usage: cpu_backends [options]
+//     --min-size=N       smallest input size             (default 1024)
+//     --max-size=N       largest input size              (default 16M)
+//     --threads=a,b,..   OpenMP thread counts            (default 1,2,4,.. up to the max)
+//     --types=a,b,..     int32,int64,float,double,pair   (default all)
+//     --algorithms=a,..  sort,sort_by_key,reduce,scan,copy_if,
+//                        transform_reduce,set_union,set_intersection (default all)
+//     --format=csv|json  output format                   (default csv)
+//     --output=FILE      write results to FILE instead of stdout
+//     --baseline=FILE    compare against an earlier csv run
+//     --tolerance=X      allowed slowdown against the baseline (default 0.10)
+//
+//   sizes grow by a factor of four; --max-size=1073741824 runs the full
+//   1K..1G sweep given enough memory.  with --baseline the program exits
+//   with status 1 when any result is slower than the baseline by more
+//   than the tolerance, so it can gate a nightly job.
+/////////////////////////////////////
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <omp.h>
+
+#include <thrust/host_vector.h>
+#include <thrust/device_vector.h>
+#include <thrust/pair.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+#include <thrust/copy.h>
+#include <thrust/remove.h>
+#include <thrust/transform_reduce.h>
+#include <thrust/functional.h>
+#include <thrust/set_union.h>
+#include <thrust/set_intersection.h>
+
+/////////////////////////////////////
+// configuration section
+/////////////////////////////////////
+
+// each measurement repeats until it has run at least this long (seconds)
+#define MIN_MEASURE_TIME 0.05
+#define MIN_REPEATS      3
+#define MAX_REPEATS      1000
+
+typedef thrust::pair<int, int> int_pair;
+
+struct config {
+    size_t min_size;
+    size_t max_size;
+    std::vector<int> threads;
+    std::vector<std::string> types;
+    std::vector<std::string> algorithms;
+    std::string format;
+    std::string output;
+    std::string baseline;
+    double tolerance;
+};
+
+struct result {
+    std::string algorithm;
+    std::string type;
+    std::string backend;
+    int threads;
+    size_t n;
+    double seconds;
+};
+
+/////////////////////////////////////
+// option parsing
+/////////////////////////////////////
+std::vector<std::string> split(const std::string& s) {
+    std::vector<std::string> parts;
+    size_t start = 0;
+    while (start <= s.size()) {
+        size_t comma = s.find(',', start);
+        if (comma == std::string::npos) { comma = s.size(); }
+        if (comma > start) { parts.push_back(s.substr(start, comma - start)); }
+        start = comma + 1;
+    }
+    return parts;
+}
+
+bool has(const std::vector<std::string>& list, const char* name) {
+    return std::find(list.begin(), list.end(), std::string(name)) != list.end();
+}
+
+bool parse_options(int argc, char** argv, config& cfg) {
+    cfg.min_size  = 1 << 10;
+    cfg.max_size  = 1 << 24;
+    cfg.format    = "csv";
+    cfg.tolerance = 0.10;
+    cfg.types      = split("int32,int64,float,double,pair");
+    cfg.algorithms = split("sort,sort_by_key,reduce,scan,copy_if,transform_reduce,set_union,set_intersection");
+    for (int t = 1; t < omp_get_max_threads(); t *= 2) { cfg.threads.push_back(t); }
+    cfg.threads.push_back(omp_get_max_threads());
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        size_t eq = arg.find('=');
+        std::string key   = arg.substr(0, eq);
+        std::string value = (eq == std::string::npos) ? std::string() : arg.substr(eq + 1);
+
+        if (key == "--min-size") { cfg.min_size = strtoul(value.c_str(), 0, 10); }
+        else if (key == "--max-size") { cfg.max_size = strtoul(value.c_str(), 0, 10); }
+        else if (key == "--types") { cfg.types = split(value); }
+        else if (key == "--algorithms") { cfg.algorithms = split(value); }
+        else if (key == "--format") { cfg.format = value; }
+        else if (key == "--output") { cfg.output = value; }
+        else if (key == "--baseline") { cfg.baseline = value; }
+        else if (key == "--tolerance") { cfg.tolerance = atof(value.c_str()); }
+        else if (key == "--threads") {
+            std::vector<std::string> list = split(value);
+            cfg.threads.clear();
+            for (size_t k = 0; k < list.size(); ++k) { cfg.threads.push_back(atoi(list[k].c_str())); }
+        } else {
+            fprintf(stderr, "unknown option %s\n", argv[i]);
+            return false;
+        }
+    }
+
+    if (cfg.format != "csv" && cfg.format != "json") {
+        fprintf(stderr, "unknown format %s\n", cfg.format.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+/////////////////////////////////////
+// input generation
+/////////////////////////////////////
+inline unsigned int lcg(unsigned int& state) {
+    state = state * 1664525u + 1013904223u;
+    return state;
+}
+
+inline void make_value(unsigned int r, int& x)       { x = int(r >> 1); }
+inline void make_value(unsigned int r, long long& x) { x = ((long long)(r >> 1) << 20) ^ (long long) r; }
+inline void make_value(unsigned int r, float& x)     { x = float(r) / 4294967296.0f; }
+inline void make_value(unsigned int r, double& x)    { x = double(r) / 4294967296.0; }
+inline void make_value(unsigned int r, int_pair& x)  { x = int_pair(int(r % 1024), int(r >> 10)); }
+
+template<typename T>
+std::vector<T> make_input(size_t n, unsigned int seed) {
+    std::vector<T> data(n);
+    for (size_t i = 0; i < n; ++i) { make_value(lcg(seed), data[i]); }
+    return data;
+}
+
+// only the ordering algorithms run on pairs
+template<typename T> struct is_arithmetic_key { static const bool value = true; };
+template<> struct is_arithmetic_key<int_pair> { static const bool value = false; };
+
+/////////////////////////////////////
+// functors
+/////////////////////////////////////
+template<typename T>
+struct not_less_than {
+    T bound;
+    not_less_than(T bound) : bound(bound) {}
+    __host__ __device__
+    bool operator()(const T& x) const { return !(x < bound); }
+};
+
+template<typename T>
+struct square {
+    __host__ __device__
+    T operator()(const T& x) const { return x * x; }
+};
+
+/////////////////////////////////////
+// timing
+/////////////////////////////////////
+
+// runs the benchmark body repeatedly and returns the fastest run;
+// prepare() restores the input before every run and is not timed
+template<typename Benchmark>
+double measure(Benchmark& bench) {
+    double best  = 1e30;
+    double total = 0;
+
+    for (int r = 0; r < MAX_REPEATS && (r < MIN_REPEATS || total < MIN_MEASURE_TIME); ++r) {
+        bench.prepare();
+        double t0 = omp_get_wtime();
+        bench.run();
+        double t = omp_get_wtime() - t0;
+        total += t;
+        if (t < best) { best = t; }
+    }
+
+    return best;
+}
+
+/////////////////////////////////////
+// benchmarks: one struct per algorithm, templated on the container
+// (host_vector, device_vector, or std::vector for the std:: baseline)
+/////////////////////////////////////
+template<typename Vector>
+struct sort_bench {
+    const std::vector<typename Vector::value_type>& input;
+    Vector data;
+    sort_bench(const std::vector<typename Vector::value_type>& input) : input(input), data(input.size()) {}
+    void prepare() { thrust::copy(input.begin(), input.end(), data.begin()); }
+    void run() { thrust::sort(data.begin(), data.end()); }
+};
+
+template<typename T>
+struct std_sort_bench {
+    const std::vector<T>& input;
+    std::vector<T> data;
+    std_sort_bench(const std::vector<T>& input) : input(input), data(input.size()) {}
+    void prepare() { std::copy(input.begin(), input.end(), data.begin()); }
+    void run() { std::sort(data.begin(), data.end()); }
+};
+
+template<typename Vector, typename ValueVector>
+struct sort_by_key_bench {
+    const std::vector<typename Vector::value_type>& input;
+    Vector keys;
+    ValueVector values;
+    sort_by_key_bench(const std::vector<typename Vector::value_type>& input)
+        : input(input), keys(input.size()), values(input.size()) {}
+    void prepare() {
+        thrust::copy(input.begin(), input.end(), keys.begin());
+        thrust::sequence(values.begin(), values.end());
+    }
+    void run() { thrust::sort_by_key(keys.begin(), keys.end(), values.begin()); }
+};
+
+// std:: has no sort_by_key; sort (key, index) pairs instead
+template<typename T>
+struct std_sort_by_key_bench {
+    const std::vector<T>& input;
+    std::vector<std::pair<T, int> > data;
+    std_sort_by_key_bench(const std::vector<T>& input) : input(input), data(input.size()) {}
+    void prepare() {
+        for (size_t i = 0; i < input.size(); ++i) { data[i] = std::make_pair(input[i], int(i)); }
+    }
+    void run() { std::stable_sort(data.begin(), data.end(), key_less()); }
+    struct key_less {
+        bool operator()(const std::pair<T, int>& a, const std::pair<T, int>& b) const { return a.first < b.first; }
+    };
+};
+
+template<typename Vector>
+struct reduce_bench {
+    typedef typename Vector::value_type T;
+    Vector data;
+    T sum;
+    reduce_bench(const std::vector<T>& input) : data(input.begin(), input.end()) {}
+    void prepare() {}
+    void run() { sum = thrust::reduce(data.begin(), data.end()); }
+};
+
+template<typename T>
+struct std_reduce_bench {
+    const std::vector<T>& data;
+    T sum;
+    std_reduce_bench(const std::vector<T>& input) : data(input) {}
+    void prepare() {}
+    void run() { sum = std::accumulate(data.begin(), data.end(), T(0)); }
+};
+
+template<typename Vector>
+struct scan_bench {
+    typedef typename Vector::value_type T;
+    Vector data;
+    Vector output;
+    scan_bench(const std::vector<T>& input) : data(input.begin(), input.end()), output(input.size()) {}
+    void prepare() {}
+    void run() { thrust::inclusive_scan(data.begin(), data.end(), output.begin()); }
+};
+
+template<typename T>
+struct std_scan_bench {
+    const std::vector<T>& data;
+    std::vector<T> output;
+    std_scan_bench(const std::vector<T>& input) : data(input), output(input.size()) {}
+    void prepare() {}
+    void run() { std::partial_sum(data.begin(), data.end(), output.begin()); }
+};
+
+template<typename T>
+T median_of(const std::vector<T>& input) {
+    std::vector<T> copy(input);
+    std::nth_element(copy.begin(), copy.begin() + copy.size() / 2, copy.end());
+    return copy[copy.size() / 2];
+}
+
+// keeps the half of the input below its median
+template<typename Vector>
+struct copy_if_bench {
+    typedef typename Vector::value_type T;
+    Vector data;
+    Vector output;
+    T bound;
+    copy_if_bench(const std::vector<T>& input) : data(input.begin(), input.end()), output(input.size()), bound(median_of(input)) {}
+    void prepare() {}
+    void run() { thrust::remove_copy_if(data.begin(), data.end(), output.begin(), not_less_than<T>(bound)); }
+};
+
+template<typename T>
+struct std_copy_if_bench {
+    const std::vector<T>& data;
+    std::vector<T> output;
+    T bound;
+    std_copy_if_bench(const std::vector<T>& input)
+        : data(input), output(input.size()), bound(median_of(input)) {}
+    void prepare() {}
+    void run() { std::remove_copy_if(data.begin(), data.end(), output.begin(), not_less_than<T>(bound)); }
+};
+
+// sum of squares
+template<typename Vector>
+struct transform_reduce_bench {
+    typedef typename Vector::value_type T;
+    Vector data;
+    T sum;
+    transform_reduce_bench(const std::vector<T>& input) : data(input.begin(), input.end()) {}
+    void prepare() {}
+    void run() { sum = thrust::transform_reduce(data.begin(), data.end(), square<T>(), T(0), thrust::plus<T>()); }
+};
+
+template<typename T>
+struct std_transform_reduce_bench {
+    const std::vector<T>& data;
+    T sum;
+    std_transform_reduce_bench(const std::vector<T>& input) : data(input) {}
+    void prepare() {}
+    void run() { sum = std::inner_product(data.begin(), data.end(), data.begin(), T(0)); }
+};
+
+// the two halves of the input, each sorted, are the two sets
+template<typename Vector, bool Union>
+struct set_op_bench {
+    typedef typename Vector::value_type T;
+    Vector data;
+    Vector output;
+    size_t half;
+    set_op_bench(const std::vector<T>& input) : data(input.size()), output(input.size()), half(input.size() / 2) {
+        std::vector<T> sorted(input);
+        std::sort(sorted.begin(), sorted.begin() + half);
+        std::sort(sorted.begin() + half, sorted.end());
+        thrust::copy(sorted.begin(), sorted.end(), data.begin());
+    }
+    void prepare() {}
+    void run() {
+        if (Union) {
+            thrust::set_union(data.begin(), data.begin() + half, data.begin() + half, data.end(), output.begin());
+        } else {
+            thrust::set_intersection(data.begin(), data.begin() + half, data.begin() + half, data.end(), output.begin());
+        }
+    }
+};
+
+template<typename T, bool Union>
+struct std_set_op_bench {
+    std::vector<T> data;
+    std::vector<T> output;
+    size_t half;
+    std_set_op_bench(const std::vector<T>& input) : data(input), output(input.size()), half(input.size() / 2) {
+        std::sort(data.begin(), data.begin() + half);
+        std::sort(data.begin() + half, data.end());
+    }
+    void prepare() {}
+    void run() {
+        if (Union) {
+            std::set_union(data.begin(), data.begin() + half, data.begin() + half, data.end(), output.begin());
+        } else {
+            std::set_intersection(data.begin(), data.begin() + half, data.begin() + half, data.end(), output.begin());
+        }
+    }
+};
+
+/////////////////////////////////////
+// sweep
+/////////////////////////////////////
+void record(std::vector<result>& results, const char* algorithm, const char* type,
+            const char* backend, int threads, size_t n, double seconds) {
+    result r;
+    r.algorithm = algorithm;
+    r.type      = type;
+    r.backend   = backend;
+    r.threads   = threads;
+    r.n         = n;
+    r.seconds   = seconds;
+    results.push_back(r);
+    fprintf(stderr, "%-17s %-7s %-5s %3d %11lu %12.6f\n", algorithm, type, backend, threads, (unsigned long) n, seconds);
+}
+
+// times one algorithm on the OpenMP backend for every thread count, and
+// once each on the host path and with std::
+template<typename DeviceBench, typename HostBench, typename StdBench, typename T>
+void sweep(const config& cfg, std::vector<result>& results, const char* algorithm, const char* type,
+           const std::vector<T>& input) {
+    if (!has(cfg.algorithms, algorithm)) { return; }
+
+    size_t n = input.size();
+
+    for (size_t k = 0; k < cfg.threads.size(); ++k) {
+        omp_set_num_threads(cfg.threads[k]);
+        DeviceBench bench(input);
+        record(results, algorithm, type, "omp", cfg.threads[k], n, measure(bench));
+    }
+
+    HostBench host_bench(input);
+    record(results, algorithm, type, "host", 1, n, measure(host_bench));
+
+    StdBench std_bench(input);
+    record(results, algorithm, type, "std", 1, n, measure(std_bench));
+}
+
+template<typename T, bool Arithmetic>
+struct arithmetic_sweep {
+    static void run(const config&, std::vector<result>&, const char*, const std::vector<T>&) {}
+};
+
+template<typename T>
+struct arithmetic_sweep<T, true> {
+    static void run(const config& cfg, std::vector<result>& results, const char* type, const std::vector<T>& input) {
+        typedef thrust::device_vector<T> dvec;
+        typedef thrust::host_vector<T>   hvec;
+
+        sweep<reduce_bench<dvec>, reduce_bench<hvec>, std_reduce_bench<T> >(cfg, results, "reduce", type, input);
+        sweep<scan_bench<dvec>, scan_bench<hvec>, std_scan_bench<T> >(cfg, results, "scan", type, input);
+        sweep<transform_reduce_bench<dvec>, transform_reduce_bench<hvec>, std_transform_reduce_bench<T> >
+        (cfg, results, "transform_reduce", type, input);
+    }
+};
+
+template<typename T>
+void bench_type(const config& cfg, std::vector<result>& results, const char* type) {
+    if (!has(cfg.types, type)) { return; }
+
+    typedef thrust::device_vector<T> dvec;
+    typedef thrust::host_vector<T>   hvec;
+
+    for (size_t n = cfg.min_size; n <= cfg.max_size; n *= 4) {
+        std::vector<T> input = make_input<T>(n, 2010);
+
+        sweep<sort_bench<dvec>, sort_bench<hvec>, std_sort_bench<T> >(cfg, results, "sort", type, input);
+        sweep<sort_by_key_bench<dvec, thrust::device_vector<int> >, sort_by_key_bench<hvec, thrust::host_vector<int> >,
+              std_sort_by_key_bench<T> >(cfg, results, "sort_by_key", type, input);
+        sweep<copy_if_bench<dvec>, copy_if_bench<hvec>, std_copy_if_bench<T> >(cfg, results, "copy_if", type, input);
+        sweep<set_op_bench<dvec, true>, set_op_bench<hvec, true>, std_set_op_bench<T, true> >
+        (cfg, results, "set_union", type, input);
+        sweep<set_op_bench<dvec, false>, set_op_bench<hvec, false>, std_set_op_bench<T, false> >
+        (cfg, results, "set_intersection", type, input);
+
+        arithmetic_sweep<T, is_arithmetic_key<T>::value>::run(cfg, results, type, input);
+    }
+}
+
+/////////////////////////////////////
+// output
+/////////////////////////////////////
+std::string result_key(const std::string& algorithm, const std::string& type, const std::string& backend,
+                       int threads, unsigned long n) {
+    char buffer[256];
+    sprintf(buffer, "%s,%s,%s,%d,%lu", algorithm.c_str(), type.c_str(), backend.c_str(), threads, n);
+    return buffer;
+}
+
+void write_results(FILE* out, const config& cfg, const std::vector<result>& results) {
+    if (cfg.format == "csv") {
+        fprintf(out, "algorithm,type,backend,threads,n,seconds,melements_per_second\n");
+        for (size_t i = 0; i < results.size(); ++i) {
+            const result& r = results[i];
+            fprintf(out, "%s,%.9f,%.3f\n", result_key(r.algorithm, r.type, r.backend, r.threads, r.n).c_str(),
+                    r.seconds, r.n / r.seconds / 1e6);
+        }
+    } else {
+        fprintf(out, "[\n");
+        for (size_t i = 0; i < results.size(); ++i) {
+            const result& r = results[i];
+            fprintf(out, "  {\"algorithm\": \"%s\", \"type\": \"%s\", \"backend\": \"%s\", \"threads\": %d, "
+                    "\"n\": %lu, \"seconds\": %.9f, \"melements_per_second\": %.3f}%s\n",
+                    r.algorithm.c_str(), r.type.c_str(), r.backend.c_str(), r.threads, (unsigned long) r.n,
+                    r.seconds, r.n / r.seconds / 1e6, (i + 1 < results.size()) ? "," : "");
+        }
+        fprintf(out, "]\n");
+    }
+}
+
+// returns the number of results slower than the csv baseline by more than the tolerance
+int check_baseline(const config& cfg, const std::vector<result>& results) {
+    FILE* in = fopen(cfg.baseline.c_str(), "r");
+    if (in == NULL) {
+        fprintf(stderr, "cannot open baseline %s\n", cfg.baseline.c_str());
+        return 1;
+    }
+
+    std::map<std::string, double> baseline;
+    char line[512];
+    while (fgets(line, sizeof(line), in) != NULL) {
+        // the key is the first five fields, everything before the fifth comma
+        std::string s(line);
+        size_t pos = 0;
+        for (int field = 0; field < 5 && pos != std::string::npos; ++field) { pos = s.find(',', pos + 1); }
+        if (pos == std::string::npos) { continue; }
+        baseline[s.substr(0, pos)] = atof(s.c_str() + pos + 1);
+    }
+    fclose(in);
+
+    int regressions = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const result& r = results[i];
+        std::string key = result_key(r.algorithm, r.type, r.backend, r.threads, r.n);
+        std::map<std::string, double>::const_iterator base = baseline.find(key);
+        if (base != baseline.end() && base->second > 0 && r.seconds > base->second * (1.0 + cfg.tolerance)) {
+            fprintf(stderr, "regression: %s %.6f s (baseline %.6f s, %+.1f%%)\n", key.c_str(), r.seconds,
+                    base->second, 100.0 * (r.seconds / base->second - 1.0));
+            ++regressions;
+        }
+    }
+
+    return regressions;
+}
+
+/////////////////////////////////////
+// main
+/////////////////////////////////////
+int main(int argc, char** argv) {
+    config cfg;
+    if (!parse_options(argc, argv, cfg)) { return 2; }
+
+    std::vector<result> results;
+    bench_type<int>(cfg, results, "int32");
+    bench_type<long long>(cfg, results, "int64");
+    bench_type<float>(cfg, results, "float");
+    bench_type<double>(cfg, results, "double");
+    bench_type<int_pair>(cfg, results, "pair");
+
+    FILE* out = cfg.output.empty() ? stdout : fopen(cfg.output.c_str(), "w");
+    if (out == NULL) {
+        fprintf(stderr, "cannot open %s\n", cfg.output.c_str());
+        return 2;
+    }
+    write_results(out, cfg, results);
+    if (out != stdout) { fclose(out); }
+
+    if (!cfg.baseline.empty() && check_baseline(cfg, results) > 0) { return 1; }
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+/////////////////////////////////////
+// first touch bandwidth benchmark
+//
+//   compares the bandwidth of parallel passes over host vectors whose
+//   pages were placed by a serial value-initialization against vectors
+//   allocated with first_touch_allocator
+//
+//   usage: first_touch_bandwidth [n_elements] [repeats]
+//   run with OMP_PROC_BIND=true so threads stay on their NUMA nodes
+/////////////////////////////////////
+#include <cstdio>
+#include <cstdlib>
+#include <omp.h>
+
+#include <thrust/host_vector.h>
+#include <thrust/device_ptr.h>
+#include <thrust/fill.h>
+#include <thrust/transform.h>
+#include <thrust/reduce.h>
+#include <thrust/experimental/first_touch_allocator.h>
+
+/////////////////////////////////////
+// kernels
+/////////////////////////////////////
+struct triad {
+    float s;
+    triad(float s) : s(s) {}
+    __host__ __device__
+    float operator()(const float& b, const float& c) const { return b + s * c; }
+};
+
+/////////////////////////////////////
+// run the passes on the OpenMP device backend over host memory,
+// returning the best bandwidth of each in GB/s
+/////////////////////////////////////
+void run_passes(float* a, float* b, float* c, size_t n, int repeats, double* triad_gbs, double* reduce_gbs) {
+    thrust::device_ptr<float> da(a), db(b), dc(c);
+    double best_triad  = 1e30;
+    double best_reduce = 1e30;
+    float sum = 0;
+
+    for (int r = 0; r < repeats; ++r) {
+        double t0 = omp_get_wtime();
+        thrust::transform(db, db + n, dc, da, triad(3.0f));
+        double t1 = omp_get_wtime();
+        sum += thrust::reduce(da, da + n);
+        double t2 = omp_get_wtime();
+
+        if (t1 - t0 < best_triad)  { best_triad  = t1 - t0; }
+        if (t2 - t1 < best_reduce) { best_reduce = t2 - t1; }
+    }
+
+    // keep the reductions alive
+    if (sum == 12345.0f) { printf(" "); }
+
+    *triad_gbs  = 3.0 * n * sizeof(float) / best_triad  / 1e9;
+    *reduce_gbs = 1.0 * n * sizeof(float) / best_reduce / 1e9;
+}
+
+/////////////////////////////////////
+// serial placement: the usual resize, value-initialized by one thread
+/////////////////////////////////////
+void bench_serial(size_t n, int repeats) {
+    thrust::host_vector<float> a, b, c;
+    double t0 = omp_get_wtime();
+    a.resize(n);
+    b.resize(n, 1.0f);
+    c.resize(n, 2.0f);
+    double t_init = omp_get_wtime() - t0;
+
+    double triad_gbs, reduce_gbs;
+    run_passes(&a[0], &b[0], &c[0], n, repeats, &triad_gbs, &reduce_gbs);
+    printf("%-12s %10.1f %12.2f %12.2f\n", "serial", t_init * 1000.0, triad_gbs, reduce_gbs);
+}
+
+/////////////////////////////////////
+// first touch placement: pages placed by the allocator, no value-init
+/////////////////////////////////////
+void bench_first_touch(size_t n, int repeats) {
+    typedef thrust::host_vector<float, thrust::experimental::first_touch_allocator<float> > vector_type;
+    vector_type a, b, c;
+    double t0 = omp_get_wtime();
+    a.uninitialized_resize(n);
+    b.uninitialized_resize(n);
+    c.uninitialized_resize(n);
+    double t_init = omp_get_wtime() - t0;
+
+    // fill in parallel, as the data would be produced
+    thrust::device_ptr<float> db(&b[0]), dc(&c[0]);
+    thrust::fill(db, db + n, 1.0f);
+    thrust::fill(dc, dc + n, 2.0f);
+
+    double triad_gbs, reduce_gbs;
+    run_passes(&a[0], &b[0], &c[0], n, repeats, &triad_gbs, &reduce_gbs);
+    printf("%-12s %10.1f %12.2f %12.2f\n", "first_touch", t_init * 1000.0, triad_gbs, reduce_gbs);
+}
+
+/////////////////////////////////////
+// main
+/////////////////////////////////////
+int main(int argc, char** argv) {
+    size_t n    = (argc > 1) ? (size_t) atol(argv[1]) : (size_t(1) << 26);
+    int repeats = (argc > 2) ? atoi(argv[2]) : 10;
+
+    printf("elements %lu, threads %d, repeats %d\n", (unsigned long) n, omp_get_max_threads(), repeats);
+    printf("%-12s %10s %12s %12s\n", "layout", "alloc_ms", "triad_GB/s", "reduce_GB/s");
+
+    bench_serial(n, repeats);
+    bench_first_touch(n, repeats);
+
+    return 0;
+}
@@ -73,7 +73,6 @@ void CreateRandomXYZData() {
     // init
     float low = 00.0f;
     float high = 100.0f;
-    float temp = 0.0f;
 
     // allocate
     if (xyz0) {
@@ -83,19 +82,8 @@ void CreateRandomXYZData() {
     xyz0 = (float*)malloc(N * sizeof(float));
     if (xyz0 == NULL) { exit(-1); }
 
-    // generate random float data
-    //srand(2010);
-    for (int i = 0; i < N - 2; i += 3) {
-        temp = sin(i * N / ((double)(N) + 1.0)) * (high - low) + low;
-        //temp = sin(rand()/((double)(RAND_MAX)+1.0))*(high-low)+low;
-        xyz0[i + 0] = temp;
-        temp = cos(i * N / ((double)(N) + 1.0)) * (high - low) + low;
-        //temp = cos(rand()/((double)(RAND_MAX)+1.0))*(high-low)+low;
-        xyz0[i + 1] = temp;
-        temp = tan(i / ((double)(N) + 1.0)) * (high - low) + low;
-//		temp = tan(rand()/((double)(RAND_MAX)+1.0))*(high-low)+low;
-        xyz0[i + 2] = temp;
-    }
+    // generate random float data (same data for any thread count)
+    generate_random_xyz_cpu(xyz0, N, low, high, 2010);
 }
 
 /////////////////////////////////////
@@ -21,6 +21,7 @@
 #include <thrust/host_vector.h>
 #include <thrust/transform_reduce.h>
 #include <thrust/extrema.h>
+#include <thrust/experimental/default_init_allocator.h>
 
 /////////////////////////////////////
 // configuration section
@@ -35,7 +36,7 @@
 //   h_ = host (cpu)
 //   h_ = host   (CPU)
 /////////////////////////////////////
-thrust::host_vector<float> h_cpu_xyz_ac; // cpu storage of xyz data
+thrust::host_vector<float, thrust::experimental::default_init_allocator<float> > h_cpu_xyz_ac; // cpu storage of xyz data
 thrust::host_vector<float> h_cpu_x;   // cpu storage of x data
 thrust::host_vector<float> h_cpu_y;   // cpu storage of y data
 thrust::host_vector<float> h_cpu_z;   // cpu storage of z data
@@ -259,11 +260,8 @@ void _init_xyz_cpu(int N) {
     int validBodies = N / 3;
 
     // x y z memory
-    h_cpu_x.resize(validBodies);
-    thrust::fill(h_cpu_x.begin(), h_cpu_x.end(), (float)0);
-    h_cpu_y.resize(validBodies);
-    thrust::fill(h_cpu_y.begin(), h_cpu_y.end(), (float)0);
-    h_cpu_z.resize(validBodies);
-    thrust::fill(h_cpu_z.begin(), h_cpu_z.end(), (float)0);
+    h_cpu_x.assign(validBodies, (float)0);
+    h_cpu_y.assign(validBodies, (float)0);
+    h_cpu_z.assign(validBodies, (float)0);
 }
 
@@ -13,6 +13,8 @@
 #include <thrust/host_vector.h>
 #include <thrust/transform_reduce.h>
 #include <thrust/extrema.h>
+#include <thrust/tuple.h>
+#include <thrust/iterator/zip_iterator.h>
 
 /////////////////////////////////////
 // data extraction kernel
@@ -35,77 +37,96 @@ void cpu_extract_xyz(float* h_xyz, const int validBodies, float* h_x, float* h_y
 }
 
 /////////////////////////////////////
-// core coviariance vector calculations (float)
+// moments of zipped (t1, t2) samples, accumulated in double so that the
+// single pass formulas below do not lose precision to cancellation
 /////////////////////////////////////
-struct cov_functor_f1 {
-    const float u1, u2;
+struct moment_x {
+    template <typename Tuple>
+    __host__ __device__
+    double operator()(const Tuple& t) const { return thrust::get<0>(t); }
+};
 
-    cov_functor_f1(float _u1, float _u2) : u1(_u1), u2(_u2) {}
+struct moment_y {
+    template <typename Tuple>
+    __host__ __device__
+    double operator()(const Tuple& t) const { return thrust::get<1>(t); }
+};
 
-    __host__ __host__
-    float operator()(const float& t1, const float& t2) const {
-        return (t1 - u1) * (t2 - u2);
-    }
+struct moment_xx {
+    template <typename Tuple>
+    __host__ __device__
+    double operator()(const Tuple& t) const { return (double)thrust::get<0>(t) * thrust::get<0>(t); }
 };
 
-struct cov_functor_f2 {
-    cov_functor_f2() {}
+struct moment_yy {
+    template <typename Tuple>
+    __host__ __device__
+    double operator()(const Tuple& t) const { return (double)thrust::get<1>(t) * thrust::get<1>(t); }
+};
 
-    __host__ __host__
-    float operator()(const float& t1, const float& t2) const {
-        return ((t1 - t2) * (t1 - t2));
+struct moment_xy {
+    template <typename Tuple>
+    __host__ __device__
+    double operator()(const Tuple& t) const { return (double)thrust::get<0>(t) * thrust::get<1>(t); }
+};
+
+struct moment_dd {
+    template <typename Tuple>
+    __host__ __device__
+    double operator()(const Tuple& t) const {
+        double d = (double)thrust::get<0>(t) - thrust::get<1>(t);
+        return d * d;
     }
 };
 
 /////////////////////////////////////
-// external compute autocorrelation between datasets at time1 and time2 (float)
+// compute autocorrelation between datasets at time1 and time2,
+// reading both datasets once
 /////////////////////////////////////
-float cpu_compute_autocorrelation(thrust::host_vector<float>& data_t1, thrust::host_vector<float>& data_t2, int N, int type) {
-    // temp
-    thrust::host_vector<float> data_r(N);
+template <typename T>
+float compute_autocorrelation(thrust::host_vector<T>& data_t1, thrust::host_vector<T>& data_t2, int N, int type) {
     float ac = 0.0f;
 
     switch (type) {
     case 1: {
         // http://en.wikipedia.org/wiki/Pearson_product-moment_correlation_coefficient
 
-        // find means
-        float u1 = thrust::reduce(data_t1.begin(), data_t1.end(), (float)0, thrust::plus<float>()) / N;
-        float u2 = thrust::reduce(data_t2.begin(), data_t2.end(), (float)0, thrust::plus<float>()) / N;
+        // sums, sums of squares and sum of products in one pass
+        typedef thrust::tuple<double, double, double, double, double> moments;
+        moments m = thrust::multi_transform_reduce(
+                        thrust::make_zip_iterator(thrust::make_tuple(data_t1.begin(), data_t2.begin())),
+                        thrust::make_zip_iterator(thrust::make_tuple(data_t1.begin() + N, data_t2.begin() + N)),
+                        thrust::make_tuple(moment_x(), moment_y(), moment_xx(), moment_yy(), moment_xy()),
+                        moments(0, 0, 0, 0, 0));
 
-        // r = (t1-u1)*(t2-u2)
-        thrust::transform(data_t1.begin(), data_t1.end(), data_t2.begin(), data_r.begin(), cov_functor_f1(u1, u2));
+        // means
+        double u1 = thrust::get<0>(m) / N;
+        double u2 = thrust::get<1>(m) / N;
 
-        // cov = sum(r_vector) / n
-        float cov = thrust::reduce(data_r.begin(), data_r.end(), (float)0, thrust::plus<float>()) / N;
+        // cov = E[t1*t2] - u1*u2
+        double cov = thrust::get<4>(m) / N - u1 * u2;
 
         // variances
-        thrust::transform(data_t1.begin(), data_t1.end(), data_t1.begin(), data_r.begin(), cov_functor_f1(u1, u1));
-        float var1 = thrust::reduce(data_r.begin(), data_r.end(), (float)0, thrust::plus<float>()) / N;
-        thrust::transform(data_t2.begin(), data_t2.end(), data_t2.begin(), data_r.begin(), cov_functor_f1(u2, u2));
-        float var2 = thrust::reduce(data_r.begin(), data_r.end(), (float)0, thrust::plus<float>()) / N;
-
-        // standard deviations
-        float std1 = sqrt(var1);
-        float std2 = sqrt(var2);
+        double var1 = thrust::get<2>(m) / N - u1 * u1;
+        double var2 = thrust::get<3>(m) / N - u2 * u2;
 
         // autocorrelation
-        ac = cov / (std1 * std2);
+        ac = (float)(cov / (sqrt(var1) * sqrt(var2)));
         break;
     }
     case 2: {
         // http://en.wikipedia.org/wiki/Durbin-Watson_statistic
 
-        // r = (t1-t2)^2
-        thrust::transform(data_t1.begin(), data_t1.end(), data_t2.begin(), data_r.begin(), cov_functor_f2());
-        float et2 = thrust::reduce(data_r.begin(), data_r.end(), (float)0, thrust::plus<float>()) ;
-
-        // r = t1^2
-        thrust::transform(data_t1.begin(), data_t1.end(), data_t1.begin(), data_r.begin(), cov_functor_f1(0, 0));
-        float et1 = thrust::reduce(data_r.begin(), data_r.end(), (float)0, thrust::plus<float>()) ;
+        // sum((t1-t2)^2) and sum(t1^2) in one pass
+        typedef thrust::tuple<double, double> moments;
+        moments m = thrust::multi_transform_reduce(
+                        thrust::make_zip_iterator(thrust::make_tuple(data_t1.begin(), data_t2.begin())),
+                        thrust::make_zip_iterator(thrust::make_tuple(data_t1.begin() + N, data_t2.begin() + N)),
+                        thrust::make_tuple(moment_dd(), moment_xx()),
+                        moments(0, 0));
 
         // autocorrelation
-        ac = 1 - et2 / et1;
+        ac = (float)(1 - thrust::get<0>(m) / thrust::get<1>(m));
         break;
     }
 
@@ -116,83 +137,15 @@ float cpu_compute_autocorrelation(thrust::host_vector<float>& data_t1, thrust::h
 }
 
 /////////////////////////////////////
-// core coviariance vector calculations (int)
+// external compute autocorrelation between datasets at time1 and time2 (float)
 /////////////////////////////////////
-struct cov_functor_i1 {
-    const float u1, u2;
-
-    cov_functor_i1(float _u1, float _u2) : u1(_u1), u2(_u2) {}
-
-    __host__ __host__
-    float operator()(const int& t1, const int& t2) const {
-        return (t1 - u1) * (t2 - u2);
-    }
-};
-
-struct cov_functor_i2 {
-    cov_functor_i2() {}
-
-    __host__ __host__
-    float operator()(const int& t1, const int& t2) const {
-        return ((t1 - t2) * (t1 - t2));
-    }
-};
+float cpu_compute_autocorrelation(thrust::host_vector<float>& data_t1, thrust::host_vector<float>& data_t2, int N, int type) {
+    return compute_autocorrelation(data_t1, data_t2, N, type);
+}
 
 /////////////////////////////////////
 // external compute autocorrelation between datasets at time1 and time2 (int)
 /////////////////////////////////////
 float cpu_compute_autocorrelation(thrust::host_vector<int>& data_t1, thrust::host_vector<int>& data_t2, int N, int type) {
-    // temp
-    thrust::host_vector<float> data_r(N);
-    float ac = 0.0f;
-
-    switch (type) {
-    case 1: {
-        // http://en.wikipedia.org/wiki/Pearson_product-moment_correlation_coefficient
-
-        // find means
-        float u1 = thrust::reduce(data_t1.begin(), data_t1.end(), (int)0, thrust::plus<int>()) / N;
-        float u2 = thrust::reduce(data_t2.begin(), data_t2.end(), (int)0, thrust::plus<int>()) / N;
-
-        // r = (t1-u1)*(t2-u2)
-        thrust::transform(data_t1.begin(), data_t1.end(), data_t2.begin(), data_r.begin(), cov_functor_i1(u1, u2));
-
-        // cov = sum(r_vector) / n
-        float cov = thrust::reduce(data_r.begin(), data_r.end(), (float)0, thrust::plus<float>()) / N;
-
-        // variances
-        thrust::transform(data_t1.begin(), data_t1.end(), data_t1.begin(), data_r.begin(), cov_functor_f1(u1, u1));
-        float var1 = thrust::reduce(data_r.begin(), data_r.end(), (float)0, thrust::plus<float>()) / N;
-        thrust::transform(data_t2.begin(), data_t2.end(), data_t2.begin(), data_r.begin(), cov_functor_f1(u2, u2));
-        float var2 = thrust::reduce(data_r.begin(), data_r.end(), (float)0, thrust::plus<float>()) / N;
-
-        // standard deviations
-        float std1 = sqrt(var1);
-        float std2 = sqrt(var2);
-
-        // autocorrelation
-        ac = cov / (std1 * std2);
-        break;
-    }
-    case 2: {
-        // http://en.wikipedia.org/wiki/Durbin-Watson_statistic
-
-        // r = (t1-t2)^2
-        thrust::transform(data_t1.begin(), data_t1.end(), data_t2.begin(), data_r.begin(), cov_functor_i2());
-        float et2 = thrust::reduce(data_r.begin(), data_r.end(), (float)0, thrust::plus<float>()) ;
-
-        // r = t1^2
-        thrust::transform(data_t1.begin(), data_t1.end(), data_t1.begin(), data_r.begin(), cov_functor_f1(0, 0));
-        float et1 = thrust::reduce(data_r.begin(), data_r.end(), (float)0, thrust::plus<float>()) ;
-
-        // autocorrelation
-        ac = 1 - et2 / et1;
-        break;
-    }
-
-    } // end case
-
-    // out
-    return ac;
+    return compute_autocorrelation(data_t1, data_t2, N, type);
 }
-
@@ -179,16 +179,15 @@ void _init_cpu(int N, int nbins) {
     // miscellaneous initialization
     int nbListSize = NLISTHEIGHT * (N / 3);
 
-    // bonds memory
-    h_cpu_nbonds.resize(N + 3);
+    // bonds memory (filled right away, so skip the value-init pass)
+    h_cpu_nbonds.uninitialized_resize(N + 3);
     thrust::fill(h_cpu_nbonds.begin(), h_cpu_nbonds.end(), (float)0);
 
     // bins memory
-    h_cpu_bins.resize(nbins);
-    thrust::fill(h_cpu_bins.begin(), h_cpu_bins.end(), (int)0);
+    h_cpu_bins.assign(nbins, (int)0);
 
     // neighbors memory
-    h_cpu_nlist.resize(nbListSize);
+    h_cpu_nlist.uninitialized_resize(nbListSize);
     thrust::fill(h_cpu_nlist.begin(), h_cpu_nlist.end(), (int)EMPTY);
 }
 
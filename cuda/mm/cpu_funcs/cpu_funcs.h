@@ -18,6 +18,7 @@ extern "C"
     int compute_bonds_cpu(float* h_xyz, int N, float rmin, float rmax, float maxrad, int nbins, int** nblist_out, int** bins_out);
     int compute_xyz_autocorrelation_cpu(float* h_xyz, int N, float& oacx, float& oacy, float& oacz, int type);
     int compute_int_autocorrelation_cpu(int* h_i, int N, float& oaci, int type);
+    int generate_random_xyz_cpu(float* h_xyz, int N, float low, float high, unsigned int seed);
 }
 #endif
 
@@ -0,0 +1,47 @@
+/*
+ * cpu_random.cu
+ *
+ *  Counter-based random test data
+ */
+
+/////////////////////////////////////
+// standard imports
+/////////////////////////////////////
+#include <stdio.h>
+
+/////////////////////////////////////
+// Thrust imports
+/////////////////////////////////////
+#include <thrust/device_vector.h>
+#include <thrust/copy.h>
+#include <thrust/random.h>
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// callable external function
+//
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+extern "C"
+{
+    /////////////////////////////////////
+    // ENTRY POINT:
+    //  h_xyz 	= outgoing point float array
+    //  N 		= size of float array (na3)
+    //  low 	= smallest coordinate value
+    //  high 	= coordinate values are below this
+    //  seed 	= same seed gives same data, on any number of threads
+    /////////////////////////////////////
+    int generate_random_xyz_cpu(float* h_xyz, int N, float low, float high, unsigned int seed) {
+        if (h_xyz == NULL || N <= 0) { return -1; }
+
+        // each coordinate is a function of (seed, index) only, so filling
+        // in parallel on the device backend reproduces the serial result
+        thrust::device_vector<float> d_xyz(N);
+        thrust::random::experimental::generate_uniform(d_xyz.begin(), d_xyz.end(), thrust::philox4x32(seed), low, high);
+        thrust::copy(d_xyz.begin(), d_xyz.end(), h_xyz);
+
+        return 0;
+    }
+}
@@ -1,7 +1,7 @@
 #!/bin/sh
 
 NAME="libcudafuncscpu"
-SOURCES="cpu_bonds.cu cpu_autocorrelation.cu cpu_autocorrelation_kernel.cu"
+SOURCES="cpu_bonds.cu cpu_autocorrelation.cu cpu_autocorrelation_kernel.cu cpu_random.cu"
 INCLUDES="-I/usr/local/cuda/include -I../thrust/"
 LIBS="-L/usr/local/cuda/lib64 -lcudart"
 OPTS="-Xcompiler -fPIC -arch sm_12"
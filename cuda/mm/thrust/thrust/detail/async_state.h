@@ -0,0 +1,193 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file async_state.h
+ *  \brief Reference-counted completion state shared between an
+ *         asynchronous operation and its futures.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/mutex.h>
+#include <thrust/detail/thread_pool.h>
+#include <exception>
+#include <string>
+
+namespace thrust {
+namespace detail {
+
+// grants the async_ functions access to the state behind a future
+struct async_access;
+
+class async_state {
+public:
+    async_state() : m_refs(1), m_ready(false), m_failed(false), m_continuations(0) {}
+
+    virtual ~async_state() {}
+
+    void retain() {
+        scoped_lock guard(m_lock);
+        ++m_refs;
+    }
+
+    void release() {
+        bool last = false;
+        {
+            scoped_lock guard(m_lock);
+            last = (--m_refs == 0);
+        }
+        if (last) delete this;
+    }
+
+    bool ready() {
+        scoped_lock guard(m_lock);
+        return m_ready;
+    }
+
+    // blocks until the operation has completed or failed
+    void wait() {
+        scoped_lock guard(m_lock);
+        while (!m_ready)
+            m_done.wait(m_lock);
+    }
+
+    // failed() and what() are only meaningful once ready
+    bool failed() const {
+        return m_failed;
+    }
+
+    const std::string& what() const {
+        return m_what;
+    }
+
+    void set_ready() {
+        complete();
+    }
+
+    void set_failed(const std::string& what) {
+        m_failed = true;
+        m_what   = what;
+        complete();
+    }
+
+    // submits t to the pool once this state is ready
+    void then(thread_pool::task* t) {
+        {
+            scoped_lock guard(m_lock);
+            if (!m_ready) {
+                t->next = m_continuations;
+                m_continuations = t;
+                return;
+            }
+        }
+        thread_pool::instance().submit(t);
+    }
+
+private:
+    void complete() {
+        thread_pool::task* continuations = 0;
+        {
+            scoped_lock guard(m_lock);
+            m_ready = true;
+            continuations = m_continuations;
+            m_continuations = 0;
+            m_done.notify_all();
+        }
+
+        while (continuations != 0) {
+            thread_pool::task* t = continuations;
+            continuations = t->next;
+            thread_pool::instance().submit(t);
+        }
+    }
+
+    mutex m_lock;
+    condition_variable m_done;
+    unsigned int m_refs;
+    bool m_ready;
+    bool m_failed;
+    std::string m_what;
+    thread_pool::task* m_continuations;
+
+    // disallow copy and assignment
+    async_state(const async_state&);
+    async_state& operator=(const async_state&);
+}; // end async_state
+
+
+template<typename T>
+class async_value_state : public async_state {
+public:
+    T value;
+}; // end async_value_state
+
+
+// a pool task producing the result of an asynchronous operation; when
+// launched after another operation, a failure there is propagated
+// without running execute()
+class async_task : public thread_pool::task {
+public:
+    async_task(async_state* state, async_state* after)
+        : m_state(state), m_after(after) {
+        m_state->retain();
+        if (m_after != 0) m_after->retain();
+    }
+
+    virtual ~async_task() {
+        if (m_after != 0) m_after->release();
+        m_state->release();
+    }
+
+    void run() {
+        if (m_after != 0 && m_after->failed()) {
+            m_state->set_failed(m_after->what());
+            return;
+        }
+
+        try {
+            execute();
+        } catch (std::exception& e) {
+            m_state->set_failed(e.what());
+            return;
+        } catch (...) {
+            m_state->set_failed("unknown exception");
+            return;
+        }
+
+        m_state->set_ready();
+    }
+
+    // queues this task, behind after if it is non-null
+    void launch() {
+        if (m_after != 0)
+            m_after->then(this);
+        else
+            thread_pool::instance().submit(this);
+    }
+
+protected:
+    virtual void execute() = 0;
+
+    async_state* m_state;
+    async_state* m_after;
+}; // end async_task
+
+} // end namespace detail
+} // end namespace thrust
+
@@ -0,0 +1,66 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file atomic.h
+ *  \brief A sequentially consistent integer counter over the
+ *         compiler's atomic intrinsics.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <windows.h>
+#endif // THRUST_HOST_COMPILER
+
+namespace thrust {
+namespace detail {
+
+class atomic_int {
+public:
+    explicit atomic_int(long value = 0) : m_value(value) {}
+
+#if THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC
+    long load() const               { return InterlockedCompareExchange(&m_value, 0, 0); }
+    void store(long value)          { InterlockedExchange(&m_value, value); }
+    long fetch_add(long value)      { return InterlockedExchangeAdd(&m_value, value); }
+#elif defined(__ATOMIC_SEQ_CST)
+    long load() const               { return __atomic_load_n(&m_value, __ATOMIC_SEQ_CST); }
+    void store(long value)          { __atomic_store_n(&m_value, value, __ATOMIC_SEQ_CST); }
+    long fetch_add(long value)      { return __atomic_fetch_add(&m_value, value, __ATOMIC_SEQ_CST); }
+#else
+    long load() const               { return __sync_fetch_and_add(&m_value, 0); }
+    void store(long value)          { __sync_synchronize(); m_value = value; __sync_synchronize(); }
+    long fetch_add(long value)      { return __sync_fetch_and_add(&m_value, value); }
+#endif // THRUST_HOST_COMPILER
+
+private:
+    mutable volatile long m_value;
+
+    // disallow copy and assignment
+    atomic_int(const atomic_int&);
+    atomic_int& operator=(const atomic_int&);
+}; // end atomic_int
+
+} // end namespace detail
+} // end namespace thrust
+
@@ -44,6 +44,7 @@
 // XXX reserve 0 for undefined
 #define THRUST_DEVICE_BACKEND_CUDA    1
 #define THRUST_DEVICE_BACKEND_OMP     2
+#define THRUST_DEVICE_BACKEND_THREADS 3
 
 #ifndef THRUST_DEVICE_BACKEND
 #define THRUST_DEVICE_BACKEND THRUST_DEVICE_BACKEND_CUDA
@@ -22,6 +22,9 @@
 #pragma once
 
 #include <thrust/detail/device/generic/binary_search.h>
+#include <thrust/detail/device/dispatch/binary_search.h>
+
+#include <thrust/iterator/iterator_traits.h>
 
 namespace thrust {
 namespace detail {
@@ -60,7 +63,9 @@ OutputIterator lower_bound(ForwardIterator begin,
                            InputIterator values_end,
                            OutputIterator output,
                            StrictWeakOrdering comp) {
-    return thrust::detail::device::generic::lower_bound(begin, end, values_begin, values_end, output, comp);
+    // dispatch on space
+    return thrust::detail::device::dispatch::lower_bound(begin, end, values_begin, values_end, output, comp,
+            typename thrust::iterator_space<ForwardIterator>::type());
 }
 
 template <class ForwardIterator, class InputIterator, class OutputIterator, class StrictWeakOrdering>
@@ -70,7 +75,9 @@ OutputIterator upper_bound(ForwardIterator begin,
                            InputIterator values_end,
                            OutputIterator output,
                            StrictWeakOrdering comp) {
-    return thrust::detail::device::generic::upper_bound(begin, end, values_begin, values_end, output, comp);
+    // dispatch on space
+    return thrust::detail::device::dispatch::upper_bound(begin, end, values_begin, values_end, output, comp,
+            typename thrust::iterator_space<ForwardIterator>::type());
 }
 
 template <class ForwardIterator, class InputIterator, class OutputIterator, class StrictWeakOrdering>
@@ -80,7 +87,9 @@ OutputIterator binary_search(ForwardIterator begin,
                              InputIterator values_end,
                              OutputIterator output,
                              StrictWeakOrdering comp) {
-    return thrust::detail::device::generic::binary_search(begin, end, values_begin, values_end, output, comp);
+    // dispatch on space
+    return thrust::detail::device::dispatch::binary_search(begin, end, values_begin, values_end, output, comp,
+            typename thrust::iterator_space<ForwardIterator>::type());
 }
 
 } // end namespace device
@@ -0,0 +1,109 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file binary_search.h
+ *  \brief Dispatch layer for the device vectorized binary search functions.
+ */
+
+#pragma once
+
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/device/generic/binary_search.h>
+#include <thrust/detail/device/omp/binary_search.h>
+
+namespace thrust {
+namespace detail {
+namespace device {
+namespace dispatch {
+
+template <class ForwardIterator, class InputIterator, class OutputIterator, class StrictWeakOrdering, class Space>
+OutputIterator lower_bound(ForwardIterator begin,
+                           ForwardIterator end,
+                           InputIterator values_begin,
+                           InputIterator values_end,
+                           OutputIterator output,
+                           StrictWeakOrdering comp,
+                           Space) {
+    // generic backend
+    return thrust::detail::device::generic::lower_bound(begin, end, values_begin, values_end, output, comp);
+}
+
+template <class ForwardIterator, class InputIterator, class OutputIterator, class StrictWeakOrdering>
+OutputIterator lower_bound(ForwardIterator begin,
+                           ForwardIterator end,
+                           InputIterator values_begin,
+                           InputIterator values_end,
+                           OutputIterator output,
+                           StrictWeakOrdering comp,
+                           thrust::detail::omp_device_space_tag) {
+    // OpenMP implementation
+    return thrust::detail::device::omp::lower_bound(begin, end, values_begin, values_end, output, comp);
+}
+
+template <class ForwardIterator, class InputIterator, class OutputIterator, class StrictWeakOrdering, class Space>
+OutputIterator upper_bound(ForwardIterator begin,
+                           ForwardIterator end,
+                           InputIterator values_begin,
+                           InputIterator values_end,
+                           OutputIterator output,
+                           StrictWeakOrdering comp,
+                           Space) {
+    // generic backend
+    return thrust::detail::device::generic::upper_bound(begin, end, values_begin, values_end, output, comp);
+}
+
+template <class ForwardIterator, class InputIterator, class OutputIterator, class StrictWeakOrdering>
+OutputIterator upper_bound(ForwardIterator begin,
+                           ForwardIterator end,
+                           InputIterator values_begin,
+                           InputIterator values_end,
+                           OutputIterator output,
+                           StrictWeakOrdering comp,
+                           thrust::detail::omp_device_space_tag) {
+    // OpenMP implementation
+    return thrust::detail::device::omp::upper_bound(begin, end, values_begin, values_end, output, comp);
+}
+
+template <class ForwardIterator, class InputIterator, class OutputIterator, class StrictWeakOrdering, class Space>
+OutputIterator binary_search(ForwardIterator begin,
+                             ForwardIterator end,
+                             InputIterator values_begin,
+                             InputIterator values_end,
+                             OutputIterator output,
+                             StrictWeakOrdering comp,
+                             Space) {
+    // generic backend
+    return thrust::detail::device::generic::binary_search(begin, end, values_begin, values_end, output, comp);
+}
+
+template <class ForwardIterator, class InputIterator, class OutputIterator, class StrictWeakOrdering>
+OutputIterator binary_search(ForwardIterator begin,
+                             ForwardIterator end,
+                             InputIterator values_begin,
+                             InputIterator values_end,
+                             OutputIterator output,
+                             StrictWeakOrdering comp,
+                             thrust::detail::omp_device_space_tag) {
+    // OpenMP implementation
+    return thrust::detail::device::omp::binary_search(begin, end, values_begin, values_end, output, comp);
+}
+
+} // end namespace dispatch
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
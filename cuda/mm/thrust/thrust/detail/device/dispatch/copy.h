@@ -19,6 +19,7 @@
 #include <thrust/detail/type_traits.h>
 #include <thrust/detail/device/omp/copy.h>
 #include <thrust/detail/device/cuda/copy.h>
+#include <thrust/detail/device/threads/copy.h>
 
 namespace thrust {
 namespace detail {
@@ -35,18 +36,32 @@ template < typename InputIterator,
 OutputIterator copy(InputIterator first,
                     InputIterator last,
                     OutputIterator result,
-                    thrust::detail::false_type) { // neither space is CUDA
+                    thrust::detail::false_type,   // neither space is CUDA
+                    thrust::detail::false_type) { // neither space is threads
     return thrust::detail::device::omp::copy(first, last, result);
 } // end copy()
 
 
+// threads path
+template < typename InputIterator,
+         typename OutputIterator >
+OutputIterator copy(InputIterator first,
+                    InputIterator last,
+                    OutputIterator result,
+                    thrust::detail::false_type,  // neither space is CUDA
+                    thrust::detail::true_type) { // one of the spaces is threads
+    return thrust::detail::device::threads::copy(first, last, result);
+} // end copy()
+
+
 // at least one space is CUDA
 template < typename InputIterator,
          typename OutputIterator >
 OutputIterator copy(InputIterator first,
                     InputIterator last,
                     OutputIterator result,
-                    thrust::detail::true_type) { // one of the spaces is CUDA
+                    thrust::detail::true_type,   // one of the spaces is CUDA
+                    thrust::detail::false_type) {
     return thrust::detail::device::cuda::copy(first, last, result);
 } // end copy()
 
@@ -67,8 +82,14 @@ OutputIterator copy(InputIterator first,
             thrust::detail::is_convertible<Space2, thrust::detail::cuda_device_space_tag>::value
             > is_one_of_the_spaces_cuda;
 
+    typedef typename thrust::detail::integral_constant < bool,
+            thrust::detail::is_convertible<Space1, thrust::detail::threads_device_space_tag>::value ||
+            thrust::detail::is_convertible<Space2, thrust::detail::threads_device_space_tag>::value
+            > is_one_of_the_spaces_threads;
+
     return copy(first, last, result,
-                is_one_of_the_spaces_cuda());
+                is_one_of_the_spaces_cuda(),
+                is_one_of_the_spaces_threads());
 } // end copy()
 
 } // end namespace dispatch
@@ -19,6 +19,7 @@
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/device/cuda/for_each.h>
 #include <thrust/detail/device/omp/for_each.h>
+#include <thrust/detail/device/threads/for_each.h>
 
 namespace thrust {
 
@@ -46,6 +47,15 @@ void for_each(InputIterator first,
     thrust::detail::device::cuda::for_each(first, last, f);
 }
 
+template < typename InputIterator,
+         typename UnaryFunction >
+void for_each(InputIterator first,
+              InputIterator last,
+              UnaryFunction f,
+              thrust::detail::threads_device_space_tag) {
+    thrust::detail::device::threads::for_each(first, last, f);
+}
+
 } // end dispatch
 
 } // end device
@@ -20,6 +20,7 @@
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/device/generic/free.h>
 #include <thrust/detail/device/cuda/free.h>
+#include <thrust/detail/device/omp/free.h>
 
 namespace thrust {
 namespace detail {
@@ -39,6 +40,20 @@ void free(thrust::device_ptr<void> ptr,
     thrust::detail::device::cuda::free<0>(ptr);
 } // end free()
 
+
+template<unsigned int DummyParameterToAvoidInstantiation>
+void free(thrust::device_ptr<void> ptr,
+          thrust::detail::omp_device_space_tag) {
+    thrust::detail::device::omp::free<0>(ptr);
+} // end free()
+
+
+template<unsigned int DummyParameterToAvoidInstantiation>
+void free(thrust::device_ptr<void> ptr,
+          thrust::detail::threads_device_space_tag) {
+    thrust::detail::device::omp::free<0>(ptr);
+} // end free()
+
 } // end namespace dispatch
 } // end namespace device
 } // end namespace detail
@@ -0,0 +1,64 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file gather.h
+ *  \brief Dispatch layer for the device gather function.
+ */
+
+#pragma once
+
+#include <thrust/iterator/permutation_iterator.h>
+#include <thrust/detail/device/copy.h>
+#include <thrust/detail/device/omp/gather.h>
+
+namespace thrust {
+namespace detail {
+namespace device {
+namespace dispatch {
+
+template < typename InputIterator,
+         typename RandomAccessIterator,
+         typename OutputIterator,
+         typename Space >
+OutputIterator gather(InputIterator        map_first,
+                      InputIterator        map_last,
+                      RandomAccessIterator input_first,
+                      OutputIterator       result,
+                      Space) {
+    // generic backend
+    return thrust::detail::device::copy(thrust::make_permutation_iterator(input_first, map_first),
+                                        thrust::make_permutation_iterator(input_first, map_last),
+                                        result);
+} // end gather()
+
+template < typename InputIterator,
+         typename RandomAccessIterator,
+         typename OutputIterator >
+OutputIterator gather(InputIterator        map_first,
+                      InputIterator        map_last,
+                      RandomAccessIterator input_first,
+                      OutputIterator       result,
+                      thrust::detail::omp_device_space_tag) {
+    // OpenMP implementation
+    return thrust::detail::device::omp::gather(map_first, map_last, input_first, result);
+} // end gather()
+
+} // end dispatch
+} // end device
+} // end detail
+} // end thrust
+
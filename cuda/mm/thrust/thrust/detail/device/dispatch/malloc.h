@@ -20,6 +20,7 @@
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/device/generic/malloc.h>
 #include <thrust/detail/device/cuda/malloc.h>
+#include <thrust/detail/device/omp/malloc.h>
 
 namespace thrust {
 
@@ -49,6 +50,19 @@ thrust::device_ptr<void> malloc(const std::size_t n,
     return thrust::detail::device::cuda::malloc<0>(n);
 } // end malloc()
 
+template<unsigned int DummyParameterToAvoidInstantiation>
+thrust::device_ptr<void> malloc(const std::size_t n,
+                                thrust::detail::omp_device_space_tag) {
+    return thrust::detail::device::omp::malloc<0>(n);
+} // end malloc()
+
+// the threads backend also lives in host memory; share the OpenMP pool
+template<unsigned int DummyParameterToAvoidInstantiation>
+thrust::device_ptr<void> malloc(const std::size_t n,
+                                thrust::detail::threads_device_space_tag) {
+    return thrust::detail::device::omp::malloc<0>(n);
+} // end malloc()
+
 } // end dispatch
 
 } // end device
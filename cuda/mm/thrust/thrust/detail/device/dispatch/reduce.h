@@ -22,6 +22,7 @@
 
 #include <thrust/detail/device/cuda/reduce.h>
 #include <thrust/detail/device/omp/reduce.h>
+#include <thrust/detail/device/threads/reduce.h>
 
 namespace thrust {
 namespace detail {
@@ -52,6 +53,18 @@ OutputType reduce(InputIterator first,
     return thrust::detail::device::cuda::reduce(first, last, init, binary_op);
 }
 
+template < typename InputIterator,
+         typename OutputType,
+         typename BinaryFunction >
+OutputType reduce(InputIterator first,
+                  InputIterator last,
+                  OutputType init,
+                  BinaryFunction binary_op,
+                  thrust::detail::threads_device_space_tag) {
+    // work-stealing implementation
+    return thrust::detail::device::threads::reduce(first, last, init, binary_op);
+}
+
 template < typename InputIterator,
          typename OutputType,
          typename BinaryFunction >
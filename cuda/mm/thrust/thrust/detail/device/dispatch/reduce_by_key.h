@@ -0,0 +1,77 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file reduce_by_key.h
+ *  \brief Dispatch layer for the device reduce_by_key.
+ */
+
+#pragma once
+
+#include <thrust/pair.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/device/generic/reduce_by_key.h>
+#include <thrust/detail/device/omp/reduce_by_key.h>
+
+namespace thrust {
+namespace detail {
+namespace device {
+namespace dispatch {
+
+template < typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename BinaryPredicate,
+         typename BinaryFunction,
+         typename Space >
+thrust::pair<OutputIterator1, OutputIterator2>
+reduce_by_key(InputIterator1 keys_first,
+              InputIterator1 keys_last,
+              InputIterator2 values_first,
+              OutputIterator1 keys_output,
+              OutputIterator2 values_output,
+              BinaryPredicate binary_pred,
+              BinaryFunction binary_op,
+              Space) {
+    // generic backend
+    return thrust::detail::device::generic::reduce_by_key(keys_first, keys_last, values_first, keys_output, values_output, binary_pred, binary_op);
+}
+
+template < typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename BinaryPredicate,
+         typename BinaryFunction >
+thrust::pair<OutputIterator1, OutputIterator2>
+reduce_by_key(InputIterator1 keys_first,
+              InputIterator1 keys_last,
+              InputIterator2 values_first,
+              OutputIterator1 keys_output,
+              OutputIterator2 values_output,
+              BinaryPredicate binary_pred,
+              BinaryFunction binary_op,
+              thrust::detail::omp_device_space_tag) {
+    // OpenMP implementation
+    return thrust::detail::device::omp::reduce_by_key(keys_first, keys_last, values_first, keys_output, values_output, binary_pred, binary_op);
+}
+
+} // end namespace dispatch
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -20,6 +20,7 @@
 
 #include <thrust/detail/device/cuda/scan.h>
 #include <thrust/detail/device/omp/scan.h>
+#include <thrust/detail/device/threads/scan.h>
 
 namespace thrust {
 namespace detail {
@@ -87,6 +88,36 @@ OutputIterator exclusive_scan(InputIterator first,
     return thrust::detail::device::cuda::exclusive_scan(first, last, result, init, binary_op);
 }
 
+//////////////////////////////////
+// Work-stealing implementations //
+//////////////////////////////////
+
+template < typename InputIterator,
+         typename OutputIterator,
+         typename AssociativeOperator >
+OutputIterator inclusive_scan(InputIterator first,
+                              InputIterator last,
+                              OutputIterator result,
+                              AssociativeOperator binary_op,
+                              thrust::detail::threads_device_space_tag,
+                              thrust::detail::threads_device_space_tag) {
+    return thrust::detail::device::threads::inclusive_scan(first, last, result, binary_op);
+}
+
+template < typename InputIterator,
+         typename OutputIterator,
+         typename T,
+         typename AssociativeOperator >
+OutputIterator exclusive_scan(InputIterator first,
+                              InputIterator last,
+                              OutputIterator result,
+                              T init,
+                              AssociativeOperator binary_op,
+                              thrust::detail::threads_device_space_tag,
+                              thrust::detail::threads_device_space_tag) {
+    return thrust::detail::device::threads::exclusive_scan(first, last, result, init, binary_op);
+}
+
 } // end namespace dispatch
 } // end namespace device
 } // end namespace detail
@@ -0,0 +1,61 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file scatter.h
+ *  \brief Dispatch layer for the device scatter function.
+ */
+
+#pragma once
+
+#include <thrust/detail/device/generic/scatter.h>
+#include <thrust/detail/device/omp/scatter.h>
+
+namespace thrust {
+namespace detail {
+namespace device {
+namespace dispatch {
+
+template < typename InputIterator1,
+         typename InputIterator2,
+         typename RandomAccessIterator,
+         typename Space >
+void scatter(InputIterator1 first,
+             InputIterator1 last,
+             InputIterator2 map,
+             RandomAccessIterator output,
+             Space) {
+    // generic backend
+    thrust::detail::device::generic::scatter(first, last, map, output);
+} // end scatter()
+
+template < typename InputIterator1,
+         typename InputIterator2,
+         typename RandomAccessIterator >
+void scatter(InputIterator1 first,
+             InputIterator1 last,
+             InputIterator2 map,
+             RandomAccessIterator output,
+             thrust::detail::omp_device_space_tag) {
+    // OpenMP implementation
+    thrust::detail::device::omp::scatter(first, last, map, output);
+} // end scatter()
+
+} // end dispatch
+} // end device
+} // end detail
+} // end thrust
+
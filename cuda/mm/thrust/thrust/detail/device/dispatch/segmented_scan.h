@@ -0,0 +1,110 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file segmented_scan.h
+ *  \brief Dispatch layer for the device segmented scan functions.
+ */
+
+#pragma once
+
+#include <thrust/detail/device/generic/segmented_scan.h>
+#include <thrust/detail/device/omp/segmented_scan.h>
+
+namespace thrust {
+namespace detail {
+namespace device {
+namespace dispatch {
+
+template < typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename AssociativeOperator,
+         typename BinaryPredicate,
+         typename Space >
+OutputIterator inclusive_segmented_scan(InputIterator1 first1,
+                                        InputIterator1 last1,
+                                        InputIterator2 first2,
+                                        OutputIterator result,
+                                        AssociativeOperator binary_op,
+                                        BinaryPredicate pred,
+                                        Space) {
+    // generic backend
+    return thrust::detail::device::generic::inclusive_segmented_scan
+           (first1, last1, first2, result, binary_op, pred);
+}
+
+template < typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename AssociativeOperator,
+         typename BinaryPredicate >
+OutputIterator inclusive_segmented_scan(InputIterator1 first1,
+                                        InputIterator1 last1,
+                                        InputIterator2 first2,
+                                        OutputIterator result,
+                                        AssociativeOperator binary_op,
+                                        BinaryPredicate pred,
+                                        thrust::detail::omp_device_space_tag) {
+    // OpenMP implementation
+    return thrust::detail::device::omp::inclusive_segmented_scan
+           (first1, last1, first2, result, binary_op, pred);
+}
+
+template < typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename T,
+         typename AssociativeOperator,
+         typename BinaryPredicate,
+         typename Space >
+OutputIterator exclusive_segmented_scan(InputIterator1 first1,
+                                        InputIterator1 last1,
+                                        InputIterator2 first2,
+                                        OutputIterator result,
+                                        const T init,
+                                        AssociativeOperator binary_op,
+                                        BinaryPredicate pred,
+                                        Space) {
+    // generic backend
+    return thrust::detail::device::generic::exclusive_segmented_scan
+           (first1, last1, first2, result, init, binary_op, pred);
+}
+
+template < typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename T,
+         typename AssociativeOperator,
+         typename BinaryPredicate >
+OutputIterator exclusive_segmented_scan(InputIterator1 first1,
+                                        InputIterator1 last1,
+                                        InputIterator2 first2,
+                                        OutputIterator result,
+                                        const T init,
+                                        AssociativeOperator binary_op,
+                                        BinaryPredicate pred,
+                                        thrust::detail::omp_device_space_tag) {
+    // OpenMP implementation
+    return thrust::detail::device::omp::exclusive_segmented_scan
+           (first1, last1, first2, result, init, binary_op, pred);
+}
+
+} // end namespace dispatch
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
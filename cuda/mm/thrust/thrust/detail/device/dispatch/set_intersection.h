@@ -19,6 +19,7 @@
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/device/cuda/set_intersection.h>
 #include <thrust/detail/device/generic/set_intersection.h>
+#include <thrust/detail/device/omp/set_operations.h>
 
 namespace thrust {
 
@@ -67,6 +68,24 @@ OutputIterator set_intersection(InputIterator1 first1,
 } // end set_intersection()
 
 
+template < typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering >
+OutputIterator set_intersection(InputIterator1 first1,
+                                InputIterator1 last1,
+                                InputIterator2 first2,
+                                InputIterator2 last2,
+                                OutputIterator result,
+                                StrictWeakOrdering comp,
+                                thrust::detail::omp_device_space_tag,
+                                thrust::detail::omp_device_space_tag,
+                                thrust::detail::omp_device_space_tag) {
+    // refinement for the OpenMP backend
+    return thrust::detail::device::omp::set_intersection(first1, last1, first2, last2, result, comp);
+} // end set_intersection()
+
+
 } // end dispatch
 
 } // end device
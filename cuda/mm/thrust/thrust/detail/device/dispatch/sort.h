@@ -22,6 +22,7 @@
 
 #include <thrust/detail/device/cuda/sort.h>
 #include <thrust/detail/device/omp/sort.h>
+#include <thrust/detail/device/threads/sort.h>
 
 namespace thrust {
 namespace detail {
@@ -74,6 +75,29 @@ void stable_sort_by_key(RandomAccessKeyIterator keys_first,
     thrust::detail::device::cuda::stable_sort_by_key(keys_first, keys_last, values_first, comp);
 }
 
+template < typename RandomAccessIterator,
+         typename StrictWeakOrdering >
+void stable_sort(RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::threads_device_space_tag) {
+    // work-stealing implementation
+    thrust::detail::device::threads::stable_sort(first, last, comp);
+}
+
+template < typename RandomAccessKeyIterator,
+         typename RandomAccessValueIterator,
+         typename StrictWeakOrdering >
+void stable_sort_by_key(RandomAccessKeyIterator keys_first,
+                        RandomAccessKeyIterator keys_last,
+                        RandomAccessValueIterator values_first,
+                        StrictWeakOrdering comp,
+                        thrust::detail::threads_device_space_tag,
+                        thrust::detail::threads_device_space_tag) {
+    // work-stealing implementation
+    thrust::detail::device::threads::stable_sort_by_key(keys_first, keys_last, values_first, comp);
+}
+
 } // end namespace dispatch
 } // end namespace device
 } // end namespace detail
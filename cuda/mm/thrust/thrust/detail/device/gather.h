@@ -0,0 +1,50 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file gather.h
+ *  \brief Device interface to gather.
+ */
+
+#pragma once
+
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/detail/minimum_space.h>
+#include <thrust/detail/device/dispatch/gather.h>
+
+namespace thrust {
+namespace detail {
+namespace device {
+
+template < typename InputIterator,
+         typename RandomAccessIterator,
+         typename OutputIterator >
+OutputIterator gather(InputIterator        map_first,
+                      InputIterator        map_last,
+                      RandomAccessIterator input_first,
+                      OutputIterator       result) {
+    typedef typename thrust::iterator_space<InputIterator>::type        Space1;
+    typedef typename thrust::iterator_space<RandomAccessIterator>::type Space2;
+
+    // dispatch on space
+    return thrust::detail::device::dispatch::gather(map_first, map_last, input_first, result,
+            typename thrust::detail::minimum_space<Space1, Space2>::type());
+} // end gather()
+
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
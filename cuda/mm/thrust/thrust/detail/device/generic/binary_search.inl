@@ -143,7 +143,7 @@ struct lbf
         __host__ __device__
         typename thrust::iterator_traits<RandomAccessIterator>::difference_type
      operator()(RandomAccessIterator begin, RandomAccessIterator end, const T& value, StrictWeakOrdering comp){
-         return __lower_bound(begin, end, value, comp) - begin;
+         return detail::__lower_bound(begin, end, value, comp) - begin;
      }
 };
 
@@ -153,7 +153,7 @@ struct ubf
         __host__ __device__
         typename thrust::iterator_traits<RandomAccessIterator>::difference_type
      operator()(RandomAccessIterator begin, RandomAccessIterator end, const T& value, StrictWeakOrdering comp){
-         return __upper_bound(begin, end, value, comp) - begin;
+         return detail::__upper_bound(begin, end, value, comp) - begin;
      }
 };
 
@@ -162,7 +162,7 @@ struct bsf
     template <class RandomAccessIterator, class T, class StrictWeakOrdering>
         __host__ __device__
      bool operator()(RandomAccessIterator begin, RandomAccessIterator end, const T& value, StrictWeakOrdering comp){
-         RandomAccessIterator iter = __lower_bound(begin, end, value, comp);
+         RandomAccessIterator iter = detail::__lower_bound(begin, end, value, comp);
          return iter != end && !comp(value, thrust::detail::device::dereference(iter));
      }
 };
@@ -0,0 +1,123 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file histogram.inl
+ *  \brief Inline file for histogram.h.
+ */
+
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/detail/raw_buffer.h>
+#include <thrust/detail/histogram_bins.h>
+#include <thrust/adjacent_difference.h>
+#include <thrust/binary_search.h>
+#include <thrust/distance.h>
+#include <thrust/fill.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace generic
+{
+
+// Without atomics the samples are brought together by sorting: the bin
+// of every sample is computed and sorted, and the number of samples in
+// bins [0, b] is the upper bound of b in the sorted bins.
+template<typename InputIterator,
+         typename OutputIterator,
+         typename Size,
+         typename T>
+OutputIterator histogram_even(InputIterator first,
+                              InputIterator last,
+                              OutputIterator output,
+                              Size num_bins,
+                              T lower,
+                              T upper)
+{
+  typedef typename thrust::iterator_space<InputIterator>::type       Space;
+  typedef typename thrust::iterator_difference<InputIterator>::type  difference;
+
+  if(num_bins <= 0)
+    return output;
+
+  const difference n = thrust::distance(first, last);
+
+  if(n == 0)
+  {
+    typedef typename thrust::iterator_value<OutputIterator>::type CountType;
+    thrust::fill(output, output + num_bins, CountType(0));
+    return output + num_bins;
+  }
+
+  // samples outside the range go to the extra bin num_bins, past the ends below
+  raw_buffer<difference,Space> bins(n);
+  thrust::transform(first, last, bins.begin(), thrust::detail::even_bin<T,difference>(lower, upper, num_bins));
+  thrust::sort(bins.begin(), bins.end());
+
+  raw_buffer<difference,Space> ends(num_bins);
+  thrust::upper_bound(bins.begin(), bins.end(),
+                      thrust::counting_iterator<difference>(0),
+                      thrust::counting_iterator<difference>(num_bins),
+                      ends.begin());
+
+  return thrust::adjacent_difference(ends.begin(), ends.end(), output);
+} // end histogram_even()
+
+// The samples are sorted and the number of samples below each level is
+// its lower bound in the sorted samples; the count of a bin is the
+// difference between those of its two levels.
+template<typename InputIterator,
+         typename ForwardIterator,
+         typename OutputIterator>
+OutputIterator histogram_range(InputIterator first,
+                               InputIterator last,
+                               ForwardIterator levels_first,
+                               ForwardIterator levels_last,
+                               OutputIterator output)
+{
+  typedef typename thrust::iterator_space<InputIterator>::type         Space;
+  typedef typename thrust::iterator_value<InputIterator>::type         InputType;
+  typedef typename thrust::iterator_difference<ForwardIterator>::type  difference;
+
+  const difference num_levels = thrust::distance(levels_first, levels_last);
+
+  if(num_levels < 2)
+    return output;
+
+  raw_buffer<InputType,Space> sorted(first, last);
+  thrust::sort(sorted.begin(), sorted.end());
+
+  raw_buffer<difference,Space> below(num_levels);
+  thrust::lower_bound(sorted.begin(), sorted.end(), levels_first, levels_last, below.begin());
+
+  raw_buffer<difference,Space> counts(num_levels);
+  thrust::adjacent_difference(below.begin(), below.end(), counts.begin());
+
+  // the first difference counts the samples below the first level
+  return thrust::copy(counts.begin() + 1, counts.end(), output);
+} // end histogram_range()
+
+} // end generic
+} // end device
+} // end detail
+} // end thrust
+
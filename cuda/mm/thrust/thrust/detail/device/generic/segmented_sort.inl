@@ -0,0 +1,219 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file segmented_sort.inl
+ *  \brief Inline file for segmented_sort.h.
+ */
+
+#pragma once
+
+#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/for_each.h>
+#include <thrust/tuple.h>
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/detail/minimum_space.h>
+#include <thrust/iterator/detail/forced_iterator.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+
+// XXX WAR circluar #inclusion with this forward declaration
+template<typename InputIterator, typename UnaryFunction> void for_each(InputIterator, InputIterator, UnaryFunction);
+
+namespace generic
+{
+namespace detail
+{
+
+// Insertion sorts the segment [get<0>(t), get<1>(t)) of keys.  Each
+// segment is sorted serially, one segment per element of for_each.
+template <typename RandomAccessIterator, typename StrictWeakOrdering>
+struct segment_sort_functor
+{
+  RandomAccessIterator keys;
+  StrictWeakOrdering   comp;
+
+  segment_sort_functor(RandomAccessIterator _keys, StrictWeakOrdering _comp)
+    : keys(_keys), comp(_comp) {}
+
+  template <typename Tuple>
+  __host__ __device__
+  void operator()(Tuple t)
+  {
+    typedef typename thrust::iterator_value<RandomAccessIterator>::type      KeyType;
+    typedef typename thrust::iterator_difference<RandomAccessIterator>::type difference;
+
+    difference begin = thrust::get<0>(t);
+    difference end   = thrust::get<1>(t);
+
+    for(difference i = begin + 1; i < end; ++i)
+    {
+      RandomAccessIterator key_i = keys + i;
+      KeyType key = thrust::detail::device::dereference(key_i);
+
+      difference j = i;
+      for(; j > begin; --j)
+      {
+        RandomAccessIterator src = keys + (j - 1);
+        KeyType prev = thrust::detail::device::dereference(src);
+
+        if(!comp(key, prev))
+          break;
+
+        RandomAccessIterator dst = keys + j;
+        thrust::detail::device::dereference(dst) = prev;
+      }
+
+      RandomAccessIterator dst = keys + j;
+      thrust::detail::device::dereference(dst) = key;
+    }
+  }
+}; // end segment_sort_functor
+
+
+template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename StrictWeakOrdering>
+struct segment_sort_by_key_functor
+{
+  RandomAccessIterator1 keys;
+  RandomAccessIterator2 values;
+  StrictWeakOrdering    comp;
+
+  segment_sort_by_key_functor(RandomAccessIterator1 _keys, RandomAccessIterator2 _values, StrictWeakOrdering _comp)
+    : keys(_keys), values(_values), comp(_comp) {}
+
+  template <typename Tuple>
+  __host__ __device__
+  void operator()(Tuple t)
+  {
+    typedef typename thrust::iterator_value<RandomAccessIterator1>::type      KeyType;
+    typedef typename thrust::iterator_value<RandomAccessIterator2>::type      ValueType;
+    typedef typename thrust::iterator_difference<RandomAccessIterator1>::type difference;
+
+    difference begin = thrust::get<0>(t);
+    difference end   = thrust::get<1>(t);
+
+    for(difference i = begin + 1; i < end; ++i)
+    {
+      RandomAccessIterator1 key_i   = keys + i;
+      RandomAccessIterator2 value_i = values + i;
+      KeyType   key   = thrust::detail::device::dereference(key_i);
+      ValueType value = thrust::detail::device::dereference(value_i);
+
+      difference j = i;
+      for(; j > begin; --j)
+      {
+        RandomAccessIterator1 key_src = keys + (j - 1);
+        KeyType prev = thrust::detail::device::dereference(key_src);
+
+        if(!comp(key, prev))
+          break;
+
+        RandomAccessIterator1 key_dst   = keys + j;
+        RandomAccessIterator2 value_src = values + (j - 1);
+        RandomAccessIterator2 value_dst = values + j;
+        thrust::detail::device::dereference(key_dst)   = prev;
+        thrust::detail::device::dereference(value_dst) = thrust::detail::device::dereference(value_src);
+      }
+
+      RandomAccessIterator1 key_dst   = keys + j;
+      RandomAccessIterator2 value_dst = values + j;
+      thrust::detail::device::dereference(key_dst)   = key;
+      thrust::detail::device::dereference(value_dst) = value;
+    }
+  }
+}; // end segment_sort_by_key_functor
+
+} // end namespace detail
+
+
+template<typename RandomAccessIterator,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename StrictWeakOrdering>
+  void segmented_sort(RandomAccessIterator keys_first,
+                      InputIterator1 begin_offsets_first,
+                      InputIterator1 begin_offsets_last,
+                      InputIterator2 end_offsets_first,
+                      StrictWeakOrdering comp)
+{
+  // since we're hiding the keys inside a functor, their device space will get lost
+  // we need to create the zip_iterator with the minimum space of the offsets & keys
+
+  typedef typename thrust::iterator_space<InputIterator1>::type       Space1;
+  typedef typename thrust::iterator_space<InputIterator2>::type       Space2;
+  typedef typename thrust::iterator_space<RandomAccessIterator>::type Space3;
+
+  typedef typename thrust::detail::minimum_space<Space1,Space2>::type Space4;
+  typedef typename thrust::detail::minimum_space<Space3,Space4>::type Space;
+
+  typedef thrust::detail::forced_iterator<InputIterator1,Space> forced_iterator;
+
+  // force the begin offsets to be of the minimum space
+  forced_iterator first_forced(begin_offsets_first), last_forced(begin_offsets_last);
+
+  detail::segment_sort_functor<RandomAccessIterator,StrictWeakOrdering> func(keys_first, comp);
+  thrust::detail::device::for_each(thrust::make_zip_iterator(thrust::make_tuple(first_forced, end_offsets_first)),
+                                   thrust::make_zip_iterator(thrust::make_tuple(last_forced,  end_offsets_first + (begin_offsets_last - begin_offsets_first))),
+                                   func);
+} // end segmented_sort()
+
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename StrictWeakOrdering>
+  void segmented_sort_by_key(RandomAccessIterator1 keys_first,
+                             RandomAccessIterator2 values_first,
+                             InputIterator1 begin_offsets_first,
+                             InputIterator1 begin_offsets_last,
+                             InputIterator2 end_offsets_first,
+                             StrictWeakOrdering comp)
+{
+  // since we're hiding the keys & values inside a functor, their device space will get lost
+  // we need to create the zip_iterator with the minimum space of the offsets, keys & values
+
+  typedef typename thrust::iterator_space<InputIterator1>::type        Space1;
+  typedef typename thrust::iterator_space<InputIterator2>::type        Space2;
+  typedef typename thrust::iterator_space<RandomAccessIterator1>::type Space3;
+  typedef typename thrust::iterator_space<RandomAccessIterator2>::type Space4;
+
+  typedef typename thrust::detail::minimum_space<Space1,Space2>::type Space5;
+  typedef typename thrust::detail::minimum_space<Space3,Space4>::type Space6;
+  typedef typename thrust::detail::minimum_space<Space5,Space6>::type Space;
+
+  typedef thrust::detail::forced_iterator<InputIterator1,Space> forced_iterator;
+
+  // force the begin offsets to be of the minimum space
+  forced_iterator first_forced(begin_offsets_first), last_forced(begin_offsets_last);
+
+  detail::segment_sort_by_key_functor<RandomAccessIterator1,RandomAccessIterator2,StrictWeakOrdering> func(keys_first, values_first, comp);
+  thrust::detail::device::for_each(thrust::make_zip_iterator(thrust::make_tuple(first_forced, end_offsets_first)),
+                                   thrust::make_zip_iterator(thrust::make_tuple(last_forced,  end_offsets_first + (begin_offsets_last - begin_offsets_first))),
+                                   func);
+} // end segmented_sort_by_key()
+
+} // end namespace generic
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
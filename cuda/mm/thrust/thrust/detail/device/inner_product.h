@@ -21,7 +21,9 @@
 
 #pragma once
 
-#include <thrust/detail/device/generic/inner_product.h>
+#include <thrust/detail/device/dispatch/inner_product.h>
+
+#include <thrust/iterator/iterator_traits.h>
 
 namespace thrust {
 namespace detail {
@@ -33,7 +35,9 @@ OutputType
 inner_product(InputIterator1 first1, InputIterator1 last1,
               InputIterator2 first2, OutputType init,
               BinaryFunction1 binary_op1, BinaryFunction2 binary_op2) {
-    return thrust::detail::device::generic::inner_product(first1, last1, first2, init, binary_op1, binary_op2);
+    // dispatch on space
+    return thrust::detail::device::dispatch::inner_product(first1, last1, first2, init, binary_op1, binary_op2,
+            typename thrust::iterator_space<InputIterator1>::type());
 }
 
 } // end namespace device
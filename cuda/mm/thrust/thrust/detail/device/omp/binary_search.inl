@@ -0,0 +1,355 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file binary_search.inl
+ *  \brief Inline file for binary_search.h.
+ */
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/detail/raw_buffer.h>
+#include <thrust/device_ptr.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/generic/binary_search.h>
+#include <thrust/detail/device/omp/detail/batched_search.h>
+#include <thrust/detail/device/omp/detail/static_partition.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+namespace detail
+{
+
+// each query costs a few cache misses, so a thread needs fewer of them
+// than elements of a streaming algorithm to pay for itself
+const unsigned int search_grain_size = 1024;
+
+// lower_bound writes the index of the first position at which the query
+// could be inserted without violating the ordering
+struct lower_bound_mode
+{
+  typedef lower_bound_policy policy;
+
+  template<typename T, typename U, typename Size, typename StrictWeakOrdering>
+  static Size sorted_result(const T *, Size, Size index, const U &, StrictWeakOrdering)
+  {
+    return index;
+  }
+
+  template<typename T, typename U, typename Size, typename StrictWeakOrdering>
+  static Size eytzinger_result(const T *, const Size *pos, Size n, Size node, const U &, StrictWeakOrdering)
+  {
+    return node ? pos[node] : n;
+  }
+
+  template<typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+  static OutputIterator generic(ForwardIterator begin, ForwardIterator end,
+                                InputIterator values_begin, InputIterator values_end,
+                                OutputIterator output, StrictWeakOrdering comp)
+  {
+    return thrust::detail::device::generic::lower_bound(begin, end, values_begin, values_end, output, comp);
+  }
+}; // end lower_bound_mode
+
+// upper_bound writes the index of the last such position
+struct upper_bound_mode
+{
+  typedef upper_bound_policy policy;
+
+  template<typename T, typename U, typename Size, typename StrictWeakOrdering>
+  static Size sorted_result(const T *, Size, Size index, const U &, StrictWeakOrdering)
+  {
+    return index;
+  }
+
+  template<typename T, typename U, typename Size, typename StrictWeakOrdering>
+  static Size eytzinger_result(const T *, const Size *pos, Size n, Size node, const U &, StrictWeakOrdering)
+  {
+    return node ? pos[node] : n;
+  }
+
+  template<typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+  static OutputIterator generic(ForwardIterator begin, ForwardIterator end,
+                                InputIterator values_begin, InputIterator values_end,
+                                OutputIterator output, StrictWeakOrdering comp)
+  {
+    return thrust::detail::device::generic::upper_bound(begin, end, values_begin, values_end, output, comp);
+  }
+}; // end upper_bound_mode
+
+// binary_search writes whether an element equivalent to the query exists,
+// which is the case when the lower bound of the query is equivalent to it
+struct binary_search_mode
+{
+  typedef lower_bound_policy policy;
+
+  template<typename T, typename U, typename Size, typename StrictWeakOrdering>
+  static bool sorted_result(const T *a, Size n, Size index, const U &x, StrictWeakOrdering comp)
+  {
+    return index < n && !comp(x, a[index]);
+  }
+
+  template<typename T, typename U, typename Size, typename StrictWeakOrdering>
+  static bool eytzinger_result(const T *b, const Size *, Size, Size node, const U &x, StrictWeakOrdering comp)
+  {
+    return node && !comp(x, b[node]);
+  }
+
+  template<typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+  static OutputIterator generic(ForwardIterator begin, ForwardIterator end,
+                                InputIterator values_begin, InputIterator values_end,
+                                OutputIterator output, StrictWeakOrdering comp)
+  {
+    return thrust::detail::device::generic::binary_search(begin, end, values_begin, values_end, output, comp);
+  }
+}; // end binary_search_mode
+
+
+// Copies the sorted array a to the Eytzinger layout b and records the sorted
+// index of every node in pos.  The subtrees rooted a few levels below the
+// root are filled in parallel by in-order walks starting at their offsets
+// in a, and the handful of nodes above them are placed one by one.
+template<typename T, typename Size>
+void build_eytzinger(const T *a, T *b, Size *pos, Size n)
+{
+  const int num_chunks = num_threads_for(n);
+
+  // a few subtrees per thread balances the uneven bottom level
+  Size first_root = 1;
+  while(first_root < Size(4 * num_chunks) && 2 * first_root <= n)
+    first_root *= 2;
+
+  const Size last_root = (2 * first_root - 1 < n) ? 2 * first_root - 1 : n;
+
+  for(Size k = 1; k < first_root; ++k)
+  {
+    Size rank = eytzinger_rank(k, n);
+    b[k]   = a[rank];
+    pos[k] = rank;
+  }
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+# pragma omp parallel num_threads(num_chunks)
+  {
+    int thread_id = omp_get_thread_num();
+    int team_size = omp_get_num_threads();
+
+    for(Size root = first_root + thread_id; root <= last_root; root += team_size)
+    {
+      // the subtree starts with the leftmost node of its left subtree
+      Size i = eytzinger_rank(root, n) - eytzinger_subtree_size(2 * root, n);
+      eytzinger_fill(a, b, pos, root, n, i);
+    }
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+} // end build_eytzinger()
+
+
+// The haystack is a plain array.  Queries are split among threads in
+// contiguous chunks and each thread answers its queries in small groups
+// which descend the search structure in lockstep, so the loads of the
+// group are in flight together.  When there are enough queries to amortize
+// the copy, a large haystack is first copied to the Eytzinger layout.
+template<typename Mode,
+         typename ForwardIterator,
+         typename InputIterator,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+OutputIterator batched_search(ForwardIterator begin,
+                              ForwardIterator end,
+                              InputIterator values_begin,
+                              InputIterator values_end,
+                              OutputIterator output,
+                              StrictWeakOrdering comp,
+                              thrust::detail::true_type)
+{
+  using thrust::detail::device::dereference;
+
+  typedef typename Mode::policy                                             Policy;
+  typedef typename thrust::iterator_value<ForwardIterator>::type            T;
+  typedef typename thrust::iterator_value<InputIterator>::type              U;
+  typedef typename thrust::iterator_difference<ForwardIterator>::type       Size;
+  typedef typename thrust::iterator_difference<InputIterator>::type         difference;
+
+  const Size       n = end - begin;
+  const difference m = values_end - values_begin;
+
+  if(n == 0)
+    return Mode::generic(begin, end, values_begin, values_end, output, comp);
+
+  const T *a = thrust::raw_pointer_cast(&*begin);
+
+  const bool use_eytzinger = n >= Size(eytzinger_min_size) &&
+                             difference(m) >= difference(n / eytzinger_min_ratio);
+
+  thrust::detail::raw_host_buffer<T>    eytzinger_keys(use_eytzinger ? n + 1 : 1);
+  thrust::detail::raw_host_buffer<Size> eytzinger_pos(use_eytzinger ? n + 1 : 1);
+  T    *b   = &eytzinger_keys[0];
+  Size *pos = &eytzinger_pos[0];
+
+  if(use_eytzinger)
+    build_eytzinger(a, b, pos, n);
+
+  const unsigned int depth = eytzinger_depth(n);
+
+  const int num_chunks = num_threads_for(m, difference(search_grain_size));
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+# pragma omp parallel num_threads(num_chunks)
+  {
+    int thread_id = omp_get_thread_num();
+    int team_size = omp_get_num_threads();
+
+    U    x[search_group_size];
+    Size result[search_group_size];
+
+    for(int chunk = thread_id; chunk < num_chunks; chunk += team_size)
+    {
+      difference chunk_first = chunk_begin(m, num_chunks, chunk);
+      difference chunk_last  = chunk_end(m, num_chunks, chunk);
+
+      for(difference i = chunk_first; i < chunk_last; i += search_group_size)
+      {
+        unsigned int count = (chunk_last - i < difference(search_group_size)) ?
+                             (unsigned int) (chunk_last - i) : search_group_size;
+
+        for(unsigned int g = 0; g < count; ++g)
+          x[g] = dereference(values_begin, i + g);
+
+        if(use_eytzinger)
+        {
+          search_eytzinger<Policy>(b, n, depth, x, count, result, comp);
+
+          for(unsigned int g = 0; g < count; ++g)
+            dereference(output, i + g) = Mode::eytzinger_result(b, pos, n, result[g], x[g], comp);
+        }
+        else
+        {
+          search_sorted<Policy>(a, n, x, count, result, comp);
+
+          for(unsigned int g = 0; g < count; ++g)
+            dereference(output, i + g) = Mode::sorted_result(a, n, result[g], x[g], comp);
+        }
+      }
+    }
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+  return output + m;
+} // end batched_search()
+
+template<typename Mode,
+         typename ForwardIterator,
+         typename InputIterator,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+OutputIterator batched_search(ForwardIterator begin,
+                              ForwardIterator end,
+                              InputIterator values_begin,
+                              InputIterator values_end,
+                              OutputIterator output,
+                              StrictWeakOrdering comp,
+                              thrust::detail::false_type)
+{
+  // the haystack is not a plain array, so search it one query at a time
+  return Mode::generic(begin, end, values_begin, values_end, output, comp);
+} // end batched_search()
+
+} // end namespace detail
+
+
+template<typename ForwardIterator,
+         typename InputIterator,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+OutputIterator lower_bound(ForwardIterator begin,
+                           ForwardIterator end,
+                           InputIterator values_begin,
+                           InputIterator values_end,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to OpenMP support in your compiler.                         X
+  // ========================================================================
+  THRUST_STATIC_ASSERT( (depend_on_instantiation<ForwardIterator,
+                        (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+  // dispatch on the trivialness of the haystack
+  return detail::batched_search<detail::lower_bound_mode>(begin, end, values_begin, values_end, output, comp,
+          thrust::detail::is_trivial_iterator<ForwardIterator>());
+} // end lower_bound()
+
+template<typename ForwardIterator,
+         typename InputIterator,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+OutputIterator upper_bound(ForwardIterator begin,
+                           ForwardIterator end,
+                           InputIterator values_begin,
+                           InputIterator values_end,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+  THRUST_STATIC_ASSERT( (depend_on_instantiation<ForwardIterator,
+                        (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+  return detail::batched_search<detail::upper_bound_mode>(begin, end, values_begin, values_end, output, comp,
+          thrust::detail::is_trivial_iterator<ForwardIterator>());
+} // end upper_bound()
+
+template<typename ForwardIterator,
+         typename InputIterator,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+OutputIterator binary_search(ForwardIterator begin,
+                             ForwardIterator end,
+                             InputIterator values_begin,
+                             InputIterator values_end,
+                             OutputIterator output,
+                             StrictWeakOrdering comp)
+{
+  THRUST_STATIC_ASSERT( (depend_on_instantiation<ForwardIterator,
+                        (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+  return detail::batched_search<detail::binary_search_mode>(begin, end, values_begin, values_end, output, comp,
+          thrust::detail::is_trivial_iterator<ForwardIterator>());
+} // end binary_search()
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
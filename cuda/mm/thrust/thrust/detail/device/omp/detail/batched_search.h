@@ -0,0 +1,225 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file batched_search.h
+ *  \brief Serial building blocks for answering many binary search
+ *         queries against one sorted array.
+ */
+
+#pragma once
+
+#include <thrust/detail/device/omp/detail/prefetch.h>
+
+namespace thrust {
+namespace detail {
+namespace device {
+namespace omp {
+namespace detail {
+
+// number of queries which descend the search structure in lockstep
+const unsigned int search_group_size = 8;
+
+// haystacks at least this large are copied to the Eytzinger layout ...
+const unsigned int eytzinger_min_size = 1 << 16;
+
+// ... provided there are at least haystack size / eytzinger_min_ratio queries
+const unsigned int eytzinger_min_ratio = 4;
+
+// the search direction for lower_bound: go right while the element precedes x
+struct lower_bound_policy {
+    template<typename T, typename U, typename StrictWeakOrdering>
+    static bool go_right(const T& element, const U& x, StrictWeakOrdering comp) {
+        return comp(element, x);
+    }
+};
+
+// the search direction for upper_bound: go right unless x precedes the element
+struct upper_bound_policy {
+    template<typename T, typename U, typename StrictWeakOrdering>
+    static bool go_right(const T& element, const U& x, StrictWeakOrdering comp) {
+        return !comp(x, element);
+    }
+};
+
+/////////////////////////
+// Sorted order layout //
+/////////////////////////
+
+// Branch-free lower/upper bound of count (<= search_group_size) queries
+// against the sorted array [a, a + n), n > 0.  The length of the search
+// interval depends only on n, so all queries take the same number of
+// steps and the loop over the group carries no branches.
+template<typename Policy, typename T, typename U, typename Size, typename StrictWeakOrdering>
+void search_sorted(const T* a, Size n, const U* x, unsigned int count, Size* result,
+                   StrictWeakOrdering comp) {
+    const T* base[search_group_size];
+
+    for (unsigned int g = 0; g < count; ++g) {
+        base[g] = a;
+    }
+
+    Size len = n;
+
+    while (len > 1) {
+        Size half = len / 2;
+
+        for (unsigned int g = 0; g < count; ++g) {
+            // touch both possible midpoints of the next step
+            prefetch(base[g] + half / 2);
+            prefetch(base[g] + half + half / 2);
+
+            base[g] = Policy::go_right(base[g][half], x[g], comp) ? base[g] + half : base[g];
+        }
+
+        len -= half;
+    }
+
+    for (unsigned int g = 0; g < count; ++g) {
+        result[g] = Size(base[g] - a) + Size(Policy::go_right(*base[g], x[g], comp));
+    }
+}
+
+//////////////////////
+// Eytzinger layout //
+//////////////////////
+
+// The Eytzinger (BFS) layout stores the implicit complete binary search tree
+// of the sorted array level by level: the root in b[1] and the children of
+// b[k] in b[2k] and b[2k + 1].  The top levels of the tree share a few cache
+// lines and the children of a node are adjacent, so a search touches far
+// fewer lines than bisection of the sorted array.  pos[k] is the index in the
+// sorted array of b[k].
+
+// number of nodes in the subtree rooted at k of an n node tree
+template<typename Size>
+Size eytzinger_subtree_size(Size k, Size n) {
+    if (k > n) {
+        return 0;
+    }
+
+    // the levels above the deepest one reached are full
+    Size first = k;
+    Size last  = k;
+    Size size  = 0;
+
+    while (2 * first <= n) {
+        size += last - first + 1;
+        first = 2 * first;
+        last  = 2 * last + 1;
+    }
+
+    return size + ((last < n ? last : n) - first + 1);
+}
+
+// index in sorted order of node k of an n node tree
+template<typename Size>
+Size eytzinger_rank(Size k, Size n) {
+    // find the highest bit of k, which marks the root
+    Size bit = 1;
+    while (bit <= k / 2) {
+        bit *= 2;
+    }
+
+    // walk down from the root, skipping the left subtree at every right turn
+    Size node = 1;
+    Size rank = 0;
+
+    for (bit /= 2; bit > 0; bit /= 2) {
+        if (k & bit) {
+            rank += eytzinger_subtree_size(2 * node, n) + 1;
+            node  = 2 * node + 1;
+        } else {
+            node  = 2 * node;
+        }
+    }
+
+    return rank + eytzinger_subtree_size(2 * k, n);
+}
+
+// fills the subtree rooted at k from a[i], a[i + 1], ... by an in-order walk
+template<typename T, typename Size>
+void eytzinger_fill(const T* a, T* b, Size* pos, Size k, Size n, Size& i) {
+    if (k > n) {
+        return;
+    }
+
+    eytzinger_fill(a, b, pos, 2 * k, n, i);
+    b[k]   = a[i];
+    pos[k] = i;
+    ++i;
+    eytzinger_fill(a, b, pos, 2 * k + 1, n, i);
+}
+
+// Lower/upper bound of count (<= search_group_size) queries against the
+// n > 0 node tree in b.  Writes the node of the result, or 0 when every
+// element goes left of the query.  depth is the number of levels of the tree.
+template<typename Policy, typename T, typename U, typename Size, typename StrictWeakOrdering>
+void search_eytzinger(const T* b, Size n, unsigned int depth, const U* x, unsigned int count,
+                      Size* node, StrictWeakOrdering comp) {
+    Size k[search_group_size];
+
+    for (unsigned int g = 0; g < count; ++g) {
+        k[g] = 1;
+    }
+
+    // every level but the last is full, so no query can leave the tree
+    for (unsigned int level = 1; level < depth; ++level) {
+        for (unsigned int g = 0; g < count; ++g) {
+            // the sixteen descendants four levels down are adjacent
+            if (16 * k[g] <= n) {
+                prefetch(b + 16 * k[g]);
+            }
+
+            k[g] = 2 * k[g] + Size(Policy::go_right(b[k[g]], x[g], comp));
+        }
+    }
+
+    for (unsigned int g = 0; g < count; ++g) {
+        // the last level may be partial
+        if (k[g] <= n) {
+            k[g] = 2 * k[g] + Size(Policy::go_right(b[k[g]], x[g], comp));
+        }
+
+        // the result is the last node at which the search went left: drop
+        // the trailing right turns and the left turn before them
+        Size j = k[g];
+        while (j & 1) {
+            j >>= 1;
+        }
+
+        node[g] = j >> 1;
+    }
+}
+
+// number of levels of an n node tree
+template<typename Size>
+unsigned int eytzinger_depth(Size n) {
+    unsigned int depth = 0;
+
+    for (; n > 0; n /= 2) {
+        ++depth;
+    }
+
+    return depth;
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -0,0 +1,111 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file contiguous_reduce.h
+ *  \brief OpenMP reduction over an indexed range using contiguous
+ *         per-thread chunks and independent accumulators.
+ */
+
+#pragma once
+
+#include <thrust/detail/device/dereference.h>
+
+namespace thrust {
+namespace detail {
+namespace device {
+namespace omp {
+namespace detail {
+
+// loaders map an index to the value being reduced
+
+// generic iterator: advance and dereference
+template<typename Iterator, typename Result>
+struct iterator_loader {
+    Iterator first;
+
+    iterator_loader(Iterator _first) : first(_first) {}
+
+    template<typename Size>
+    Result operator()(Size i) const {
+        Iterator temp = first + i;
+        return thrust::detail::device::dereference(temp);
+    }
+}; // end iterator_loader
+
+// raw pointer: a plain indexed load the compiler can vectorize
+template<typename T>
+struct pointer_loader {
+    const T* first;
+
+    pointer_loader(const T* _first) : first(_first) {}
+
+    template<typename Size>
+    const T& operator()(Size i) const {
+        return first[i];
+    }
+}; // end pointer_loader
+
+// raw pointer fed through a unary function (transform_reduce)
+template<typename T, typename UnaryFunction, typename Result>
+struct unary_pointer_loader {
+    const T* first;
+    UnaryFunction f;
+
+    unary_pointer_loader(const T* _first, UnaryFunction _f) : first(_first), f(_f) {}
+
+    template<typename Size>
+    Result operator()(Size i) const {
+        return f(first[i]);
+    }
+}; // end unary_pointer_loader
+
+// two raw pointers fed through a binary function (inner_product)
+template<typename T1, typename T2, typename BinaryFunction, typename Result>
+struct binary_pointer_loader {
+    const T1* first1;
+    const T2* first2;
+    BinaryFunction f;
+
+    binary_pointer_loader(const T1* _first1, const T2* _first2, BinaryFunction _f)
+        : first1(_first1), first2(_first2), f(_f) {}
+
+    template<typename Size>
+    Result operator()(Size i) const {
+        return f(first1[i], first2[i]);
+    }
+}; // end binary_pointer_loader
+
+
+// reduces load(i) for i in [0,n) into init with binary_op
+template<typename Loader,
+         typename Size,
+         typename OutputType,
+         typename BinaryFunction>
+OutputType contiguous_reduce(Loader load,
+                             Size n,
+                             OutputType init,
+                             BinaryFunction binary_op);
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
+#include <thrust/detail/device/omp/detail/contiguous_reduce.inl>
+
@@ -0,0 +1,148 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <thrust/detail/raw_buffer.h>
+#include <thrust/detail/device/omp/detail/static_partition.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+namespace detail
+{
+
+// number of independent accumulators carried through the inner loop.
+// eight floats fill one AVX register; the extra chains also hide the
+// latency of dependent floating point adds
+const unsigned int reduce_unroll = 8;
+
+// combine acc[0..count) pairwise into acc[0].  associativity keeps the pairing
+// correct; reduce_interval's strided accumulators then also assume the
+// commutativity that reduce.h documents, since they interleave the operands
+template<typename OutputType, typename BinaryFunction>
+OutputType tree_combine(OutputType* acc, unsigned int count, BinaryFunction binary_op)
+{
+    for (unsigned int stride = 1; stride < count; stride *= 2)
+        for (unsigned int j = 0; j + stride < count; j += 2 * stride)
+            acc[j] = binary_op(acc[j], acc[j + stride]);
+
+    return acc[0];
+}
+
+// serially reduce load(i) for i in [begin,end), which must be non-empty.
+// no identity is required: the accumulators are seeded from the range itself.
+// accumulator j sees elements begin+j, begin+j+unroll, ... and the tail goes
+// into acc[0], so binary_op must be commutative as well as associative
+template<typename OutputType,
+         typename Loader,
+         typename Size,
+         typename BinaryFunction>
+OutputType reduce_interval(const Loader& load,
+                           Size begin,
+                           Size end,
+                           BinaryFunction binary_op)
+{
+    const Size unroll = reduce_unroll;
+
+    if (end - begin < 2 * unroll)
+    {
+        OutputType sum = load(begin);
+
+        for (Size i = begin + 1; i < end; ++i)
+            sum = binary_op(sum, load(i));
+
+        return sum;
+    }
+
+    OutputType acc[reduce_unroll];
+
+    for (Size j = 0; j < unroll; ++j)
+        acc[j] = load(begin + j);
+
+    Size i = begin + unroll;
+
+    // independent dependency chains; the fixed trip count lets the compiler
+    // keep acc in vector registers
+    for (; i + unroll <= end; i += unroll)
+        for (Size j = 0; j < unroll; ++j)
+            acc[j] = binary_op(acc[j], load(i + j));
+
+    for (; i < end; ++i)
+        acc[0] = binary_op(acc[0], load(i));
+
+    return tree_combine(acc, reduce_unroll, binary_op);
+}
+
+
+template<typename Loader,
+         typename Size,
+         typename OutputType,
+         typename BinaryFunction>
+OutputType contiguous_reduce(Loader load,
+                             Size n,
+                             OutputType init,
+                             BinaryFunction binary_op)
+{
+    if (n <= 0)
+        return init;
+
+    int num_threads = num_threads_for(n);
+
+    if (num_threads == 1)
+        return binary_op(init, reduce_interval<OutputType>(load, Size(0), n, binary_op));
+
+    thrust::detail::raw_host_buffer<OutputType> thread_results(num_threads);
+    OutputType* results = &thread_results[0];
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#   pragma omp parallel num_threads(num_threads)
+    {
+        int thread_id = omp_get_thread_num();
+        int team_size = omp_get_num_threads();
+
+        // each thread reduces one contiguous chunk; the loop only matters
+        // when the runtime grants fewer threads than requested
+        for (int chunk = thread_id; chunk < num_threads; chunk += team_size)
+        {
+            Size begin = chunk_begin(n, num_threads, chunk);
+            Size end   = chunk_end(n, num_threads, chunk);
+
+            results[chunk] = reduce_interval<OutputType>(load, begin, end, binary_op);
+        }
+    }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+    return binary_op(init, tree_combine(results, num_threads, binary_op));
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -0,0 +1,127 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file merge_path.h
+ *  \brief Diagonal (merge path) partitioning of two sorted ranges.
+ */
+
+#pragma once
+
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/device/dereference.h>
+
+namespace thrust {
+namespace detail {
+namespace device {
+namespace omp {
+namespace detail {
+
+// returns the number of elements of [first1, first1 + n1) among the first
+// diag elements of the stable merge of the two ranges.  ties are taken from
+// the first range, as in std::merge
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Size,
+         typename StrictWeakOrdering>
+Size merge_path(RandomAccessIterator1 first1, Size n1,
+                RandomAccessIterator2 first2, Size n2,
+                Size diag,
+                StrictWeakOrdering comp) {
+    Size lo = diag > n2 ? diag - n2 : Size(0);
+    Size hi = diag < n1 ? diag : n1;
+
+    while (lo < hi) {
+        Size mid = lo + (hi - lo) / 2;
+
+        RandomAccessIterator1 a = first1 + mid;
+        RandomAccessIterator2 b = first2 + (diag - 1 - mid);
+
+        if (comp(thrust::detail::device::dereference(b), thrust::detail::device::dereference(a)))
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+
+    return lo;
+}
+
+// number of elements of [first, first + n) which are less than value
+template<typename RandomAccessIterator,
+         typename Size,
+         typename T,
+         typename StrictWeakOrdering>
+Size lower_bound_index(RandomAccessIterator first, Size n, const T& value, StrictWeakOrdering comp) {
+    Size lo = 0;
+    Size hi = n;
+
+    while (lo < hi) {
+        Size mid = lo + (hi - lo) / 2;
+
+        RandomAccessIterator x = first + mid;
+
+        if (comp(thrust::detail::device::dereference(x), value))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+// splits the two ranges at diagonal diag such that no run of equivalent
+// elements straddles the split.  the split is moved back to the first
+// element equivalent to the one the merge path would consume next, so
+// the k-th copy of a value in one range always meets the k-th copy in
+// the other range within the same partition.  this is what the multiset
+// semantics of set_intersection, set_union and set_difference require
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Size,
+         typename StrictWeakOrdering>
+void balanced_split(RandomAccessIterator1 first1, Size n1,
+                    RandomAccessIterator2 first2, Size n2,
+                    Size diag,
+                    StrictWeakOrdering comp,
+                    Size& i, Size& j) {
+    i = merge_path(first1, n1, first2, n2, diag, comp);
+    j = diag - i;
+
+    if (i < n1) {
+        RandomAccessIterator1 a = first1 + i;
+
+        if (j == n2 || !comp(thrust::detail::device::dereference(first2 + j), thrust::detail::device::dereference(a))) {
+            // the next element is a; everything consumed from the second
+            // range is strictly less, so only i moves back
+            typename thrust::iterator_value<RandomAccessIterator1>::type pivot = thrust::detail::device::dereference(a);
+            i = lower_bound_index(first1, i, pivot, comp);
+            return;
+        }
+    }
+
+    if (j < n2) {
+        typename thrust::iterator_value<RandomAccessIterator2>::type pivot = thrust::detail::device::dereference(first2 + j);
+        i = lower_bound_index(first1, i, pivot, comp);
+        j = lower_bound_index(first2, j, pivot, comp);
+    }
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -0,0 +1,138 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file prefetch.h
+ *  \brief Software prefetching of the elements behind an iterator.
+ */
+
+#pragma once
+
+#include <thrust/detail/type_traits.h>
+#include <thrust/device_ptr.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/tuple.h>
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
+
+// the number of elements ahead of the current one an irregular access
+// pattern (e.g. gather and scatter) requests from memory
+#ifndef THRUST_OMP_PREFETCH_DISTANCE
+#define THRUST_OMP_PREFETCH_DISTANCE 16
+#endif
+
+namespace thrust {
+namespace detail {
+namespace device {
+namespace omp {
+namespace detail {
+
+inline void prefetch(const void* ptr) {
+#if defined(__GNUC__)
+    __builtin_prefetch(ptr);
+#elif defined(_MSC_VER)
+    _mm_prefetch(static_cast<const char*>(ptr), _MM_HINT_T0);
+#else
+    (void) ptr;
+#endif
+}
+
+inline void prefetch_for_write(const void* ptr) {
+#if defined(__GNUC__)
+    __builtin_prefetch(ptr, 1);
+#elif defined(_MSC_VER)
+    _mm_prefetch(static_cast<const char*>(ptr), _MM_HINT_T0);
+#else
+    (void) ptr;
+#endif
+}
+
+// Prefetches the element at position i of an iterator.  Only trivial iterators
+// expose an address to prefetch; zip_iterators prefetch each of their
+// component iterators and every other iterator is left alone.
+template <typename Iterator,
+          typename IsTrivial = typename thrust::detail::is_trivial_iterator<Iterator>::type>
+struct element_prefetcher {
+    template <typename Size>
+    static void read(Iterator, Size) {}
+
+    template <typename Size>
+    static void write(Iterator, Size) {}
+};
+
+template <typename Iterator>
+struct element_prefetcher<Iterator, thrust::detail::true_type> {
+    template <typename Size>
+    static void read(Iterator iter, Size i) {
+        prefetch(thrust::raw_pointer_cast(&*(iter + i)));
+    }
+
+    template <typename Size>
+    static void write(Iterator iter, Size i) {
+        prefetch_for_write(thrust::raw_pointer_cast(&*(iter + i)));
+    }
+};
+
+template <typename IteratorTuple,
+          unsigned int I = 0,
+          unsigned int N = thrust::tuple_size<IteratorTuple>::value>
+struct tuple_prefetcher {
+    typedef typename thrust::tuple_element<I, IteratorTuple>::type Iterator;
+
+    template <typename Size>
+    static void read(const IteratorTuple& iters, Size i) {
+        element_prefetcher<Iterator>::read(thrust::get<I>(iters), i);
+        tuple_prefetcher<IteratorTuple, I + 1, N>::read(iters, i);
+    }
+
+    template <typename Size>
+    static void write(const IteratorTuple& iters, Size i) {
+        element_prefetcher<Iterator>::write(thrust::get<I>(iters), i);
+        tuple_prefetcher<IteratorTuple, I + 1, N>::write(iters, i);
+    }
+};
+
+template <typename IteratorTuple, unsigned int N>
+struct tuple_prefetcher<IteratorTuple, N, N> {
+    template <typename Size>
+    static void read(const IteratorTuple&, Size) {}
+
+    template <typename Size>
+    static void write(const IteratorTuple&, Size) {}
+};
+
+template <typename IteratorTuple>
+struct element_prefetcher<thrust::zip_iterator<IteratorTuple>, thrust::detail::false_type> {
+    template <typename Size>
+    static void read(const thrust::zip_iterator<IteratorTuple>& iter, Size i) {
+        tuple_prefetcher<IteratorTuple>::read(iter.get_iterator_tuple(), i);
+    }
+
+    template <typename Size>
+    static void write(const thrust::zip_iterator<IteratorTuple>& iter, Size i) {
+        tuple_prefetcher<IteratorTuple>::write(iter.get_iterator_tuple(), i);
+    }
+};
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
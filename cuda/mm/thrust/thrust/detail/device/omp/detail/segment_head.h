@@ -0,0 +1,50 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file segment_head.h
+ *  \brief Segment boundary test shared by the OpenMP segmented algorithms.
+ */
+
+#pragma once
+
+#include <thrust/detail/device/dereference.h>
+
+namespace thrust {
+namespace detail {
+namespace device {
+namespace omp {
+namespace detail {
+
+// true when element i of the keys begins a new segment, i.e. when it is
+// the first element or pred does not consider it equivalent to element i-1
+template<typename InputIterator, typename Size, typename BinaryPredicate>
+bool is_segment_head(InputIterator keys, Size i, BinaryPredicate pred) {
+    if (i == 0)
+        return true;
+
+    InputIterator prev = keys + (i - 1);
+    InputIterator curr = keys + i;
+
+    return !pred(thrust::detail::device::dereference(prev), thrust::detail::device::dereference(curr));
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -0,0 +1,204 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file set_operation.h
+ *  \brief Serial merge and set operation kernels, and an OpenMP driver
+ *         which runs them on independent co-ranked partitions.
+ */
+
+#pragma once
+
+#include <thrust/detail/device/dereference.h>
+
+namespace thrust {
+namespace detail {
+namespace device {
+namespace omp {
+namespace detail {
+
+// each operation provides capacity(), an upper bound on its output for
+// inputs of the given lengths which is additive over partitions, and
+// apply(), the serial algorithm with std:: semantics
+
+struct merge_op {
+    template<typename Size>
+    static Size capacity(Size n1, Size n2) {
+        return n1 + n2;
+    }
+
+    template<typename InputIterator1, typename InputIterator2, typename OutputIterator, typename StrictWeakOrdering>
+    static OutputIterator apply(InputIterator1 first1, InputIterator1 last1,
+                                InputIterator2 first2, InputIterator2 last2,
+                                OutputIterator result, StrictWeakOrdering comp) {
+        using thrust::detail::device::dereference;
+
+        for (; first1 != last1 && first2 != last2; ++result) {
+            if (comp(dereference(first2), dereference(first1))) {
+                dereference(result) = dereference(first2);
+                ++first2;
+            } else {
+                dereference(result) = dereference(first1);
+                ++first1;
+            }
+        }
+
+        for (; first1 != last1; ++first1, ++result)
+            dereference(result) = dereference(first1);
+
+        for (; first2 != last2; ++first2, ++result)
+            dereference(result) = dereference(first2);
+
+        return result;
+    }
+}; // end merge_op
+
+
+struct set_intersection_op {
+    template<typename Size>
+    static Size capacity(Size n1, Size) {
+        return n1;
+    }
+
+    template<typename InputIterator1, typename InputIterator2, typename OutputIterator, typename StrictWeakOrdering>
+    static OutputIterator apply(InputIterator1 first1, InputIterator1 last1,
+                                InputIterator2 first2, InputIterator2 last2,
+                                OutputIterator result, StrictWeakOrdering comp) {
+        using thrust::detail::device::dereference;
+
+        while (first1 != last1 && first2 != last2) {
+            if (comp(dereference(first1), dereference(first2))) {
+                ++first1;
+            } else if (comp(dereference(first2), dereference(first1))) {
+                ++first2;
+            } else {
+                dereference(result) = dereference(first1);
+                ++first1;
+                ++first2;
+                ++result;
+            }
+        }
+
+        return result;
+    }
+}; // end set_intersection_op
+
+
+struct set_union_op {
+    template<typename Size>
+    static Size capacity(Size n1, Size n2) {
+        return n1 + n2;
+    }
+
+    template<typename InputIterator1, typename InputIterator2, typename OutputIterator, typename StrictWeakOrdering>
+    static OutputIterator apply(InputIterator1 first1, InputIterator1 last1,
+                                InputIterator2 first2, InputIterator2 last2,
+                                OutputIterator result, StrictWeakOrdering comp) {
+        using thrust::detail::device::dereference;
+
+        for (; first1 != last1 && first2 != last2; ++result) {
+            if (comp(dereference(first1), dereference(first2))) {
+                dereference(result) = dereference(first1);
+                ++first1;
+            } else if (comp(dereference(first2), dereference(first1))) {
+                dereference(result) = dereference(first2);
+                ++first2;
+            } else {
+                dereference(result) = dereference(first1);
+                ++first1;
+                ++first2;
+            }
+        }
+
+        for (; first1 != last1; ++first1, ++result)
+            dereference(result) = dereference(first1);
+
+        for (; first2 != last2; ++first2, ++result)
+            dereference(result) = dereference(first2);
+
+        return result;
+    }
+}; // end set_union_op
+
+
+struct set_difference_op {
+    template<typename Size>
+    static Size capacity(Size n1, Size) {
+        return n1;
+    }
+
+    template<typename InputIterator1, typename InputIterator2, typename OutputIterator, typename StrictWeakOrdering>
+    static OutputIterator apply(InputIterator1 first1, InputIterator1 last1,
+                                InputIterator2 first2, InputIterator2 last2,
+                                OutputIterator result, StrictWeakOrdering comp) {
+        using thrust::detail::device::dereference;
+
+        while (first1 != last1 && first2 != last2) {
+            if (comp(dereference(first1), dereference(first2))) {
+                dereference(result) = dereference(first1);
+                ++first1;
+                ++result;
+            } else if (comp(dereference(first2), dereference(first1))) {
+                ++first2;
+            } else {
+                ++first1;
+                ++first2;
+            }
+        }
+
+        for (; first1 != last1; ++first1, ++result)
+            dereference(result) = dereference(first1);
+
+        return result;
+    }
+}; // end set_difference_op
+
+
+// runs SetOperation on partitions of the inputs found by balanced_split,
+// then compacts the partial results into result
+template<typename SetOperation,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename StrictWeakOrdering>
+RandomAccessIterator3 set_operation(RandomAccessIterator1 first1,
+                                    RandomAccessIterator1 last1,
+                                    RandomAccessIterator2 first2,
+                                    RandomAccessIterator2 last2,
+                                    RandomAccessIterator3 result,
+                                    StrictWeakOrdering comp);
+
+// merges the inputs into result; each thread merges the co-ranked
+// slices found on an evenly spaced diagonal of the merge path
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename StrictWeakOrdering>
+RandomAccessIterator3 merge(RandomAccessIterator1 first1,
+                            RandomAccessIterator1 last1,
+                            RandomAccessIterator2 first2,
+                            RandomAccessIterator2 last2,
+                            RandomAccessIterator3 result,
+                            StrictWeakOrdering comp);
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
+#include <thrust/detail/device/omp/detail/set_operation.inl>
+
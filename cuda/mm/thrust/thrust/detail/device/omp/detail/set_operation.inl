@@ -0,0 +1,194 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/raw_buffer.h>
+#include <thrust/detail/device/omp/detail/merge_path.h>
+#include <thrust/detail/device/omp/detail/static_partition.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+namespace detail
+{
+
+template<typename SetOperation,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename StrictWeakOrdering>
+RandomAccessIterator3 set_operation(RandomAccessIterator1 first1,
+                                    RandomAccessIterator1 last1,
+                                    RandomAccessIterator2 first2,
+                                    RandomAccessIterator2 last2,
+                                    RandomAccessIterator3 result,
+                                    StrictWeakOrdering comp)
+{
+    typedef typename thrust::iterator_difference<RandomAccessIterator1>::type difference;
+    typedef typename thrust::iterator_value<RandomAccessIterator1>::type      value_type;
+
+    const difference n1 = last1 - first1;
+    const difference n2 = last2 - first2;
+
+    const int num_chunks = num_threads_for(n1 + n2);
+
+    if (num_chunks == 1)
+        return SetOperation::apply(first1, last1, first2, last2, result, comp);
+
+    // partition k covers [split1[k], split1[k+1]) and [split2[k], split2[k+1])
+    thrust::detail::raw_host_buffer<difference> splits(2 * (num_chunks + 1));
+    difference* split1 = &splits[0];
+    difference* split2 = split1 + num_chunks + 1;
+
+    // sizes of the partial results, then their offsets in result
+    thrust::detail::raw_host_buffer<difference> counts(num_chunks + 1);
+    difference* count = &counts[0];
+
+    // partial results are written at their capacity offsets
+    thrust::detail::raw_host_buffer<value_type> temp(SetOperation::capacity(n1, n2));
+    value_type* partials = &temp[0];
+
+    split1[0] = 0;                   split2[0] = 0;
+    split1[num_chunks] = n1;         split2[num_chunks] = n2;
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#   pragma omp parallel num_threads(num_chunks)
+    {
+        int thread_id = omp_get_thread_num();
+        int team_size = omp_get_num_threads();
+
+        // find the interior splits
+        for (int chunk = thread_id + 1; chunk < num_chunks; chunk += team_size)
+        {
+            balanced_split(first1, n1, first2, n2,
+                           chunk_begin(n1 + n2, num_chunks, chunk), comp,
+                           split1[chunk], split2[chunk]);
+        }
+
+#       pragma omp barrier
+
+        // each thread operates on its partition independently
+        for (int chunk = thread_id; chunk < num_chunks; chunk += team_size)
+        {
+            value_type* out = partials + SetOperation::capacity(split1[chunk], split2[chunk]);
+
+            value_type* end = SetOperation::apply(first1 + split1[chunk], first1 + split1[chunk + 1],
+                                                  first2 + split2[chunk], first2 + split2[chunk + 1],
+                                                  out, comp);
+
+            count[chunk] = end - out;
+        }
+
+#       pragma omp barrier
+
+#       pragma omp single
+        {
+            // exclusive scan of the partial sizes
+            difference sum = 0;
+            for (int chunk = 0; chunk <= num_chunks; ++chunk)
+            {
+                difference n = (chunk < num_chunks) ? count[chunk] : 0;
+                count[chunk] = sum;
+                sum += n;
+            }
+        } // implied barrier
+
+        // compact the partial results
+        for (int chunk = thread_id; chunk < num_chunks; chunk += team_size)
+        {
+            value_type* in  = partials + SetOperation::capacity(split1[chunk], split2[chunk]);
+            value_type* end = in + (count[chunk + 1] - count[chunk]);
+
+            RandomAccessIterator3 out = result + count[chunk];
+
+            for (; in != end; ++in, ++out)
+                thrust::detail::device::dereference(out) = *in;
+        }
+    }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+    return result + count[num_chunks];
+}
+
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename StrictWeakOrdering>
+RandomAccessIterator3 merge(RandomAccessIterator1 first1,
+                            RandomAccessIterator1 last1,
+                            RandomAccessIterator2 first2,
+                            RandomAccessIterator2 last2,
+                            RandomAccessIterator3 result,
+                            StrictWeakOrdering comp)
+{
+    typedef typename thrust::iterator_difference<RandomAccessIterator1>::type difference;
+
+    const difference n1 = last1 - first1;
+    const difference n2 = last2 - first2;
+
+    const int num_chunks = num_threads_for(n1 + n2);
+
+    if (num_chunks == 1)
+        return merge_op::apply(first1, last1, first2, last2, result, comp);
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#   pragma omp parallel num_threads(num_chunks)
+    {
+        int thread_id = omp_get_thread_num();
+        int team_size = omp_get_num_threads();
+
+        // the output of a merge partition begins at its diagonal, so the
+        // partitions are independent and no compaction is needed
+        for (int chunk = thread_id; chunk < num_chunks; chunk += team_size)
+        {
+            difference begin = chunk_begin(n1 + n2, num_chunks, chunk);
+            difference end   = chunk_end(n1 + n2, num_chunks, chunk);
+
+            difference i_begin = merge_path(first1, n1, first2, n2, begin, comp);
+            difference i_end   = merge_path(first1, n1, first2, n2, end,   comp);
+
+            merge_op::apply(first1 + i_begin, first1 + i_end,
+                            first2 + (begin - i_begin), first2 + (end - i_end),
+                            result + begin, comp);
+        }
+    }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+    return result + (n1 + n2);
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -0,0 +1,75 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file static_partition.h
+ *  \brief Static partitioning of an index range among OpenMP threads.
+ */
+
+#pragma once
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+namespace thrust {
+namespace detail {
+namespace device {
+namespace omp {
+namespace detail {
+
+// ranges smaller than this are not worth the cost of a parallel region
+const unsigned int default_grain_size = 4096;
+
+// returns the number of threads to use for a range of n elements such that
+// every thread receives at least grain_size elements
+template<typename Size>
+int num_threads_for(Size n, Size grain_size = default_grain_size) {
+    if (grain_size < 1) { grain_size = 1; }
+
+    Size max_chunks = (n + grain_size - 1) / grain_size;
+
+    int max_threads = 1;
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    max_threads = omp_get_max_threads();
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+    return (max_chunks < Size(max_threads)) ? (max_chunks < 1 ? 1 : int(max_chunks)) : max_threads;
+}
+
+// first index of chunk i when n elements are divided among num_chunks contiguous
+// chunks whose sizes differ by at most one
+template<typename Size>
+Size chunk_begin(Size n, int num_chunks, int i) {
+    Size size      = n / num_chunks;
+    Size remainder = n % num_chunks;
+    return Size(i) * size + (Size(i) < remainder ? Size(i) : remainder);
+}
+
+// one past the last index of chunk i
+template<typename Size>
+Size chunk_end(Size n, int num_chunks, int i) {
+    return chunk_begin(n, num_chunks, i + 1);
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -0,0 +1,98 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <thrust/detail/type_traits.h>
+#include <thrust/device_ptr.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/detail/device/omp/detail/contiguous_reduce.h>
+
+namespace thrust {
+
+namespace detail {
+
+namespace device {
+
+namespace omp {
+
+namespace dispatch {
+
+template<typename InputIterator, typename OutputType, typename BinaryFunction>
+OutputType reduce(InputIterator first, InputIterator last, OutputType init, BinaryFunction binary_op,
+                  thrust::detail::true_type) {
+    // InputIterator is trivial, so reduce straight from the underlying array
+    typedef typename thrust::iterator_value<InputIterator>::type InputType;
+
+    const InputType* raw_first = thrust::raw_pointer_cast(&*first);
+
+    return thrust::detail::device::omp::detail::contiguous_reduce
+           (thrust::detail::device::omp::detail::pointer_loader<InputType>(raw_first),
+            last - first, init, binary_op);
+}
+
+template<typename InputIterator, typename OutputType, typename BinaryFunction>
+OutputType reduce(InputIterator first, InputIterator last, OutputType init, BinaryFunction binary_op,
+                  thrust::detail::false_type) {
+    // InputIterator is not trivial, so dereference it element by element
+    typedef typename thrust::iterator_value<InputIterator>::type InputType;
+
+    return thrust::detail::device::omp::detail::contiguous_reduce
+           (thrust::detail::device::omp::detail::iterator_loader<InputIterator, InputType>(first),
+            last - first, init, binary_op);
+}
+
+template<typename UnaryFunction, typename Iterator, typename Reference, typename Value,
+         typename OutputType, typename BinaryFunction>
+OutputType transform_reduce(thrust::transform_iterator<UnaryFunction, Iterator, Reference, Value> first,
+                            thrust::transform_iterator<UnaryFunction, Iterator, Reference, Value> last,
+                            OutputType init, BinaryFunction binary_op,
+                            thrust::detail::true_type) {
+    // the base iterator is trivial, so apply the functor to the underlying array
+    typedef thrust::transform_iterator<UnaryFunction, Iterator, Reference, Value> TransformIterator;
+    typedef typename thrust::iterator_value<Iterator>::type                       InputType;
+    typedef typename thrust::iterator_value<TransformIterator>::type               ResultType;
+
+    const InputType* raw_first = thrust::raw_pointer_cast(&*first.base());
+
+    return thrust::detail::device::omp::detail::contiguous_reduce
+           (thrust::detail::device::omp::detail::unary_pointer_loader<InputType, UnaryFunction, ResultType>(raw_first, first.functor()),
+            last - first, init, binary_op);
+}
+
+template<typename UnaryFunction, typename Iterator, typename Reference, typename Value,
+         typename OutputType, typename BinaryFunction>
+OutputType transform_reduce(thrust::transform_iterator<UnaryFunction, Iterator, Reference, Value> first,
+                            thrust::transform_iterator<UnaryFunction, Iterator, Reference, Value> last,
+                            OutputType init, BinaryFunction binary_op,
+                            thrust::detail::false_type) {
+    // the base iterator is not trivial, so treat the transform_iterator like any other
+    return thrust::detail::device::omp::dispatch::reduce(first, last, init, binary_op,
+            thrust::detail::false_type());
+}
+
+} // end dispatch
+
+} // end omp
+
+} // end device
+
+} // end detail
+
+} // end thrust
+
@@ -20,6 +20,7 @@
 #include <thrust/device_ptr.h>
 #include <algorithm>
 #include <thrust/detail/host/sort.h>
+#include <thrust/detail/host/detail/sorting_network.h>
 
 #include <thrust/iterator/detail/forced_iterator.h> // XXX remove this we we have a proper OMP sort
 
@@ -36,6 +37,14 @@ namespace dispatch {
 template<typename RandomAccessIterator, typename StrictWeakOrdering>
 void stable_sort(RandomAccessIterator first, RandomAccessIterator last, StrictWeakOrdering comp,
                  thrust::detail::true_type) {
+    // tiny ranges are insertion sorted, which needs no temporary storage
+    if (last - first <= thrust::detail::host::detail::sorting_network_max_size) {
+        thrust::detail::host::detail::insertion_sort(thrust::raw_pointer_cast(&*first),
+                thrust::raw_pointer_cast(&*last),
+                comp);
+        return;
+    }
+
     // RandomAccessIterator is trivial, so cast to a raw pointer and use std::stable_sort
     std::stable_sort(thrust::raw_pointer_cast(&*first),
                      thrust::raw_pointer_cast(&*last),
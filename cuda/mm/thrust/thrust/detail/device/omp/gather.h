@@ -0,0 +1,43 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file gather.h
+ *  \brief OpenMP implementation of gather.
+ */
+
+#pragma once
+
+namespace thrust {
+namespace detail {
+namespace device {
+namespace omp {
+
+template < typename InputIterator,
+         typename RandomAccessIterator,
+         typename OutputIterator >
+OutputIterator gather(InputIterator        map_first,
+                      InputIterator        map_last,
+                      RandomAccessIterator input_first,
+                      OutputIterator       result);
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
+#include <thrust/detail/device/omp/gather.inl>
+
@@ -0,0 +1,112 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file gather.inl
+ *  \brief Inline file for gather.h.
+ */
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/omp/detail/prefetch.h>
+#include <thrust/detail/device/omp/detail/static_partition.h>
+#include <thrust/iterator/iterator_traits.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+
+// Each thread writes one contiguous block of the destination, so the stores
+// and the reads of the map stream through memory.  The irregular reads of the
+// input are requested THRUST_OMP_PREFETCH_DISTANCE elements before they are
+// needed.  When input_first and result are zip_iterators every component
+// array is permuted in this one pass.
+template<typename InputIterator,
+         typename RandomAccessIterator,
+         typename OutputIterator>
+OutputIterator gather(InputIterator        map_first,
+                      InputIterator        map_last,
+                      RandomAccessIterator input_first,
+                      OutputIterator       result)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to OpenMP support in your compiler.                         X
+  // ========================================================================
+  THRUST_STATIC_ASSERT( (depend_on_instantiation<InputIterator,
+                        (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+  using thrust::detail::device::dereference;
+
+  typedef typename thrust::iterator_difference<InputIterator>::type difference;
+  typedef typename thrust::iterator_value<InputIterator>::type      index_type;
+  typedef detail::element_prefetcher<RandomAccessIterator>          prefetcher;
+
+  const difference n        = map_last - map_first;
+  const difference distance = THRUST_OMP_PREFETCH_DISTANCE;
+
+  const int num_chunks = detail::num_threads_for(n);
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+# pragma omp parallel num_threads(num_chunks)
+  {
+    int thread_id = omp_get_thread_num();
+    int team_size = omp_get_num_threads();
+
+    for(int chunk = thread_id; chunk < num_chunks; chunk += team_size)
+    {
+      difference i   = detail::chunk_begin(n, num_chunks, chunk);
+      difference end = detail::chunk_end(n, num_chunks, chunk);
+
+      // the map is read through iterators which outlive the references
+      // dereference returns, e.g. for counting_iterator
+      InputIterator map_i     = map_first + i;
+      InputIterator map_ahead = map_i + distance;
+
+      for(; i + distance < end; ++i, ++map_i, ++map_ahead)
+      {
+        prefetcher::read(input_first, index_type(dereference(map_ahead)));
+        dereference(result, i) = dereference(input_first, index_type(dereference(map_i)));
+      }
+
+      for(; i < end; ++i, ++map_i)
+        dereference(result, i) = dereference(input_first, index_type(dereference(map_i)));
+    }
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+  return result + n;
+} // end gather()
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
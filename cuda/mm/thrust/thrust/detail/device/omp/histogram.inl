@@ -0,0 +1,232 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file histogram.inl
+ *  \brief Inline file for histogram.h.
+ */
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <algorithm>
+#include <thrust/detail/config.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/raw_buffer.h>
+#include <thrust/detail/histogram_bins.h>
+#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/omp/detail/static_partition.h>
+#include <thrust/iterator/iterator_traits.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+namespace detail
+{
+
+// up to this many bins every thread counts into several interleaved
+// copies of its bins, so that runs of samples falling into the same bin
+// do not serialize on one counter
+const unsigned int small_histogram_bins = 256;
+const unsigned int num_sub_histograms   = 4;
+
+// Maps a sample to the bin delimited by the sorted levels, or to
+// num_levels - 1 when it lies outside them.
+template<typename LevelType, typename Size>
+struct range_bin
+{
+  const LevelType *levels;
+  Size             num_levels;
+
+  range_bin(const LevelType *levels, Size num_levels)
+    : levels(levels), num_levels(num_levels) {}
+
+  template<typename Sample>
+  Size operator()(const Sample &x) const
+  {
+    Size level = std::upper_bound(levels, levels + num_levels, x) - levels;
+    return (level != 0 && level != num_levels) ? level - 1 : num_levels - 1;
+  } // end operator()
+}; // end range_bin
+
+// Each thread counts one contiguous chunk of the input into private bins,
+// with an extra bin for the samples bin_of maps outside, and the private
+// bins are then summed bin by bin.  The private bins of every thread are
+// padded to whole cache lines.
+template<typename InputIterator,
+         typename OutputIterator,
+         typename Size,
+         typename BinFunction>
+OutputIterator privatized_histogram(InputIterator first,
+                                    InputIterator last,
+                                    OutputIterator output,
+                                    Size num_bins,
+                                    BinFunction bin_of)
+{
+  using thrust::detail::device::dereference;
+
+  typedef typename thrust::iterator_value<OutputIterator>::type       CountType;
+  typedef typename thrust::iterator_difference<InputIterator>::type   difference;
+
+  const difference n = last - first;
+
+  const int num_chunks = num_threads_for(n);
+
+  const Size num_copies = (num_bins <= Size(small_histogram_bins)) ? Size(num_sub_histograms) : Size(1);
+  const Size copy_size  = num_bins + 1;
+
+  const Size line_size  = (64 / sizeof(CountType) > 0) ? Size(64 / sizeof(CountType)) : Size(1);
+  const Size chunk_size = (num_copies * copy_size + line_size - 1) / line_size * line_size;
+
+  thrust::detail::raw_host_buffer<CountType> private_bins(num_chunks * chunk_size);
+  CountType *bins = &private_bins[0];
+
+  // the bins are summed with one thread per range of bins
+  const int num_sum_chunks = std::min<int>(num_chunks, num_threads_for(num_bins, Size(small_histogram_bins)));
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+# pragma omp parallel num_threads(num_chunks)
+  {
+    int thread_id = omp_get_thread_num();
+    int team_size = omp_get_num_threads();
+
+    for(int chunk = thread_id; chunk < num_chunks; chunk += team_size)
+    {
+      CountType *local = bins + chunk * chunk_size;
+      std::fill(local, local + chunk_size, CountType(0));
+
+      // with one copy all four pointers alias the same bins
+      CountType *h0 = local;
+      CountType *h1 = local + (1 % num_copies) * copy_size;
+      CountType *h2 = local + (2 % num_copies) * copy_size;
+      CountType *h3 = local + (3 % num_copies) * copy_size;
+
+      difference i   = chunk_begin(n, num_chunks, chunk);
+      difference end = chunk_end(n, num_chunks, chunk);
+
+      for(; i + 4 <= end; i += 4)
+      {
+        Size b0 = bin_of(dereference(first, i + 0));
+        Size b1 = bin_of(dereference(first, i + 1));
+        Size b2 = bin_of(dereference(first, i + 2));
+        Size b3 = bin_of(dereference(first, i + 3));
+
+        ++h0[b0];
+        ++h1[b1];
+        ++h2[b2];
+        ++h3[b3];
+      }
+
+      for(; i < end; ++i)
+        ++h0[bin_of(dereference(first, i))];
+    }
+
+#   pragma omp barrier
+
+    for(int chunk = thread_id; chunk < num_sum_chunks; chunk += team_size)
+    {
+      Size begin = chunk_begin(num_bins, num_sum_chunks, chunk);
+      Size end   = chunk_end(num_bins, num_sum_chunks, chunk);
+
+      for(Size bin = begin; bin < end; ++bin)
+      {
+        CountType sum = 0;
+
+        for(int c = 0; c < num_chunks; ++c)
+          for(Size copy = 0; copy < num_copies; ++copy)
+            sum += bins[c * chunk_size + copy * copy_size + bin];
+
+        dereference(output, bin) = sum;
+      }
+    }
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+  return output + num_bins;
+} // end privatized_histogram()
+
+} // end namespace detail
+
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename Size,
+         typename T>
+OutputIterator histogram_even(InputIterator first,
+                              InputIterator last,
+                              OutputIterator output,
+                              Size num_bins,
+                              T lower,
+                              T upper)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to OpenMP support in your compiler.                         X
+  // ========================================================================
+  THRUST_STATIC_ASSERT( (depend_on_instantiation<InputIterator,
+                        (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+  typedef typename thrust::iterator_difference<InputIterator>::type difference;
+
+  if(num_bins <= 0)
+    return output;
+
+  return detail::privatized_histogram(first, last, output, difference(num_bins),
+                                      thrust::detail::even_bin<T,difference>(lower, upper, num_bins));
+} // end histogram_even()
+
+template<typename InputIterator,
+         typename ForwardIterator,
+         typename OutputIterator>
+OutputIterator histogram_range(InputIterator first,
+                               InputIterator last,
+                               ForwardIterator levels_first,
+                               ForwardIterator levels_last,
+                               OutputIterator output)
+{
+  THRUST_STATIC_ASSERT( (depend_on_instantiation<InputIterator,
+                        (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+  typedef typename thrust::iterator_value<ForwardIterator>::type      LevelType;
+  typedef typename thrust::iterator_difference<InputIterator>::type   difference;
+
+  // the levels are few and searched by every sample, so keep them in a plain array
+  thrust::detail::raw_host_buffer<LevelType> levels(levels_first, levels_last);
+
+  const difference num_levels = levels.size();
+
+  if(num_levels < 2)
+    return output;
+
+  return detail::privatized_histogram(first, last, output, num_levels - 1,
+                                      detail::range_bin<LevelType,difference>(&levels[0], num_levels));
+} // end histogram_range()
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -0,0 +1,99 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/device_ptr.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/device/generic/inner_product.h>
+#include <thrust/detail/device/omp/detail/contiguous_reduce.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+namespace detail
+{
+
+// both inputs are trivial: fuse binary_op2 into the contiguous reduction
+template <typename InputIterator1, typename InputIterator2, typename OutputType,
+          typename BinaryFunction1, typename BinaryFunction2>
+OutputType inner_product(InputIterator1 first1, InputIterator1 last1,
+                         InputIterator2 first2, OutputType init,
+                         BinaryFunction1 binary_op1, BinaryFunction2 binary_op2,
+                         thrust::detail::true_type)
+{
+    typedef typename thrust::iterator_value<InputIterator1>::type InputType1;
+    typedef typename thrust::iterator_value<InputIterator2>::type InputType2;
+
+    if (first1 == last1)
+        return init;
+
+    const InputType1* raw_first1 = thrust::raw_pointer_cast(&*first1);
+    const InputType2* raw_first2 = thrust::raw_pointer_cast(&*first2);
+
+    return contiguous_reduce
+           (binary_pointer_loader<InputType1, InputType2, BinaryFunction2, OutputType>(raw_first1, raw_first2, binary_op2),
+            last1 - first1, init, binary_op1);
+}
+
+// otherwise reduce over a zip of the inputs
+template <typename InputIterator1, typename InputIterator2, typename OutputType,
+          typename BinaryFunction1, typename BinaryFunction2>
+OutputType inner_product(InputIterator1 first1, InputIterator1 last1,
+                         InputIterator2 first2, OutputType init,
+                         BinaryFunction1 binary_op1, BinaryFunction2 binary_op2,
+                         thrust::detail::false_type)
+{
+    return thrust::detail::device::generic::inner_product(first1, last1, first2, init, binary_op1, binary_op2);
+}
+
+} // end namespace detail
+
+
+template <typename InputIterator1, typename InputIterator2, typename OutputType,
+          typename BinaryFunction1, typename BinaryFunction2>
+OutputType
+inner_product(InputIterator1 first1, InputIterator1 last1,
+              InputIterator2 first2, OutputType init,
+              BinaryFunction1 binary_op1, BinaryFunction2 binary_op2)
+{
+    // we're attempting to launch an omp kernel, assert we're compiling with omp support
+    // ========================================================================
+    // X Note to the user: If you've found this line due to a compiler error, X
+    // X you need to OpenMP support in your compiler.                         X
+    // ========================================================================
+    THRUST_STATIC_ASSERT( (depend_on_instantiation<InputIterator1,
+                          (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+    // dispatch on the trivialness of both iterators
+    return detail::inner_product(first1, last1, first2, init, binary_op1, binary_op2,
+            thrust::detail::integral_constant<bool,
+                thrust::detail::is_trivial_iterator<InputIterator1>::value &&
+                thrust::detail::is_trivial_iterator<InputIterator2>::value>());
+}
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
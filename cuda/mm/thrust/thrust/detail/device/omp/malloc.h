@@ -0,0 +1,49 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file malloc.h
+ *  \brief OpenMP implementation of device malloc.
+ */
+
+#pragma once
+
+#include <thrust/device_ptr.h>
+#include <thrust/detail/memory_pool.h>
+
+namespace thrust {
+
+namespace detail {
+
+namespace device {
+
+namespace omp {
+
+// OpenMP device memory is host memory, so draw it from the host cache
+template<unsigned int DummyParameterToAvoidInstantiation>
+thrust::device_ptr<void> malloc(const std::size_t n) {
+    return thrust::device_ptr<void>(thrust::detail::memory_pool::instance().allocate(n));
+} // end malloc()
+
+} // end namespace omp
+
+} // end namespace device
+
+} // end namespace detail
+
+} // end namespace thrust
+
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <thrust/iterator/transform_iterator.h>
 
 namespace thrust {
 namespace detail {
@@ -35,6 +36,19 @@ OutputType reduce(InputIterator first,
                   OutputType init,
                   BinaryFunction binary_op);
 
+// transform_reduce arrives here as a reduction over a transform_iterator;
+// unwrap it so a trivial base iterator can take the contiguous path
+template < typename UnaryFunction,
+         typename Iterator,
+         typename Reference,
+         typename Value,
+         typename OutputType,
+         typename BinaryFunction >
+OutputType reduce(thrust::transform_iterator<UnaryFunction, Iterator, Reference, Value> first,
+                  thrust::transform_iterator<UnaryFunction, Iterator, Reference, Value> last,
+                  OutputType init,
+                  BinaryFunction binary_op);
+
 } // end namespace omp
 } // end namespace device
 } // end namespace detail
@@ -14,15 +14,11 @@
  *  limitations under the License.
  */
 
-// don't attempt to #include this file without omp support
-#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-#include <omp.h>
-#endif // omp support
 
+#include <thrust/detail/config.h>
+#include <thrust/detail/static_assert.h>
 #include <thrust/iterator/iterator_traits.h>
-#include <thrust/distance.h>
-#include <thrust/detail/raw_buffer.h>
-#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/omp/dispatch/reduce.h>
 
 namespace thrust
 {
@@ -33,6 +29,10 @@ namespace device
 namespace omp
 {
 
+// Each thread reduces one contiguous chunk of the input with several
+// independent accumulators and the per-thread partials are combined with
+// a tree.  init is folded in exactly once, so it need not be an identity
+// of binary_op.
 template <typename InputIterator,
           typename OutputType,
           typename BinaryFunction>
@@ -49,49 +49,34 @@ OutputType reduce(InputIterator first,
     THRUST_STATIC_ASSERT( (depend_on_instantiation<InputIterator,
                           (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
 
-    typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
-
     if (first == last)
         return init;
 
-    difference_type N = thrust::distance(first, last);
-
-// do not attempt to compile the body of this function, which calls omp functions, without
-// support from the compiler
-// XXX implement the body of this function in another file to eliminate this ugliness
-#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-    int num_threads = std::min<difference_type>(omp_get_max_threads(), N);
-
-    thrust::detail::raw_omp_device_buffer<OutputType> thread_results(first, first + num_threads);
-
-#   pragma omp parallel num_threads(num_threads)
-    {
-
-        int thread_id = omp_get_thread_num();
-
-        OutputType thread_sum = thread_results[thread_id];
-
-#      pragma omp for 
-        for (difference_type i = num_threads; i < N; i++)
-        {
-            InputIterator temp = first + i;
-            thread_sum = binary_op(thread_sum, thrust::detail::device::dereference(temp));
-        }
-
-        thread_results[thread_id] = thread_sum;
-    }
-#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+    // dispatch on the trivialness of the iterator
+    return thrust::detail::device::omp::dispatch::reduce(first, last, init, binary_op,
+            thrust::detail::is_trivial_iterator<InputIterator>());
+}
 
-    OutputType total_sum = init;
+template <typename UnaryFunction,
+          typename Iterator,
+          typename Reference,
+          typename Value,
+          typename OutputType,
+          typename BinaryFunction>
+OutputType reduce(thrust::transform_iterator<UnaryFunction, Iterator, Reference, Value> first,
+                  thrust::transform_iterator<UnaryFunction, Iterator, Reference, Value> last,
+                  OutputType init,
+                  BinaryFunction binary_op)
+{
+    THRUST_STATIC_ASSERT( (depend_on_instantiation<Iterator,
+                          (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
 
-#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-    for (typename thrust::detail::raw_omp_device_buffer<OutputType>::iterator result = thread_results.begin();
-         result != thread_results.end();
-         ++result)
-        total_sum = binary_op(total_sum, thrust::detail::device::dereference(result));
-#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+    if (first == last)
+        return init;
 
-    return total_sum;
+    // dispatch on the trivialness of the base iterator
+    return thrust::detail::device::omp::dispatch::transform_reduce(first, last, init, binary_op,
+            thrust::detail::is_trivial_iterator<Iterator>());
 }
 
 } // end namespace omp
@@ -0,0 +1,219 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file reduce_by_key.inl
+ *  \brief Inline file for reduce_by_key.h.
+ */
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/raw_buffer.h>
+#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/omp/detail/segment_head.h>
+#include <thrust/detail/device/omp/detail/static_partition.h>
+#include <thrust/iterator/iterator_traits.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+
+// Each thread counts the segment heads in one contiguous chunk, and an
+// exclusive scan of the counts gives the output slot of every chunk's
+// first segment.  Threads then reduce their chunks, writing every segment
+// which closes inside the chunk.  The last segment of a chunk may stay
+// open; it is completed by folding in the sums of the following chunks up
+// to and including the leading part of the next chunk with a head.
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+thrust::pair<OutputIterator1, OutputIterator2>
+reduce_by_key(InputIterator1 keys_first,
+              InputIterator1 keys_last,
+              InputIterator2 values_first,
+              OutputIterator1 keys_output,
+              OutputIterator2 values_output,
+              BinaryPredicate binary_pred,
+              BinaryFunction binary_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to OpenMP support in your compiler.                         X
+  // ========================================================================
+  THRUST_STATIC_ASSERT( (depend_on_instantiation<InputIterator1,
+                        (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+  using thrust::detail::device::dereference;
+
+  typedef typename thrust::iterator_value<OutputIterator2>::type       ValueType;
+  typedef typename thrust::iterator_difference<InputIterator1>::type   difference;
+
+  const difference n = keys_last - keys_first;
+
+  if(n <= 0)
+    return thrust::make_pair(keys_output, values_output);
+
+  const int num_chunks = detail::num_threads_for(n);
+
+  // number of heads in each chunk, then the output slot of its first segment
+  thrust::detail::raw_host_buffer<difference> chunk_counts(num_chunks + 1);
+  difference *counts = &chunk_counts[0];
+
+  // sum of the elements before the first head of each chunk, and the
+  // partial sum of the segment left open at the end of each chunk
+  thrust::detail::raw_host_buffer<ValueType> chunk_leads(num_chunks);
+  thrust::detail::raw_host_buffer<ValueType> chunk_tails(num_chunks);
+  ValueType *leads = &chunk_leads[0];
+  ValueType *tails = &chunk_tails[0];
+
+  // whether leads[chunk] holds a value
+  thrust::detail::raw_host_buffer<unsigned char> chunk_has_lead(num_chunks);
+  unsigned char *has_lead = &chunk_has_lead[0];
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+# pragma omp parallel num_threads(num_chunks)
+  {
+    int thread_id = omp_get_thread_num();
+    int team_size = omp_get_num_threads();
+
+    // phase 1: count the heads of each chunk
+    for(int chunk = thread_id; chunk < num_chunks; chunk += team_size)
+    {
+      difference begin = detail::chunk_begin(n, num_chunks, chunk);
+      difference end   = detail::chunk_end(n, num_chunks, chunk);
+
+      difference count = 0;
+      for(difference i = begin; i < end; ++i)
+        count += detail::is_segment_head(keys_first, i, binary_pred);
+
+      counts[chunk] = count;
+    }
+
+#   pragma omp barrier
+
+#   pragma omp single
+    {
+      // exclusive scan of the head counts
+      difference sum = 0;
+      for(int chunk = 0; chunk <= num_chunks; ++chunk)
+      {
+        difference count = (chunk < num_chunks) ? counts[chunk] : 0;
+        counts[chunk] = sum;
+        sum += count;
+      }
+    } // implied barrier
+
+    // phase 2: reduce each chunk, writing the segments which close inside it
+    for(int chunk = thread_id; chunk < num_chunks; chunk += team_size)
+    {
+      difference begin = detail::chunk_begin(n, num_chunks, chunk);
+      difference end   = detail::chunk_end(n, num_chunks, chunk);
+
+      InputIterator2 value = values_first + begin;
+
+      difference i = begin;
+
+      // the leading elements continue a segment begun in an earlier chunk
+      has_lead[chunk] = !detail::is_segment_head(keys_first, i, binary_pred);
+
+      if(has_lead[chunk])
+      {
+        ValueType sum = dereference(value);
+
+        for(++i, ++value; i < end && !detail::is_segment_head(keys_first, i, binary_pred); ++i, ++value)
+          sum = binary_op(sum, dereference(value));
+
+        leads[chunk] = sum;
+      }
+
+      difference slot = counts[chunk];
+
+      while(i < end)
+      {
+        // i is a segment head
+        InputIterator1 key = keys_first + i;
+        OutputIterator1 key_out = keys_output + slot;
+        dereference(key_out) = dereference(key);
+
+        ValueType sum = dereference(value);
+
+        for(++i, ++value; i < end && !detail::is_segment_head(keys_first, i, binary_pred); ++i, ++value)
+          sum = binary_op(sum, dereference(value));
+
+        if(i < end)
+        {
+          OutputIterator2 value_out = values_output + slot;
+          dereference(value_out) = sum;
+          ++slot;
+        }
+        else
+        {
+          tails[chunk] = sum;
+        }
+      }
+    }
+
+#   pragma omp barrier
+
+    // phase 3: complete the segment left open at the end of each chunk
+    for(int chunk = thread_id; chunk < num_chunks; chunk += team_size)
+    {
+      if(counts[chunk] == counts[chunk + 1])
+        continue;
+
+      ValueType sum = tails[chunk];
+
+      int next = chunk + 1;
+
+      // chunks without a head lie entirely inside the open segment
+      for(; next < num_chunks && counts[next] == counts[next + 1]; ++next)
+        sum = binary_op(sum, leads[next]);
+
+      if(next < num_chunks && has_lead[next])
+        sum = binary_op(sum, leads[next]);
+
+      OutputIterator2 value_out = values_output + (counts[chunk + 1] - 1);
+      dereference(value_out) = sum;
+    }
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+  const difference num_segments = counts[num_chunks];
+
+  return thrust::make_pair(keys_output + num_segments, values_output + num_segments);
+} // end reduce_by_key()
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
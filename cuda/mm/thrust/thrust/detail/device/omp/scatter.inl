@@ -0,0 +1,111 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file scatter.inl
+ *  \brief Inline file for scatter.h.
+ */
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/omp/detail/prefetch.h>
+#include <thrust/detail/device/omp/detail/static_partition.h>
+#include <thrust/iterator/iterator_traits.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+
+// Each thread reads one contiguous block of the input and the map.  The
+// cache lines of the output each element lands in are requested for writing
+// THRUST_OMP_PREFETCH_DISTANCE elements before the store.  When first and
+// output are zip_iterators every component array is permuted in this one
+// pass.
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename RandomAccessIterator>
+void scatter(InputIterator1 first,
+             InputIterator1 last,
+             InputIterator2 map,
+             RandomAccessIterator output)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to OpenMP support in your compiler.                         X
+  // ========================================================================
+  THRUST_STATIC_ASSERT( (depend_on_instantiation<InputIterator1,
+                        (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+  using thrust::detail::device::dereference;
+
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference;
+  typedef typename thrust::iterator_value<InputIterator2>::type      index_type;
+  typedef detail::element_prefetcher<RandomAccessIterator>           prefetcher;
+
+  const difference n        = last - first;
+  const difference distance = THRUST_OMP_PREFETCH_DISTANCE;
+
+  const int num_chunks = detail::num_threads_for(n);
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+# pragma omp parallel num_threads(num_chunks)
+  {
+    int thread_id = omp_get_thread_num();
+    int team_size = omp_get_num_threads();
+
+    for(int chunk = thread_id; chunk < num_chunks; chunk += team_size)
+    {
+      difference i   = detail::chunk_begin(n, num_chunks, chunk);
+      difference end = detail::chunk_end(n, num_chunks, chunk);
+
+      // the input and map are read through iterators which outlive the
+      // references dereference returns, e.g. for counting_iterator
+      InputIterator1 first_i   = first + i;
+      InputIterator2 map_i     = map + i;
+      InputIterator2 map_ahead = map_i + distance;
+
+      for(; i + distance < end; ++i, ++first_i, ++map_i, ++map_ahead)
+      {
+        prefetcher::write(output, index_type(dereference(map_ahead)));
+        dereference(output, index_type(dereference(map_i))) = dereference(first_i);
+      }
+
+      for(; i < end; ++i, ++first_i, ++map_i)
+        dereference(output, index_type(dereference(map_i))) = dereference(first_i);
+    }
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+} // end scatter()
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -0,0 +1,309 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file segmented_scan.inl
+ *  \brief Inline file for segmented_scan.h.
+ */
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/raw_buffer.h>
+#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/omp/detail/segment_head.h>
+#include <thrust/detail/device/omp/detail/static_partition.h>
+#include <thrust/iterator/iterator_traits.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+
+// Both scans are two-phase.  Each thread scans one contiguous chunk as if
+// it were the whole input and records the running value at its end and
+// whether a segment begins inside it.  A serial pass over the chunks then
+// computes the carry of the segment left open at each chunk boundary, and
+// each thread folds its carry into the elements of its chunk which precede
+// the chunk's first segment head.
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename AssociativeOperator,
+         typename BinaryPredicate>
+OutputIterator inclusive_segmented_scan(InputIterator1 first1,
+                                        InputIterator1 last1,
+                                        InputIterator2 first2,
+                                        OutputIterator result,
+                                        AssociativeOperator binary_op,
+                                        BinaryPredicate pred)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to OpenMP support in your compiler.                         X
+  // ========================================================================
+  THRUST_STATIC_ASSERT( (depend_on_instantiation<InputIterator1,
+                        (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+  using thrust::detail::device::dereference;
+
+  typedef typename thrust::iterator_value<OutputIterator>::type        OutputType;
+  typedef typename thrust::iterator_difference<InputIterator1>::type   difference;
+
+  const difference n = last1 - first1;
+
+  if(n <= 0)
+    return result;
+
+  const int num_chunks = detail::num_threads_for(n);
+
+  // running value at the end of each chunk, and whether a segment begins in it
+  thrust::detail::raw_host_buffer<OutputType>    chunk_sums(num_chunks);
+  thrust::detail::raw_host_buffer<unsigned char> chunk_heads(num_chunks);
+  OutputType    *sums  = &chunk_sums[0];
+  unsigned char *heads = &chunk_heads[0];
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+# pragma omp parallel num_threads(num_chunks)
+  {
+    int thread_id = omp_get_thread_num();
+    int team_size = omp_get_num_threads();
+
+    // phase 1: scan each chunk independently
+    for(int chunk = thread_id; chunk < num_chunks; chunk += team_size)
+    {
+      difference begin = detail::chunk_begin(n, num_chunks, chunk);
+      difference end   = detail::chunk_end(n, num_chunks, chunk);
+
+      bool has_head = false;
+
+      InputIterator1 in  = first1 + begin;
+      OutputIterator out = result + begin;
+
+      OutputType sum = dereference(in);
+      dereference(out) = sum;
+
+      if(detail::is_segment_head(first2, begin, pred))
+        has_head = true;
+
+      for(difference i = begin + 1; i < end; ++i)
+      {
+        ++in; ++out;
+
+        if(detail::is_segment_head(first2, i, pred))
+        {
+          has_head = true;
+          sum = dereference(in);
+        }
+        else
+        {
+          sum = binary_op(sum, dereference(in));
+        }
+
+        dereference(out) = sum;
+      }
+
+      sums[chunk]  = sum;
+      heads[chunk] = has_head;
+    }
+
+#   pragma omp barrier
+
+    // phase 2: replace each chunk's sum with the carry into the next chunk
+#   pragma omp single
+    {
+      for(int chunk = 1; chunk < num_chunks; ++chunk)
+      {
+        if(!heads[chunk])
+          sums[chunk] = binary_op(sums[chunk - 1], sums[chunk]);
+      }
+    } // implied barrier
+
+    // phase 3: fold the carry into the leading open segment of each chunk
+    for(int chunk = thread_id; chunk < num_chunks; chunk += team_size)
+    {
+      if(chunk == 0)
+        continue;
+
+      difference begin = detail::chunk_begin(n, num_chunks, chunk);
+      difference end   = detail::chunk_end(n, num_chunks, chunk);
+
+      const OutputType carry = sums[chunk - 1];
+
+      OutputIterator out = result + begin;
+
+      for(difference i = begin; i < end && !detail::is_segment_head(first2, i, pred); ++i, ++out)
+        dereference(out) = binary_op(carry, dereference(out));
+    }
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+  return result + n;
+} // end inclusive_segmented_scan()
+
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename T,
+         typename AssociativeOperator,
+         typename BinaryPredicate>
+OutputIterator exclusive_segmented_scan(InputIterator1 first1,
+                                        InputIterator1 last1,
+                                        InputIterator2 first2,
+                                        OutputIterator result,
+                                        const T init,
+                                        AssociativeOperator binary_op,
+                                        BinaryPredicate pred)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to OpenMP support in your compiler.                         X
+  // ========================================================================
+  THRUST_STATIC_ASSERT( (depend_on_instantiation<InputIterator1,
+                        (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+  using thrust::detail::device::dereference;
+
+  typedef typename thrust::iterator_value<OutputIterator>::type        OutputType;
+  typedef typename thrust::iterator_difference<InputIterator1>::type   difference;
+
+  const difference n = last1 - first1;
+
+  if(n <= 0)
+    return result;
+
+  const int num_chunks = detail::num_threads_for(n);
+
+  // running value after the last element of each chunk, and whether a segment begins in it
+  thrust::detail::raw_host_buffer<OutputType>    chunk_sums(num_chunks);
+  thrust::detail::raw_host_buffer<unsigned char> chunk_heads(num_chunks);
+  OutputType    *sums  = &chunk_sums[0];
+  unsigned char *heads = &chunk_heads[0];
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+# pragma omp parallel num_threads(num_chunks)
+  {
+    int thread_id = omp_get_thread_num();
+    int team_size = omp_get_num_threads();
+
+    // phase 1: scan each chunk independently.  until the chunk's first head
+    // the running value lacks the carry, so the first element of a chunk
+    // which does not begin a segment is left for phase 3
+    for(int chunk = thread_id; chunk < num_chunks; chunk += team_size)
+    {
+      difference begin = detail::chunk_begin(n, num_chunks, chunk);
+      difference end   = detail::chunk_end(n, num_chunks, chunk);
+
+      bool has_head = false;
+
+      InputIterator1 in  = first1 + begin;
+      OutputIterator out = result + begin;
+
+      OutputType sum;
+
+      if(detail::is_segment_head(first2, begin, pred))
+      {
+        has_head = true;
+        sum = binary_op(OutputType(init), dereference(in));
+        dereference(out) = init;
+      }
+      else
+      {
+        sum = dereference(in);
+      }
+
+      for(difference i = begin + 1; i < end; ++i)
+      {
+        ++in; ++out;
+
+        // read before writing so that result may alias first1
+        if(detail::is_segment_head(first2, i, pred))
+        {
+          has_head = true;
+          OutputType next = binary_op(OutputType(init), dereference(in));
+          dereference(out) = init;
+          sum = next;
+        }
+        else
+        {
+          OutputType next = binary_op(sum, dereference(in));
+          dereference(out) = sum;
+          sum = next;
+        }
+      }
+
+      sums[chunk]  = sum;
+      heads[chunk] = has_head;
+    }
+
+#   pragma omp barrier
+
+    // phase 2: replace each chunk's sum with the carry into the next chunk
+#   pragma omp single
+    {
+      for(int chunk = 1; chunk < num_chunks; ++chunk)
+      {
+        if(!heads[chunk])
+          sums[chunk] = binary_op(sums[chunk - 1], sums[chunk]);
+      }
+    } // implied barrier
+
+    // phase 3: fold the carry into the leading open segment of each chunk
+    for(int chunk = thread_id; chunk < num_chunks; chunk += team_size)
+    {
+      difference begin = detail::chunk_begin(n, num_chunks, chunk);
+      difference end   = detail::chunk_end(n, num_chunks, chunk);
+
+      if(detail::is_segment_head(first2, begin, pred))
+        continue;
+
+      const OutputType carry = sums[chunk - 1];
+
+      OutputIterator out = result + begin;
+      dereference(out) = carry;
+
+      ++out;
+
+      for(difference i = begin + 1; i < end && !detail::is_segment_head(first2, i, pred); ++i, ++out)
+        dereference(out) = binary_op(carry, dereference(out));
+    }
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+  return result + n;
+} // end exclusive_segmented_scan()
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
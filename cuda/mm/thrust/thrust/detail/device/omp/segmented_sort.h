@@ -0,0 +1,57 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file segmented_sort.h
+ *  \brief OpenMP implementation of segmented_sort and segmented_sort_by_key.
+ */
+
+#pragma once
+
+namespace thrust {
+namespace detail {
+namespace device {
+namespace omp {
+
+template < typename RandomAccessIterator,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename StrictWeakOrdering >
+void segmented_sort(RandomAccessIterator keys_first,
+                    InputIterator1 begin_offsets_first,
+                    InputIterator1 begin_offsets_last,
+                    InputIterator2 end_offsets_first,
+                    StrictWeakOrdering comp);
+
+template < typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename StrictWeakOrdering >
+void segmented_sort_by_key(RandomAccessIterator1 keys_first,
+                           RandomAccessIterator2 values_first,
+                           InputIterator1 begin_offsets_first,
+                           InputIterator1 begin_offsets_last,
+                           InputIterator2 end_offsets_first,
+                           StrictWeakOrdering comp);
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
+#include <thrust/detail/device/omp/segmented_sort.inl>
+
@@ -0,0 +1,274 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file segmented_sort.inl
+ *  \brief Inline file for segmented_sort.h.
+ */
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/device_ptr.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/generic/segmented_sort.h>
+#include <thrust/detail/device/omp/detail/static_partition.h>
+#include <thrust/detail/host/segmented_sort.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace omp
+{
+namespace detail
+{
+
+// segments are handed to threads in contiguous runs of at least this many
+const unsigned int segment_grain_size = 256;
+
+// Sorts the segments of the raw keys, splitting the segments evenly among
+// the threads.  Each segment is sorted serially by the host's segment sort,
+// so segments of up to 32 keys go through a sorting network.
+template<typename KeyType,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename StrictWeakOrdering>
+void segmented_sort(KeyType *keys,
+                    InputIterator1 begin_offsets_first,
+                    InputIterator1 begin_offsets_last,
+                    InputIterator2 end_offsets_first,
+                    StrictWeakOrdering comp)
+{
+  using thrust::detail::device::dereference;
+
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference;
+
+  const difference m = begin_offsets_last - begin_offsets_first;
+
+  const int num_chunks = num_threads_for(m, difference(segment_grain_size));
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+# pragma omp parallel num_threads(num_chunks)
+  {
+    int thread_id = omp_get_thread_num();
+    int team_size = omp_get_num_threads();
+
+    for(int chunk = thread_id; chunk < num_chunks; chunk += team_size)
+    {
+      difference s   = chunk_begin(m, num_chunks, chunk);
+      difference end = chunk_end(m, num_chunks, chunk);
+
+      InputIterator1 begin_offset = begin_offsets_first + s;
+      InputIterator2 end_offset   = end_offsets_first + s;
+
+      for(; s < end; ++s, ++begin_offset, ++end_offset)
+      {
+        thrust::detail::host::detail::sort_segment(keys + dereference(begin_offset),
+                                                   keys + dereference(end_offset),
+                                                   comp);
+      }
+    }
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+} // end segmented_sort()
+
+template<typename KeyType,
+         typename ValueType,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename StrictWeakOrdering>
+void segmented_sort_by_key(KeyType *keys,
+                           ValueType *values,
+                           InputIterator1 begin_offsets_first,
+                           InputIterator1 begin_offsets_last,
+                           InputIterator2 end_offsets_first,
+                           StrictWeakOrdering comp)
+{
+  using thrust::detail::device::dereference;
+
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference;
+
+  const difference m = begin_offsets_last - begin_offsets_first;
+
+  const int num_chunks = num_threads_for(m, difference(segment_grain_size));
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+# pragma omp parallel num_threads(num_chunks)
+  {
+    int thread_id = omp_get_thread_num();
+    int team_size = omp_get_num_threads();
+
+    for(int chunk = thread_id; chunk < num_chunks; chunk += team_size)
+    {
+      difference s   = chunk_begin(m, num_chunks, chunk);
+      difference end = chunk_end(m, num_chunks, chunk);
+
+      InputIterator1 begin_offset = begin_offsets_first + s;
+      InputIterator2 end_offset   = end_offsets_first + s;
+
+      for(; s < end; ++s, ++begin_offset, ++end_offset)
+      {
+        difference first = dereference(begin_offset);
+        difference last  = dereference(end_offset);
+
+        thrust::detail::host::detail::sort_segment_by_key(keys + first,
+                                                          keys + last,
+                                                          values + first,
+                                                          comp);
+      }
+    }
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+} // end segmented_sort_by_key()
+
+template<typename RandomAccessIterator,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename StrictWeakOrdering>
+void segmented_sort(RandomAccessIterator keys_first,
+                    InputIterator1 begin_offsets_first,
+                    InputIterator1 begin_offsets_last,
+                    InputIterator2 end_offsets_first,
+                    StrictWeakOrdering comp,
+                    thrust::detail::true_type)
+{
+  // the keys are trivial, so sort through a raw pointer
+  detail::segmented_sort(thrust::raw_pointer_cast(&*keys_first), begin_offsets_first, begin_offsets_last, end_offsets_first, comp);
+} // end segmented_sort()
+
+template<typename RandomAccessIterator,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename StrictWeakOrdering>
+void segmented_sort(RandomAccessIterator keys_first,
+                    InputIterator1 begin_offsets_first,
+                    InputIterator1 begin_offsets_last,
+                    InputIterator2 end_offsets_first,
+                    StrictWeakOrdering comp,
+                    thrust::detail::false_type)
+{
+  // use the generic implementation for other iterators
+  thrust::detail::device::generic::segmented_sort(keys_first, begin_offsets_first, begin_offsets_last, end_offsets_first, comp);
+} // end segmented_sort()
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename StrictWeakOrdering>
+void segmented_sort_by_key(RandomAccessIterator1 keys_first,
+                           RandomAccessIterator2 values_first,
+                           InputIterator1 begin_offsets_first,
+                           InputIterator1 begin_offsets_last,
+                           InputIterator2 end_offsets_first,
+                           StrictWeakOrdering comp,
+                           thrust::detail::true_type)
+{
+  // the keys and values are trivial, so sort through raw pointers
+  detail::segmented_sort_by_key(thrust::raw_pointer_cast(&*keys_first), thrust::raw_pointer_cast(&*values_first),
+                                begin_offsets_first, begin_offsets_last, end_offsets_first, comp);
+} // end segmented_sort_by_key()
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename StrictWeakOrdering>
+void segmented_sort_by_key(RandomAccessIterator1 keys_first,
+                           RandomAccessIterator2 values_first,
+                           InputIterator1 begin_offsets_first,
+                           InputIterator1 begin_offsets_last,
+                           InputIterator2 end_offsets_first,
+                           StrictWeakOrdering comp,
+                           thrust::detail::false_type)
+{
+  // use the generic implementation for other iterators
+  thrust::detail::device::generic::segmented_sort_by_key(keys_first, values_first, begin_offsets_first, begin_offsets_last, end_offsets_first, comp);
+} // end segmented_sort_by_key()
+
+} // end namespace detail
+
+
+template<typename RandomAccessIterator,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename StrictWeakOrdering>
+void segmented_sort(RandomAccessIterator keys_first,
+                    InputIterator1 begin_offsets_first,
+                    InputIterator1 begin_offsets_last,
+                    InputIterator2 end_offsets_first,
+                    StrictWeakOrdering comp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to OpenMP support in your compiler.                         X
+  // ========================================================================
+  THRUST_STATIC_ASSERT( (depend_on_instantiation<RandomAccessIterator,
+                        (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+  // dispatch on the trivialness of the iterator
+  detail::segmented_sort(keys_first, begin_offsets_first, begin_offsets_last, end_offsets_first, comp,
+                         thrust::detail::is_trivial_iterator<RandomAccessIterator>());
+} // end segmented_sort()
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename StrictWeakOrdering>
+void segmented_sort_by_key(RandomAccessIterator1 keys_first,
+                           RandomAccessIterator2 values_first,
+                           InputIterator1 begin_offsets_first,
+                           InputIterator1 begin_offsets_last,
+                           InputIterator2 end_offsets_first,
+                           StrictWeakOrdering comp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to OpenMP support in your compiler.                         X
+  // ========================================================================
+  THRUST_STATIC_ASSERT( (depend_on_instantiation<RandomAccessIterator1,
+                        (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value) );
+
+  typedef thrust::detail::integral_constant<bool,
+    thrust::detail::is_trivial_iterator<RandomAccessIterator1>::value &&
+    thrust::detail::is_trivial_iterator<RandomAccessIterator2>::value> trivial_iterators;
+
+  // dispatch on the trivialness of the iterators
+  detail::segmented_sort_by_key(keys_first, values_first, begin_offsets_first, begin_offsets_last, end_offsets_first, comp,
+                                trivial_iterators());
+} // end segmented_sort_by_key()
+
+} // end namespace omp
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -22,7 +22,7 @@
 #pragma once
 
 #include <thrust/detail/device/dispatch/reduce.h>
-#include <thrust/detail/device/generic/reduce_by_key.h>
+#include <thrust/detail/device/dispatch/reduce_by_key.h>
 
 #include <thrust/iterator/iterator_traits.h>
 
@@ -56,8 +56,9 @@ reduce_by_key(InputIterator1 keys_first,
               OutputIterator2 values_output,
               BinaryPredicate binary_pred,
               BinaryFunction binary_op) {
-    // use generic path
-    return thrust::detail::device::generic::reduce_by_key(keys_first, keys_last, values_first, keys_output, values_output, binary_pred, binary_op);
+    // dispatch on space
+    return thrust::detail::device::dispatch::reduce_by_key(keys_first, keys_last, values_first, keys_output, values_output, binary_pred, binary_op,
+            typename thrust::iterator_space<OutputIterator1>::type());
 }
 
 } // end namespace device
@@ -21,7 +21,9 @@
 
 #pragma once
 
+#include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/device/generic/scatter.h>
+#include <thrust/detail/device/dispatch/scatter.h>
 
 namespace thrust {
 namespace detail {
@@ -34,7 +36,9 @@ void scatter(InputIterator1 first,
              InputIterator1 last,
              InputIterator2 map,
              RandomAccessIterator output) {
-    thrust::detail::device::generic::scatter(first, last, map, output);
+    // dispatch on space
+    thrust::detail::device::dispatch::scatter(first, last, map, output,
+            typename thrust::iterator_space<RandomAccessIterator>::type());
 }
 
 template < typename InputIterator1,
@@ -21,7 +21,8 @@
 
 #pragma once
 
-#include <thrust/detail/device/generic/segmented_scan.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/device/dispatch/segmented_scan.h>
 
 namespace thrust {
 namespace detail {
@@ -38,8 +39,10 @@ OutputIterator inclusive_segmented_scan(InputIterator1 first1,
                                         OutputIterator result,
                                         AssociativeOperator binary_op,
                                         BinaryPredicate pred) {
-    return thrust::detail::device::generic::inclusive_segmented_scan
-           (first1, last1, first2, result, binary_op, pred);
+    // dispatch on space
+    return thrust::detail::device::dispatch::inclusive_segmented_scan
+           (first1, last1, first2, result, binary_op, pred,
+            typename thrust::iterator_space<OutputIterator>::type());
 }
 
 template < typename InputIterator1,
@@ -55,8 +58,10 @@ OutputIterator exclusive_segmented_scan(InputIterator1 first1,
                                         const T init,
                                         AssociativeOperator binary_op,
                                         BinaryPredicate pred) {
-    return thrust::detail::device::generic::exclusive_segmented_scan
-           (first1, last1, first2, result, init, binary_op, pred);
+    // dispatch on space
+    return thrust::detail::device::dispatch::exclusive_segmented_scan
+           (first1, last1, first2, result, init, binary_op, pred,
+            typename thrust::iterator_space<OutputIterator>::type());
 }
 
 } // end namespace device
@@ -0,0 +1,68 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file segmented_sort.h
+ *  \brief Device implementations for segmented_sort and segmented_sort_by_key.
+ */
+
+#pragma once
+
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/device/dispatch/segmented_sort.h>
+
+namespace thrust {
+
+namespace detail {
+
+namespace device {
+
+template < typename RandomAccessIterator,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename StrictWeakOrdering >
+void segmented_sort(RandomAccessIterator keys_first,
+                    InputIterator1 begin_offsets_first,
+                    InputIterator1 begin_offsets_last,
+                    InputIterator2 end_offsets_first,
+                    StrictWeakOrdering comp) {
+    // dispatch on space
+    thrust::detail::device::dispatch::segmented_sort(keys_first, begin_offsets_first, begin_offsets_last, end_offsets_first, comp,
+            typename thrust::iterator_space<RandomAccessIterator>::type());
+} // end segmented_sort()
+
+template < typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename StrictWeakOrdering >
+void segmented_sort_by_key(RandomAccessIterator1 keys_first,
+                           RandomAccessIterator2 values_first,
+                           InputIterator1 begin_offsets_first,
+                           InputIterator1 begin_offsets_last,
+                           InputIterator2 end_offsets_first,
+                           StrictWeakOrdering comp) {
+    // dispatch on space
+    thrust::detail::device::dispatch::segmented_sort_by_key(keys_first, values_first, begin_offsets_first, begin_offsets_last, end_offsets_first, comp,
+            typename thrust::iterator_space<RandomAccessIterator1>::type());
+} // end segmented_sort_by_key()
+
+} // end device
+
+} // end detail
+
+} // end thrust
+
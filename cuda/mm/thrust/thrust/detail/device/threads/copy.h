@@ -0,0 +1,142 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file copy.h
+ *  \brief Copies between host and threads device ranges [threads].
+ */
+
+#pragma once
+
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/detail/any_space_tag.h>
+#include <thrust/iterator/detail/minimum_category.h>
+#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/threads/detail/scheduler.h>
+#include <thrust/distance.h>
+
+// for std::copy
+#include <algorithm>
+
+namespace thrust {
+namespace detail {
+namespace device {
+namespace threads {
+
+namespace detail {
+
+// host iterators are dereferenced directly, device iterators through
+// device::dereference
+template < typename Iterator >
+typename thrust::iterator_reference<Iterator>::type
+element(Iterator& it, thrust::host_space_tag) {
+    return *it;
+}
+
+template < typename Iterator >
+typename thrust::iterator_reference<Iterator>::type
+element(Iterator& it, thrust::any_space_tag) {
+    return *it;
+}
+
+template < typename Iterator >
+typename thrust::detail::device::dereference_result<Iterator>::type
+element(Iterator& it, thrust::device_space_tag) {
+    return thrust::detail::device::dereference(it);
+}
+
+template < typename InputIterator,
+         typename OutputIterator >
+struct copy_chunk {
+    typedef typename thrust::iterator_difference<InputIterator>::type difference;
+
+    InputIterator first;
+    OutputIterator result;
+    difference n, chunk;
+
+    void operator()(std::size_t c) {
+        difference begin = c * chunk;
+        difference end   = begin + chunk < n ? begin + chunk : n;
+
+        for (difference i = begin; i < end; ++i) {
+            InputIterator  in  = first  + i;
+            OutputIterator out = result + i;
+            element(out, typename thrust::iterator_space<OutputIterator>::type()) =
+                element(in, typename thrust::iterator_space<InputIterator>::type());
+        }
+    }
+}; // end copy_chunk
+
+} // end detail
+
+namespace dispatch {
+
+// random access to random access
+template < typename InputIterator,
+         typename OutputIterator >
+OutputIterator copy(InputIterator first,
+                    InputIterator last,
+                    OutputIterator result,
+                    thrust::random_access_traversal_tag) {
+    typedef typename thrust::iterator_difference<InputIterator>::type difference;
+
+    // both sides are host memory, so every direction copies the same way
+    difference n = thrust::distance(first, last);
+    if (n <= 0) return result;
+
+    difference chunk = thrust::detail::device::threads::detail::scheduler::instance().grain_size(n);
+
+    thrust::detail::device::threads::detail::copy_chunk<InputIterator, OutputIterator> body = {first, result, n, chunk};
+    thrust::detail::device::threads::detail::parallel_for((n + chunk - 1) / chunk, body);
+
+    return result + n;
+}
+
+// incrementable to incrementable
+template < typename InputIterator,
+         typename OutputIterator >
+OutputIterator copy(InputIterator first,
+                    InputIterator last,
+                    OutputIterator result,
+                    thrust::incrementable_traversal_tag) {
+    // serialize on the host
+    return std::copy(first, last, result);
+}
+
+} // end dispatch
+
+
+// entry point
+template < typename InputIterator,
+         typename OutputIterator >
+OutputIterator copy(InputIterator first,
+                    InputIterator last,
+                    OutputIterator result) {
+    typedef typename thrust::iterator_traversal<InputIterator>::type traversal1;
+    typedef typename thrust::iterator_traversal<OutputIterator>::type traversal2;
+
+    typedef typename thrust::detail::minimum_category<traversal1, traversal2>::type minimum_traversal;
+
+    // dispatch on min traversal
+    return thrust::detail::device::threads::dispatch::copy(first, last, result, minimum_traversal());
+}
+
+} // end namespace threads
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
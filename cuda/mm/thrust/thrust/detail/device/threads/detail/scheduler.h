@@ -0,0 +1,190 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file scheduler.h
+ *  \brief Work-stealing fork-join scheduler for the threads backend.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/mutex.h>
+#include <thrust/detail/atomic.h>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace thrust {
+namespace detail {
+namespace device {
+namespace threads {
+namespace detail {
+
+// a unit of work which may be run by any worker
+class job {
+public:
+    job() : m_done(0), m_failed(false) {}
+
+    virtual ~job() {}
+
+    // runs the job, records a failure and publishes completion
+    inline void run();
+
+    bool done() const {
+        return m_done.load() != 0;
+    }
+
+    // throws std::runtime_error if execute() failed
+    inline void rethrow() const;
+
+protected:
+    virtual void execute() = 0;
+
+private:
+    thrust::detail::atomic_int m_done;
+    bool m_failed;
+    std::string m_what;
+}; // end job
+
+
+template<typename Function>
+class function_job : public job {
+public:
+    explicit function_job(Function& f) : m_f(f) {}
+
+protected:
+    void execute() {
+        m_f();
+    }
+
+private:
+    Function& m_f;
+}; // end function_job
+
+
+// A fixed set of workers, one per processor, each owning a deque of
+// jobs.  fork() pushes one branch onto the calling worker's deque and
+// runs the other; idle workers steal the oldest job of a random victim.
+// Since nested calls only ever push onto the deque of the worker which
+// makes them, parallel algorithms called from inside a parallel
+// algorithm share the same workers instead of adding threads.
+class scheduler {
+public:
+    // the process-wide scheduler; THRUST_NUM_THREADS overrides the
+    // number of workers
+    inline static scheduler& instance(void);
+
+    // smallest range an algorithm should split off as a job
+    static const std::size_t min_grain_size = 2048;
+
+    std::size_t num_workers(void) const {
+        return m_num_workers;
+    }
+
+    // leaf size for splitting n elements: about eight leaves per worker
+    std::size_t grain_size(std::size_t n) const {
+        std::size_t grain = n / (8 * m_num_workers);
+        return grain < min_grain_size ? min_grain_size : grain;
+    }
+
+    // runs f() on the workers and returns once it has finished; f may
+    // call fork().  Called from a worker, this simply calls f().
+    template<typename Function>
+    inline void execute(Function& f);
+
+    // runs left() and right(), possibly in parallel, and returns once
+    // both have finished; only valid inside execute()
+    template<typename Function1, typename Function2>
+    inline void fork(Function1& left, Function2& right);
+
+private:
+    struct worker {
+        mutex lock;
+        std::deque<job*> jobs;
+        unsigned int seed;
+    }; // end worker
+
+    inline explicit scheduler(std::size_t num_workers);
+
+    inline void start(void);
+
+    // the calling thread's worker, or 0 outside the scheduler
+    inline worker* self(void) const;
+
+    inline void push(worker& w, job* j);
+
+    inline bool pop_if(worker& w, job* j);
+
+    inline job* steal(worker& w);
+
+    inline job* take_injected(void);
+
+    inline bool has_work(void);
+
+    inline void wake(void);
+
+    inline void join(worker& w, job& j);
+
+    inline void work(worker& w);
+
+#if THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC
+    inline static unsigned long __stdcall worker_main(void* w);
+#else
+    inline static void* worker_main(void* w);
+#endif // THRUST_HOST_COMPILER
+
+    std::size_t m_num_workers;
+    std::vector<worker*> m_workers;
+    thread_local_pointer m_self;
+
+    mutex m_start_lock;
+    bool m_started;
+
+    // jobs submitted by threads outside the scheduler
+    mutex m_inject_lock;
+    std::deque<job*> m_injected;
+
+    // idle workers sleep here
+    mutex m_sleep_lock;
+    condition_variable m_wake;
+    thrust::detail::atomic_int m_sleepers;
+
+    // threads outside the scheduler wait here for their jobs
+    mutex m_root_lock;
+    condition_variable m_root_done;
+
+    // the scheduler is never destroyed
+    ~scheduler(void);
+    scheduler(const scheduler&);
+    scheduler& operator=(const scheduler&);
+}; // end scheduler
+
+
+// calls f(i) for every i in [0, n) in parallel
+template<typename Function>
+inline void parallel_for(std::size_t n, Function& f);
+
+} // end namespace detail
+} // end namespace threads
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
+#include <thrust/detail/device/threads/detail/scheduler.inl>
+
@@ -0,0 +1,450 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file scheduler.inl
+ *  \brief Inline file for scheduler.h.
+ */
+
+#include <thrust/detail/device/threads/detail/scheduler.h>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+#if THRUST_HOST_COMPILER != THRUST_HOST_COMPILER_MSVC
+#include <sched.h>
+#include <unistd.h>
+#endif // THRUST_HOST_COMPILER
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace threads
+{
+namespace detail
+{
+
+inline void yield_thread(void)
+{
+#if THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC
+  SwitchToThread();
+#else
+  sched_yield();
+#endif // THRUST_HOST_COMPILER
+} // end yield_thread()
+
+
+void job
+  ::run(void)
+{
+  try
+  {
+    execute();
+  }
+  catch(std::exception &e)
+  {
+    m_failed = true;
+    m_what   = e.what();
+  }
+  catch(...)
+  {
+    m_failed = true;
+    m_what   = "unknown exception";
+  }
+
+  // the job may be destroyed as soon as this is visible
+  m_done.store(1);
+} // end job::run()
+
+
+void job
+  ::rethrow(void) const
+{
+  if(m_failed)
+    throw std::runtime_error(m_what);
+} // end job::rethrow()
+
+
+scheduler
+  ::scheduler(std::size_t num_workers)
+    : m_num_workers(num_workers < 1 ? 1 : num_workers),
+      m_started(false),
+      m_sleepers(0)
+{
+  for(std::size_t i = 0; i < m_num_workers; ++i)
+  {
+    worker *w = new worker;
+    w->seed = static_cast<unsigned int>(i + 1);
+    m_workers.push_back(w);
+  }
+} // end scheduler::scheduler()
+
+
+inline std::size_t default_num_workers(void)
+{
+  long num_workers = 0;
+
+  const char *env = std::getenv("THRUST_NUM_THREADS");
+  if(env != 0)
+    num_workers = std::atol(env);
+
+  if(num_workers <= 0)
+  {
+#if THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    num_workers = info.dwNumberOfProcessors;
+#else
+    num_workers = sysconf(_SC_NPROCESSORS_ONLN);
+#endif // THRUST_HOST_COMPILER
+  }
+
+  return num_workers > 0 ? num_workers : 1;
+} // end default_num_workers()
+
+
+scheduler &scheduler
+  ::instance(void)
+{
+  // leaked deliberately: workers sleep on the scheduler until exit
+  static scheduler *s = new scheduler(default_num_workers());
+  return *s;
+} // end scheduler::instance()
+
+
+void scheduler
+  ::start(void)
+{
+  scoped_lock guard(m_start_lock);
+
+  if(m_started) return;
+
+  for(std::size_t i = 0; i < m_num_workers; ++i)
+  {
+#if THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC
+    HANDLE handle = CreateThread(0, 0, &scheduler::worker_main, m_workers[i], 0, 0);
+    if(handle == 0)
+      throw std::bad_alloc();
+    CloseHandle(handle);
+#else
+    pthread_t thread;
+    if(pthread_create(&thread, 0, &scheduler::worker_main, m_workers[i]) != 0)
+      throw std::bad_alloc();
+    pthread_detach(thread);
+#endif // THRUST_HOST_COMPILER
+  }
+
+  m_started = true;
+} // end scheduler::start()
+
+
+scheduler::worker *scheduler
+  ::self(void) const
+{
+  return static_cast<worker*>(m_self.get());
+} // end scheduler::self()
+
+
+void scheduler
+  ::wake(void)
+{
+  // a worker going to sleep counts itself before it looks for work, so
+  // either it finds the job just pushed or we see it here
+  if(m_sleepers.load() > 0)
+  {
+    scoped_lock guard(m_sleep_lock);
+    m_wake.notify_one();
+  }
+} // end scheduler::wake()
+
+
+void scheduler
+  ::push(worker &w, job *j)
+{
+  {
+    scoped_lock guard(w.lock);
+    w.jobs.push_back(j);
+  }
+
+  wake();
+} // end scheduler::push()
+
+
+bool scheduler
+  ::pop_if(worker &w, job *j)
+{
+  scoped_lock guard(w.lock);
+
+  if(!w.jobs.empty() && w.jobs.back() == j)
+  {
+    w.jobs.pop_back();
+    return true;
+  }
+
+  return false;
+} // end scheduler::pop_if()
+
+
+job *scheduler
+  ::steal(worker &w)
+{
+  // xorshift to pick the first victim
+  w.seed ^= w.seed << 13;
+  w.seed ^= w.seed >> 17;
+  w.seed ^= w.seed << 5;
+
+  std::size_t first = w.seed % m_num_workers;
+
+  for(std::size_t k = 0; k < m_num_workers; ++k)
+  {
+    worker *victim = m_workers[(first + k) % m_num_workers];
+    if(victim == &w) continue;
+
+    scoped_lock guard(victim->lock);
+
+    if(!victim->jobs.empty())
+    {
+      job *j = victim->jobs.front();
+      victim->jobs.pop_front();
+      return j;
+    }
+  }
+
+  return 0;
+} // end scheduler::steal()
+
+
+job *scheduler
+  ::take_injected(void)
+{
+  scoped_lock guard(m_inject_lock);
+
+  if(m_injected.empty()) return 0;
+
+  job *j = m_injected.front();
+  m_injected.pop_front();
+  return j;
+} // end scheduler::take_injected()
+
+
+bool scheduler
+  ::has_work(void)
+{
+  {
+    scoped_lock guard(m_inject_lock);
+    if(!m_injected.empty()) return true;
+  }
+
+  for(std::size_t i = 0; i < m_num_workers; ++i)
+  {
+    scoped_lock guard(m_workers[i]->lock);
+    if(!m_workers[i]->jobs.empty()) return true;
+  }
+
+  return false;
+} // end scheduler::has_work()
+
+
+void scheduler
+  ::join(worker &w, job &j)
+{
+  // nobody took it: run it here
+  if(pop_if(w, &j))
+  {
+    j.run();
+    return;
+  }
+
+  // it was stolen: help the other workers until it is done
+  while(!j.done())
+  {
+    job *other = steal(w);
+
+    if(other != 0)
+      other->run();
+    else
+      yield_thread();
+  }
+} // end scheduler::join()
+
+
+template<typename Function1, typename Function2>
+  void scheduler
+    ::fork(Function1 &left, Function2 &right)
+{
+  worker *w = self();
+
+  if(w == 0)
+  {
+    left();
+    right();
+    return;
+  }
+
+  function_job<Function2> right_job(right);
+  push(*w, &right_job);
+
+  try
+  {
+    left();
+  }
+  catch(...)
+  {
+    // right_job lives on this stack frame
+    join(*w, right_job);
+    throw;
+  }
+
+  join(*w, right_job);
+  right_job.rethrow();
+} // end scheduler::fork()
+
+
+template<typename Function>
+  void scheduler
+    ::execute(Function &f)
+{
+  // nested call: stay on this worker
+  if(self() != 0)
+  {
+    f();
+    return;
+  }
+
+  start();
+
+  function_job<Function> root(f);
+
+  {
+    scoped_lock guard(m_inject_lock);
+    m_injected.push_back(&root);
+  }
+
+  wake();
+
+  {
+    scoped_lock guard(m_root_lock);
+    while(!root.done())
+      m_root_done.wait(m_root_lock);
+  }
+
+  root.rethrow();
+} // end scheduler::execute()
+
+
+void scheduler
+  ::work(worker &w)
+{
+  m_self.set(&w);
+
+  while(true)
+  {
+    job *j = steal(w);
+
+    if(j != 0)
+    {
+      j->run();
+      continue;
+    }
+
+    j = take_injected();
+
+    if(j != 0)
+    {
+      j->run();
+
+      scoped_lock guard(m_root_lock);
+      m_root_done.notify_all();
+      continue;
+    }
+
+    scoped_lock guard(m_sleep_lock);
+
+    m_sleepers.fetch_add(1);
+    while(!has_work())
+      m_wake.wait(m_sleep_lock);
+    m_sleepers.fetch_add(-1);
+  }
+} // end scheduler::work()
+
+
+#if THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC
+unsigned long __stdcall scheduler
+  ::worker_main(void *w)
+{
+  scheduler::instance().work(*static_cast<worker*>(w));
+  return 0;
+} // end scheduler::worker_main()
+#else
+void *scheduler
+  ::worker_main(void *w)
+{
+  scheduler::instance().work(*static_cast<worker*>(w));
+  return 0;
+} // end scheduler::worker_main()
+#endif // THRUST_HOST_COMPILER
+
+
+template<typename Function>
+  struct parallel_for_body
+{
+  std::size_t begin, end;
+  Function *f;
+
+  void operator()(void)
+  {
+    if(end - begin == 1)
+    {
+      (*f)(begin);
+      return;
+    }
+
+    std::size_t mid = begin + (end - begin) / 2;
+
+    parallel_for_body left  = {begin, mid, f};
+    parallel_for_body right = {mid,   end, f};
+
+    scheduler::instance().fork(left, right);
+  }
+}; // end parallel_for_body
+
+
+template<typename Function>
+  void parallel_for(std::size_t n, Function &f)
+{
+  if(n == 0) return;
+
+  // not worth a trip through the scheduler
+  if(n == 1)
+  {
+    f(0);
+    return;
+  }
+
+  parallel_for_body<Function> body = {0, n, &f};
+  scheduler::instance().execute(body);
+} // end parallel_for()
+
+} // end detail
+} // end threads
+} // end device
+} // end detail
+} // end thrust
+
@@ -0,0 +1,54 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file stable_merge_sort.h
+ *  \brief Parallel stable merge sort over raw pointers [threads]
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace thrust {
+namespace detail {
+namespace device {
+namespace threads {
+namespace detail {
+
+template < typename T,
+         typename StrictWeakOrdering >
+void stable_merge_sort(T* first,
+                       T* last,
+                       StrictWeakOrdering comp);
+
+template < typename Key,
+         typename Value,
+         typename StrictWeakOrdering >
+void stable_merge_sort_by_key(Key* keys_first,
+                              Key* keys_last,
+                              Value* values_first,
+                              StrictWeakOrdering comp);
+
+} // end namespace detail
+} // end namespace threads
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
+#include <thrust/detail/device/threads/detail/stable_merge_sort.inl>
+
@@ -0,0 +1,230 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file stable_merge_sort.inl
+ *  \brief Inline file for stable_merge_sort.h.
+ */
+
+#include <thrust/detail/raw_buffer.h>
+#include <thrust/detail/device/threads/detail/scheduler.h>
+#include <thrust/pair.h>
+#include <algorithm>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace threads
+{
+namespace detail
+{
+
+// stable merge of [a, a + na) and [b, b + nb) into out; the larger
+// input is split at its middle and the other at the matching bound,
+// so that on ties elements of a stay ahead of elements of b
+template<typename T,
+         typename StrictWeakOrdering>
+  struct merge_body
+{
+  const T *a;
+  std::size_t na;
+  const T *b;
+  std::size_t nb;
+  T *out;
+  std::size_t grain;
+  StrictWeakOrdering comp;
+
+  void operator()(void)
+  {
+    if(na + nb <= grain)
+    {
+      std::merge(a, a + na, b, b + nb, out, comp);
+      return;
+    }
+
+    std::size_t ia, ib;
+
+    if(na >= nb)
+    {
+      ia = na / 2;
+      ib = std::lower_bound(b, b + nb, a[ia], comp) - b;
+    }
+    else
+    {
+      ib = nb / 2;
+      ia = std::upper_bound(a, a + na, b[ib], comp) - a;
+    }
+
+    merge_body left  = {a,      ia,      b,      ib,      out,           grain, comp};
+    merge_body right = {a + ia, na - ia, b + ib, nb - ib, out + ia + ib, grain, comp};
+
+    scheduler::instance().fork(left, right);
+  }
+}; // end merge_body
+
+
+// sorts [src, src + n), leaving the result in src or, if !into_src, in
+// buf; the halves are sorted into the other array and merged back
+template<typename T,
+         typename StrictWeakOrdering>
+  struct sort_body
+{
+  T *src;
+  T *buf;
+  std::size_t n;
+  std::size_t grain;
+  StrictWeakOrdering comp;
+  bool into_src;
+
+  void operator()(void)
+  {
+    if(n <= grain)
+    {
+      std::stable_sort(src, src + n, comp);
+
+      if(!into_src)
+        std::copy(src, src + n, buf);
+
+      return;
+    }
+
+    std::size_t half = n / 2;
+
+    sort_body left  = {src,        buf,        half,     grain, comp, !into_src};
+    sort_body right = {src + half, buf + half, n - half, grain, comp, !into_src};
+
+    scheduler::instance().fork(left, right);
+
+    const T *from = into_src ? buf : src;
+    T       *to   = into_src ? src : buf;
+
+    merge_body<T,StrictWeakOrdering> merge = {from, half, from + half, n - half, to, grain, comp};
+    merge();
+  }
+}; // end sort_body
+
+
+template<typename T,
+         typename StrictWeakOrdering>
+void stable_merge_sort(T *first,
+                       T *last,
+                       StrictWeakOrdering comp)
+{
+  std::size_t n = last - first;
+
+  scheduler &s = scheduler::instance();
+  std::size_t grain = s.grain_size(n);
+
+  if(n <= grain)
+  {
+    std::stable_sort(first, last, comp);
+    return;
+  }
+
+  thrust::detail::raw_host_buffer<T> buffer(n);
+
+  sort_body<T,StrictWeakOrdering> body = {first, thrust::raw_pointer_cast(&buffer[0]), n, grain, comp, true};
+  s.execute(body);
+} // end stable_merge_sort()
+
+
+template<typename Key,
+         typename Value,
+         typename StrictWeakOrdering>
+  struct compare_first
+{
+  StrictWeakOrdering comp;
+
+  bool operator()(const thrust::pair<Key,Value> &x, const thrust::pair<Key,Value> &y) const
+  {
+    return comp(x.first, y.first);
+  }
+}; // end compare_first
+
+
+template<typename Key,
+         typename Value>
+  struct zip_chunk
+{
+  Key *keys;
+  Value *values;
+  thrust::pair<Key,Value> *pairs;
+  std::size_t n, chunk;
+  bool unzip;
+
+  void operator()(std::size_t c)
+  {
+    std::size_t begin = c * chunk;
+    std::size_t end   = std::min(begin + chunk, n);
+
+    if(unzip)
+    {
+      for(std::size_t i = begin; i < end; ++i)
+      {
+        keys[i]   = pairs[i].first;
+        values[i] = pairs[i].second;
+      }
+    }
+    else
+    {
+      for(std::size_t i = begin; i < end; ++i)
+        pairs[i] = thrust::make_pair(keys[i], values[i]);
+    }
+  }
+}; // end zip_chunk
+
+
+// sorts (key, value) pairs so that each value moves with its key
+template<typename Key,
+         typename Value,
+         typename StrictWeakOrdering>
+void stable_merge_sort_by_key(Key *keys_first,
+                              Key *keys_last,
+                              Value *values_first,
+                              StrictWeakOrdering comp)
+{
+  typedef thrust::pair<Key,Value> KeyValuePair;
+
+  std::size_t n = keys_last - keys_first;
+  if(n == 0) return;
+
+  scheduler &s = scheduler::instance();
+  std::size_t chunk = s.grain_size(n);
+  std::size_t num_chunks = (n + chunk - 1) / chunk;
+
+  thrust::detail::raw_host_buffer<KeyValuePair> pairs(n);
+  KeyValuePair *pairs_ptr = thrust::raw_pointer_cast(&pairs[0]);
+
+  zip_chunk<Key,Value> zip = {keys_first, values_first, pairs_ptr, n, chunk, false};
+  parallel_for(num_chunks, zip);
+
+  compare_first<Key,Value,StrictWeakOrdering> pair_comp = {comp};
+  stable_merge_sort(pairs_ptr, pairs_ptr + n, pair_comp);
+
+  zip.unzip = true;
+  parallel_for(num_chunks, zip);
+} // end stable_merge_sort_by_key()
+
+} // end namespace detail
+} // end namespace threads
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -0,0 +1,97 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file for_each.inl
+ *  \brief Inline file for for_each.h.
+ */
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/threads/detail/scheduler.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace threads
+{
+namespace detail
+{
+
+template<typename InputIterator,
+         typename UnaryFunction>
+  struct for_each_body
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type difference;
+
+  InputIterator first;
+  difference n;
+  difference grain;
+  UnaryFunction f;
+
+  void operator()(void)
+  {
+    if(n <= grain)
+    {
+      for(difference i = 0; i < n; ++i)
+      {
+        InputIterator temp = first + i;
+        f(thrust::detail::device::dereference(temp));
+      }
+
+      return;
+    }
+
+    difference half = n / 2;
+
+    for_each_body left  = {first,        half,     grain, f};
+    for_each_body right = {first + half, n - half, grain, f};
+
+    scheduler::instance().fork(left, right);
+  }
+}; // end for_each_body
+
+} // end namespace detail
+
+
+template<typename InputIterator,
+         typename UnaryFunction>
+void for_each(InputIterator first,
+              InputIterator last,
+              UnaryFunction f)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type difference;
+
+  difference n = thrust::distance(first,last);
+  if(n <= 0) return;
+
+  detail::scheduler &s = detail::scheduler::instance();
+
+  detail::for_each_body<InputIterator,UnaryFunction> body = {first, n, static_cast<difference>(s.grain_size(n)), f};
+  s.execute(body);
+} // end for_each()
+
+} // end namespace threads
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -0,0 +1,110 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file reduce.inl
+ *  \brief Inline file for reduce.h.
+ */
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/threads/detail/scheduler.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace threads
+{
+namespace detail
+{
+
+// reduces a non-empty range into result; the left half always
+// becomes the left operand, so only associativity is assumed
+template<typename InputIterator,
+         typename OutputType,
+         typename BinaryFunction>
+  struct reduce_body
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type difference;
+
+  InputIterator first;
+  difference n;
+  difference grain;
+  BinaryFunction binary_op;
+  OutputType result;
+
+  void operator()(void)
+  {
+    if(n <= grain)
+    {
+      InputIterator temp = first;
+      result = thrust::detail::device::dereference(temp);
+
+      for(difference i = 1; i < n; ++i)
+      {
+        temp = first + i;
+        result = binary_op(result, thrust::detail::device::dereference(temp));
+      }
+
+      return;
+    }
+
+    difference half = n / 2;
+
+    reduce_body left  = {first,        half,     grain, binary_op, result};
+    reduce_body right = {first + half, n - half, grain, binary_op, result};
+
+    scheduler::instance().fork(left, right);
+
+    result = binary_op(left.result, right.result);
+  }
+}; // end reduce_body
+
+} // end namespace detail
+
+
+template<typename InputIterator,
+         typename OutputType,
+         typename BinaryFunction>
+OutputType reduce(InputIterator first,
+                  InputIterator last,
+                  OutputType init,
+                  BinaryFunction binary_op)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type difference;
+
+  difference n = thrust::distance(first,last);
+  if(n <= 0) return init;
+
+  detail::scheduler &s = detail::scheduler::instance();
+
+  detail::reduce_body<InputIterator,OutputType,BinaryFunction> body = {first, n, static_cast<difference>(s.grain_size(n)), binary_op, init};
+  s.execute(body);
+
+  return binary_op(init, body.result);
+} // end reduce()
+
+} // end namespace threads
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -0,0 +1,240 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file scan.inl
+ *  \brief Inline file for scan.h.
+ */
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/raw_buffer.h>
+#include <thrust/detail/device/dereference.h>
+#include <thrust/detail/device/threads/detail/scheduler.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+
+namespace thrust
+{
+namespace detail
+{
+
+// raw_buffer.h can reach this file through device_ptr.h before
+// raw_host_buffer has been defined
+template<typename T> class raw_host_buffer;
+
+namespace device
+{
+namespace threads
+{
+namespace detail
+{
+
+// Both scans run in three passes over chunks of the input: the sum of
+// every chunk but the last, in parallel; the carry into every chunk,
+// serially; then every chunk is scanned from its carry, in parallel.
+
+template<typename InputIterator,
+         typename OutputType,
+         typename AssociativeOperator>
+  struct chunk_sum
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type difference;
+
+  InputIterator first;
+  difference n, chunk;
+  AssociativeOperator binary_op;
+  OutputType *sums;
+
+  void operator()(std::size_t c)
+  {
+    difference begin = c * chunk;
+    difference end   = begin + chunk < n ? begin + chunk : n;
+
+    InputIterator temp = first + begin;
+    OutputType sum = thrust::detail::device::dereference(temp);
+
+    for(difference i = begin + 1; i < end; ++i)
+    {
+      temp = first + i;
+      sum = binary_op(sum, thrust::detail::device::dereference(temp));
+    }
+
+    sums[c] = sum;
+  }
+}; // end chunk_sum
+
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename OutputType,
+         typename AssociativeOperator>
+  struct inclusive_chunk_scan
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type difference;
+
+  InputIterator first;
+  OutputIterator result;
+  difference n, chunk;
+  AssociativeOperator binary_op;
+  const OutputType *carries;
+
+  void operator()(std::size_t c)
+  {
+    difference begin = c * chunk;
+    difference end   = begin + chunk < n ? begin + chunk : n;
+
+    InputIterator  in  = first  + begin;
+    OutputIterator out = result + begin;
+
+    OutputType sum = (c == 0) ?
+      OutputType(thrust::detail::device::dereference(in)) :
+      OutputType(binary_op(carries[c], thrust::detail::device::dereference(in)));
+    thrust::detail::device::dereference(out) = sum;
+
+    for(difference i = begin + 1; i < end; ++i)
+    {
+      in  = first  + i;
+      out = result + i;
+      thrust::detail::device::dereference(out) = sum = binary_op(sum, thrust::detail::device::dereference(in));
+    }
+  }
+}; // end inclusive_chunk_scan
+
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename OutputType,
+         typename AssociativeOperator>
+  struct exclusive_chunk_scan
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type difference;
+
+  InputIterator first;
+  OutputIterator result;
+  difference n, chunk;
+  AssociativeOperator binary_op;
+  const OutputType *carries;
+
+  void operator()(std::size_t c)
+  {
+    difference begin = c * chunk;
+    difference end   = begin + chunk < n ? begin + chunk : n;
+
+    OutputType sum = carries[c];
+
+    for(difference i = begin; i < end; ++i)
+    {
+      InputIterator  in  = first  + i;
+      OutputIterator out = result + i;
+
+      OutputType tmp = thrust::detail::device::dereference(in);  // temporary value allows in-situ scan
+      thrust::detail::device::dereference(out) = sum;
+      sum = binary_op(sum, tmp);
+    }
+  }
+}; // end exclusive_chunk_scan
+
+} // end namespace detail
+
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename AssociativeOperator>
+  OutputIterator inclusive_scan(InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                AssociativeOperator binary_op)
+{
+  typedef typename thrust::iterator_traits<OutputIterator>::value_type OutputType;
+  typedef typename thrust::iterator_difference<InputIterator>::type    difference;
+
+  difference n = thrust::distance(first,last);
+  if(n <= 0) return result;
+
+  detail::scheduler &s = detail::scheduler::instance();
+
+  difference chunk = s.grain_size(n);
+  std::size_t num_chunks = (n + chunk - 1) / chunk;
+
+  thrust::detail::raw_host_buffer<OutputType> sums(num_chunks);
+  thrust::detail::raw_host_buffer<OutputType> carries(num_chunks);
+
+  OutputType *sums_ptr    = thrust::raw_pointer_cast(&sums[0]);
+  OutputType *carries_ptr = thrust::raw_pointer_cast(&carries[0]);
+
+  detail::chunk_sum<InputIterator,OutputType,AssociativeOperator> pass1 = {first, n, chunk, binary_op, sums_ptr};
+  detail::parallel_for(num_chunks - 1, pass1);
+
+  if(num_chunks > 1)
+  {
+    carries_ptr[1] = sums_ptr[0];
+    for(std::size_t c = 2; c < num_chunks; ++c)
+      carries_ptr[c] = binary_op(carries_ptr[c-1], sums_ptr[c-1]);
+  }
+
+  detail::inclusive_chunk_scan<InputIterator,OutputIterator,OutputType,AssociativeOperator> pass3 = {first, result, n, chunk, binary_op, carries_ptr};
+  detail::parallel_for(num_chunks, pass3);
+
+  return result + n;
+} // end inclusive_scan()
+
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename T,
+         typename AssociativeOperator>
+  OutputIterator exclusive_scan(InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                T init,
+                                AssociativeOperator binary_op)
+{
+  typedef typename thrust::iterator_traits<OutputIterator>::value_type OutputType;
+  typedef typename thrust::iterator_difference<InputIterator>::type    difference;
+
+  difference n = thrust::distance(first,last);
+  if(n <= 0) return result;
+
+  detail::scheduler &s = detail::scheduler::instance();
+
+  difference chunk = s.grain_size(n);
+  std::size_t num_chunks = (n + chunk - 1) / chunk;
+
+  thrust::detail::raw_host_buffer<OutputType> sums(num_chunks);
+  thrust::detail::raw_host_buffer<OutputType> carries(num_chunks);
+
+  OutputType *sums_ptr    = thrust::raw_pointer_cast(&sums[0]);
+  OutputType *carries_ptr = thrust::raw_pointer_cast(&carries[0]);
+
+  detail::chunk_sum<InputIterator,OutputType,AssociativeOperator> pass1 = {first, n, chunk, binary_op, sums_ptr};
+  detail::parallel_for(num_chunks - 1, pass1);
+
+  carries_ptr[0] = init;
+  for(std::size_t c = 1; c < num_chunks; ++c)
+    carries_ptr[c] = binary_op(carries_ptr[c-1], sums_ptr[c-1]);
+
+  detail::exclusive_chunk_scan<InputIterator,OutputIterator,OutputType,AssociativeOperator> pass3 = {first, result, n, chunk, binary_op, carries_ptr};
+  detail::parallel_for(num_chunks, pass3);
+
+  return result + n;
+} // end exclusive_scan()
+
+} // end namespace threads
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
@@ -0,0 +1,67 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file sort.inl
+ *  \brief Inline file for sort.h.
+ */
+
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/device/threads/dispatch/sort.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace device
+{
+namespace threads
+{
+
+template<typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp)
+{
+    // dispatch on the trivialness of the iterator
+    thrust::detail::device::threads::dispatch::stable_sort(first, last, comp,
+        thrust::detail::is_trivial_iterator<RandomAccessIterator>());
+}
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+void stable_sort_by_key(RandomAccessIterator1 keys_first,
+                        RandomAccessIterator1 keys_last,
+                        RandomAccessIterator2 values_first,
+                        StrictWeakOrdering comp)
+{
+    // dispatch on the trivialness of both iterators
+    typedef thrust::detail::integral_constant<bool,
+        thrust::detail::is_trivial_iterator<RandomAccessIterator1>::value &&
+        thrust::detail::is_trivial_iterator<RandomAccessIterator2>::value> both_trivial;
+
+    thrust::detail::device::threads::dispatch::stable_sort_by_key(keys_first, keys_last, values_first, comp,
+        both_trivial());
+}
+
+} // end namespace threads
+} // end namespace device
+} // end namespace detail
+} // end namespace thrust
+
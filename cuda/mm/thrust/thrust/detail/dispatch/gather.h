@@ -0,0 +1,140 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file gather.h
+ *  \brief Dispatch layer for gather.
+ */
+
+#pragma once
+
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/permutation_iterator.h>
+#include <thrust/iterator/detail/minimum_space.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/detail/device/gather.h>
+
+namespace thrust {
+
+// XXX WAR circular #inclusion with this forward declaration
+template<typename InputIterator, typename OutputIterator> OutputIterator copy(InputIterator, InputIterator, OutputIterator);
+
+namespace detail {
+
+namespace dispatch {
+
+////////////////
+// Host Paths //
+////////////////
+template < typename InputIterator,
+         typename RandomAccessIterator,
+         typename OutputIterator >
+OutputIterator gather(InputIterator        map_first,
+                      InputIterator        map_last,
+                      RandomAccessIterator input_first,
+                      OutputIterator       result,
+                      thrust::host_space_tag) {
+    return thrust::copy(thrust::make_permutation_iterator(input_first, map_first),
+                        thrust::make_permutation_iterator(input_first, map_last),
+                        result);
+} // end gather()
+
+//////////////////
+// Device Paths //
+//////////////////
+template < typename InputIterator,
+         typename RandomAccessIterator,
+         typename OutputIterator >
+OutputIterator gather(InputIterator        map_first,
+                      InputIterator        map_last,
+                      RandomAccessIterator input_first,
+                      OutputIterator       result,
+                      thrust::device_space_tag) {
+    return thrust::detail::device::gather(map_first, map_last, input_first, result);
+} // end gather()
+
+template < typename InputIterator,
+         typename RandomAccessIterator,
+         typename OutputIterator >
+OutputIterator gather(InputIterator        map_first,
+                      InputIterator        map_last,
+                      RandomAccessIterator input_first,
+                      OutputIterator       result,
+                      thrust::any_space_tag) {
+    return thrust::detail::device::gather(map_first, map_last, input_first, result);
+} // end gather()
+
+//////////////////////
+// Cross-Space Path //
+//////////////////////
+template < typename InputIterator,
+         typename RandomAccessIterator,
+         typename OutputIterator >
+OutputIterator gather(InputIterator        map_first,
+                      InputIterator        map_last,
+                      RandomAccessIterator input_first,
+                      OutputIterator       result,
+                      thrust::detail::false_type cross_space_gather) {
+    // let copy move the permuted elements between spaces
+    return thrust::copy(thrust::make_permutation_iterator(input_first, map_first),
+                        thrust::make_permutation_iterator(input_first, map_last),
+                        result);
+} // end gather()
+
+//////////////////////
+// Intra-Space Path //
+//////////////////////
+template < typename InputIterator,
+         typename RandomAccessIterator,
+         typename OutputIterator >
+OutputIterator gather(InputIterator        map_first,
+                      InputIterator        map_last,
+                      RandomAccessIterator input_first,
+                      OutputIterator       result,
+                      thrust::detail::true_type cross_space_gather) {
+    typedef typename thrust::iterator_space<InputIterator>::type        space1;
+    typedef typename thrust::iterator_space<RandomAccessIterator>::type space2;
+    typedef typename thrust::iterator_space<OutputIterator>::type       space3;
+
+    // find the minimum space of the three
+    typedef typename thrust::detail::minimum_space<space1, space2>::type space4;
+    typedef typename thrust::detail::minimum_space<space3, space4>::type minimum_space;
+
+    return thrust::detail::dispatch::gather(map_first, map_last, input_first, result, minimum_space());
+} // end gather()
+
+// entry point
+template < typename InputIterator,
+         typename RandomAccessIterator,
+         typename OutputIterator,
+         typename Space1,
+         typename Space2 >
+OutputIterator gather(InputIterator        map_first,
+                      InputIterator        map_last,
+                      RandomAccessIterator input_first,
+                      OutputIterator       result,
+                      Space1,
+                      Space2) {
+    return thrust::detail::dispatch::gather(map_first, map_last, input_first, result,
+                                            typename thrust::detail::is_one_convertible_to_the_other<Space1, Space2>::type());
+} // end gather()
+
+} // end dispatch
+
+} // end detail
+
+} // end thrust
+
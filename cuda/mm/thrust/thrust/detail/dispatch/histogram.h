@@ -0,0 +1,103 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file histogram.h
+ *  \brief Dispatch layer for histogram_even and histogram_range.
+ */
+
+#pragma once
+
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/host/histogram.h>
+#include <thrust/detail/device/histogram.h>
+
+namespace thrust {
+
+namespace detail {
+
+namespace dispatch {
+
+////////////////
+// Host Paths //
+////////////////
+template < typename InputIterator,
+         typename OutputIterator,
+         typename Size,
+         typename T >
+OutputIterator histogram_even(InputIterator first,
+                              InputIterator last,
+                              OutputIterator output,
+                              Size num_bins,
+                              T lower,
+                              T upper,
+                              thrust::host_space_tag,
+                              thrust::host_space_tag) {
+    return thrust::detail::host::histogram_even(first, last, output, num_bins, lower, upper);
+} // end histogram_even()
+
+template < typename InputIterator,
+         typename ForwardIterator,
+         typename OutputIterator >
+OutputIterator histogram_range(InputIterator first,
+                               InputIterator last,
+                               ForwardIterator levels_first,
+                               ForwardIterator levels_last,
+                               OutputIterator output,
+                               thrust::host_space_tag,
+                               thrust::host_space_tag,
+                               thrust::host_space_tag) {
+    return thrust::detail::host::histogram_range(first, last, levels_first, levels_last, output);
+} // end histogram_range()
+
+//////////////////
+// Device Paths //
+//////////////////
+template < typename InputIterator,
+         typename OutputIterator,
+         typename Size,
+         typename T >
+OutputIterator histogram_even(InputIterator first,
+                              InputIterator last,
+                              OutputIterator output,
+                              Size num_bins,
+                              T lower,
+                              T upper,
+                              thrust::device_space_tag,
+                              thrust::device_space_tag) {
+    return thrust::detail::device::histogram_even(first, last, output, num_bins, lower, upper);
+} // end histogram_even()
+
+template < typename InputIterator,
+         typename ForwardIterator,
+         typename OutputIterator >
+OutputIterator histogram_range(InputIterator first,
+                               InputIterator last,
+                               ForwardIterator levels_first,
+                               ForwardIterator levels_last,
+                               OutputIterator output,
+                               thrust::device_space_tag,
+                               thrust::device_space_tag,
+                               thrust::device_space_tag) {
+    return thrust::detail::device::histogram_range(first, last, levels_first, levels_last, output);
+} // end histogram_range()
+
+} // end dispatch
+
+} // end detail
+
+} // end thrust
+
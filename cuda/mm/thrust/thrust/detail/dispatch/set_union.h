@@ -0,0 +1,68 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/set_union.h>
+#include <thrust/detail/host/set_union.h>
+#include <thrust/detail/device/set_union.h>
+
+namespace thrust {
+
+namespace detail {
+
+namespace dispatch {
+
+template < typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering >
+OutputIterator set_union(InputIterator1 first1,
+                         InputIterator1 last1,
+                         InputIterator2 first2,
+                         InputIterator2 last2,
+                         OutputIterator result,
+                         StrictWeakOrdering comp,
+                         thrust::host_space_tag,
+                         thrust::host_space_tag,
+                         thrust::host_space_tag) {
+    return thrust::detail::host::set_union(first1, last1, first2, last2, result, comp);
+} // end set_union()
+
+
+template < typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering >
+OutputIterator set_union(InputIterator1 first1,
+                         InputIterator1 last1,
+                         InputIterator2 first2,
+                         InputIterator2 last2,
+                         OutputIterator result,
+                         StrictWeakOrdering comp,
+                         thrust::device_space_tag,
+                         thrust::device_space_tag,
+                         thrust::device_space_tag) {
+    return thrust::detail::device::set_union(first1, last1, first2, last2, result, comp);
+} // end set_union()
+
+
+} // end dispatch
+
+} // end detail
+
+} // end thrust
+
@@ -0,0 +1,57 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file first_touch.h
+ *  \brief Allocation of host memory whose pages are placed by the
+ *         threads which will later work on them.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <cstddef>
+
+namespace thrust
+{
+
+namespace detail
+{
+
+// allocations at least this large are aligned to, and advised onto,
+// transparent huge pages
+const std::size_t huge_page_size = std::size_t(2) << 20;
+
+// allocates storage for n elements of element_size bytes and touches its
+// pages with first_touch(); returns 0 on failure
+inline void *first_touch_malloc(std::size_t n, std::size_t element_size);
+
+// releases storage obtained from first_touch_malloc()
+inline void first_touch_free(void *ptr);
+
+// Writes one byte of every page of the array of n elements at ptr from the
+// OpenMP thread which owns that part of the array under the static
+// partition of the OpenMP algorithms, so that a first-touch NUMA policy
+// places each page on the node of the thread which will work on it.  The
+// contents of the array are unspecified afterwards.
+inline void first_touch(void *ptr, std::size_t n, std::size_t element_size);
+
+} // end detail
+
+} // end thrust
+
+#include <thrust/detail/first_touch.inl>
+
@@ -0,0 +1,170 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file first_touch.inl
+ *  \brief Inline file for first_touch.h.
+ */
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <thrust/detail/first_touch.h>
+#include <thrust/detail/device/omp/detail/static_partition.h>
+#include <cstdlib>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+namespace thrust
+{
+namespace detail
+{
+namespace first_touch_detail
+{
+
+// alignment of small allocations, so that no cache line is shared with
+// another allocation
+const std::size_t cache_line_size = 64;
+
+inline std::size_t page_size(void)
+{
+#if defined(_WIN32)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwPageSize;
+#else
+  long size = sysconf(_SC_PAGESIZE);
+  return (size > 0) ? std::size_t(size) : 4096;
+#endif
+} // end page_size()
+
+inline void *aligned_malloc(std::size_t bytes, std::size_t alignment)
+{
+#if defined(_WIN32)
+  return _aligned_malloc(bytes, alignment);
+#else
+  void *ptr = 0;
+  return (posix_memalign(&ptr, alignment, bytes) == 0) ? ptr : 0;
+#endif
+} // end aligned_malloc()
+
+inline void aligned_free(void *ptr)
+{
+#if defined(_WIN32)
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+} // end aligned_free()
+
+} // end first_touch_detail
+
+
+inline void *first_touch_malloc(std::size_t n, std::size_t element_size)
+{
+  std::size_t bytes = n * element_size;
+
+  if(bytes == 0)
+    bytes = 1;
+
+  void *ptr = 0;
+
+  if(bytes >= huge_page_size)
+  {
+    // whole huge pages, so the advice below covers the entire allocation
+    bytes = (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+
+    ptr = first_touch_detail::aligned_malloc(bytes, huge_page_size);
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // only a hint: the kernel may not have transparent huge pages enabled
+    if(ptr != 0)
+      madvise(ptr, bytes, MADV_HUGEPAGE);
+#endif
+  }
+  else
+  {
+    ptr = first_touch_detail::aligned_malloc(bytes, first_touch_detail::cache_line_size);
+  }
+
+  if(ptr != 0)
+    first_touch(ptr, n, element_size);
+
+  return ptr;
+} // end first_touch_malloc()
+
+
+inline void first_touch_free(void *ptr)
+{
+  first_touch_detail::aligned_free(ptr);
+} // end first_touch_free()
+
+
+inline void first_touch(void *ptr, std::size_t n, std::size_t element_size)
+{
+  using thrust::detail::device::omp::detail::num_threads_for;
+  using thrust::detail::device::omp::detail::chunk_begin;
+  using thrust::detail::device::omp::detail::chunk_end;
+
+  const int num_chunks = num_threads_for(n);
+
+  // a single thread would touch the pages anyway when writing them
+  if(num_chunks < 2)
+    return;
+
+  char *bytes = static_cast<char*>(ptr);
+  const std::size_t page = first_touch_detail::page_size();
+
+// do not attempt to compile the body of this function, which calls omp functions, without
+// support from the compiler
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+# pragma omp parallel num_threads(num_chunks)
+  {
+    int thread_id = omp_get_thread_num();
+    int team_size = omp_get_num_threads();
+
+    for(int chunk = thread_id; chunk < num_chunks; chunk += team_size)
+    {
+      std::size_t first = chunk_begin(n, num_chunks, chunk) * element_size;
+      std::size_t last  = chunk_end(n, num_chunks, chunk)   * element_size;
+
+      // each page belongs to the chunk holding its first byte; the first
+      // chunk also takes the page holding the start of the array
+      std::size_t offset = (std::size_t(bytes + first) + page - 1) / page * page - std::size_t(bytes);
+      if(chunk == 0 && offset != 0)
+        bytes[0] = 0;
+
+      for(; offset < last; offset += page)
+        bytes[offset] = 0;
+    }
+  }
+#else
+  (void) bytes;
+  (void) page;
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+} // end first_touch()
+
+} // end detail
+} // end thrust
+
@@ -23,6 +23,7 @@
 #include <thrust/iterator/permutation_iterator.h>
 
 #include <thrust/copy.h>
+#include <thrust/detail/dispatch/gather.h>
 
 namespace thrust
 {
@@ -35,9 +36,16 @@ template<typename InputIterator,
                         RandomAccessIterator input_first,
                         OutputIterator       result)
 {
-  return thrust::copy(thrust::make_permutation_iterator(input_first, map_first),
-                      thrust::make_permutation_iterator(input_first, map_last),
-                      result);
+  typedef typename thrust::iterator_space<InputIterator>::type        Space1;
+  typedef typename thrust::iterator_space<RandomAccessIterator>::type Space2;
+
+  // the permuted elements live in the minimum space of the map and input
+  typedef typename thrust::detail::minimum_space<Space1,Space2>::type InputSpace;
+
+  // dispatch on space
+  return thrust::detail::dispatch::gather(map_first, map_last, input_first, result,
+    InputSpace(),
+    typename thrust::iterator_space<OutputIterator>::type());
 } // end gather()
 
 
@@ -0,0 +1,61 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file histogram.inl
+ *  \brief Inline file for histogram.h.
+ */
+
+#include <thrust/histogram.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/dispatch/histogram.h>
+
+namespace thrust
+{
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename Size,
+         typename T>
+  OutputIterator histogram_even(InputIterator first,
+                                InputIterator last,
+                                OutputIterator output,
+                                Size num_bins,
+                                T lower,
+                                T upper)
+{
+  return thrust::detail::dispatch::histogram_even(first, last, output, num_bins, lower, upper,
+    typename thrust::iterator_space<InputIterator>::type(),
+    typename thrust::iterator_space<OutputIterator>::type());
+} // end histogram_even()
+
+template<typename InputIterator,
+         typename ForwardIterator,
+         typename OutputIterator>
+  OutputIterator histogram_range(InputIterator first,
+                                 InputIterator last,
+                                 ForwardIterator levels_first,
+                                 ForwardIterator levels_last,
+                                 OutputIterator output)
+{
+  return thrust::detail::dispatch::histogram_range(first, last, levels_first, levels_last, output,
+    typename thrust::iterator_space<InputIterator>::type(),
+    typename thrust::iterator_space<ForwardIterator>::type(),
+    typename thrust::iterator_space<OutputIterator>::type());
+} // end histogram_range()
+
+} // end thrust
+
@@ -0,0 +1,63 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file histogram_bins.h
+ *  \brief Functors mapping samples to histogram bins.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+namespace thrust {
+
+namespace detail {
+
+// Maps a sample to its bin among num_bins bins of equal width dividing
+// [lower, upper), or to num_bins when the sample lies outside, so that
+// callers may count every sample into num_bins + 1 bins without a branch.
+template<typename T, typename Size>
+struct even_bin {
+    T      lower;
+    T      upper;
+    double scale;
+    Size   num_bins;
+
+    even_bin(T lower, T upper, Size num_bins)
+        : lower(lower), upper(upper),
+          scale(double(num_bins) / (double(upper) - double(lower))),
+          num_bins(num_bins) {}
+
+    template<typename Sample>
+    __host__ __device__
+    Size operator()(const Sample& x) const {
+        // written so that NaN falls outside
+        if (!(lower <= x && x < upper)) {
+            return num_bins;
+        }
+
+        Size bin = Size((double(x) - double(lower)) * scale);
+
+        // rounding may carry a sample just below upper into the next bin
+        return (bin < num_bins) ? bin : num_bins - 1;
+    }
+}; // end even_bin
+
+} // end detail
+
+} // end thrust
+
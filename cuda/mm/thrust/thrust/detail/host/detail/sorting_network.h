@@ -0,0 +1,350 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file sorting_network.h
+ *  \brief Sorting networks for ranges of at most 32 elements.
+ */
+
+#pragma once
+
+#include <thrust/detail/type_traits.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/host/detail/stable_merge_sort.h>
+
+// a network unrolls into hundreds of compare-exchanges, more than the compiler
+// inlines on its own; every step has to be inlined for the keys to stay in
+// registers
+#if defined(__GNUC__)
+#define THRUST_SORTING_NETWORK_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define THRUST_SORTING_NETWORK_INLINE __forceinline
+#else
+#define THRUST_SORTING_NETWORK_INLINE inline
+#endif
+
+namespace thrust {
+namespace detail {
+namespace host {
+namespace detail {
+
+// ranges of at most this many elements are sorted with a sorting network
+const unsigned int sorting_network_max_size = 32;
+
+// Orders keys[i] and keys[j].  Selecting through a two element array rather
+// than with a conditional keeps compilers from branching on the comparison,
+// which would mispredict about half of the time.
+template <typename T, typename StrictWeakOrdering>
+struct key_exchanger {
+    T* keys;
+    StrictWeakOrdering comp;
+
+    key_exchanger(T* keys, StrictWeakOrdering comp) : keys(keys), comp(comp) {}
+
+    THRUST_SORTING_NETWORK_INLINE void operator()(unsigned int i, unsigned int j) {
+        T pair[2] = { keys[i], keys[j] };
+        bool swap = comp(pair[1], pair[0]);
+        keys[i] = pair[swap];
+        keys[j] = pair[!swap];
+    }
+};
+
+// Orders keys[i] and keys[j] and permutes values alongside.
+template <typename T1, typename T2, typename StrictWeakOrdering>
+struct key_value_exchanger {
+    T1* keys;
+    T2* values;
+    StrictWeakOrdering comp;
+
+    key_value_exchanger(T1* keys, T2* values, StrictWeakOrdering comp) : keys(keys), values(values), comp(comp) {}
+
+    THRUST_SORTING_NETWORK_INLINE void operator()(unsigned int i, unsigned int j) {
+        T1 key_pair[2]   = { keys[i], keys[j] };
+        T2 value_pair[2] = { values[i], values[j] };
+        bool swap = comp(key_pair[1], key_pair[0]);
+        keys[i]   = key_pair[swap];
+        keys[j]   = key_pair[!swap];
+        values[i] = value_pair[swap];
+        values[j] = value_pair[!swap];
+    }
+};
+
+// Batcher's odd-even merge sort of N elements, N a power of two, unrolled by
+// the templates below into a fixed sequence of compare-exchanges:
+//
+//   for(P = 1; P < N; P *= 2)
+//     for(K = P; K > 0; K /= 2)
+//       for(J = K % P; J + K < N; J += 2 * K)
+//         for(I = 0; I < K; ++I)
+//           if((I + J) / (2 * P) == (I + J + K) / (2 * P))
+//             exchange(I + J, I + J + K);
+//
+// The same network sorts n < N elements when the remaining N - n are filled
+// with the greatest of them: an exchange only moves an element which is
+// strictly less than the other, so the padding never trades places with the
+// n elements and they end up sorted in the first n positions.
+template <unsigned int N, unsigned int P, unsigned int K, unsigned int J, unsigned int I,
+          bool Done = (I >= K || I + J + K >= N)>
+struct odd_even_merge_exchanges {
+    template <typename Exchanger>
+    THRUST_SORTING_NETWORK_INLINE static void apply(Exchanger& exchange) {
+        if ((I + J) / (2 * P) == (I + J + K) / (2 * P)) {
+            exchange(I + J, I + J + K);
+        }
+        odd_even_merge_exchanges<N, P, K, J, I + 1>::apply(exchange);
+    }
+};
+
+template <unsigned int N, unsigned int P, unsigned int K, unsigned int J, unsigned int I>
+struct odd_even_merge_exchanges<N, P, K, J, I, true> {
+    template <typename Exchanger>
+    THRUST_SORTING_NETWORK_INLINE static void apply(Exchanger&) {}
+};
+
+template <unsigned int N, unsigned int P, unsigned int K, unsigned int J,
+          bool Done = (J + K >= N)>
+struct odd_even_merge_blocks {
+    template <typename Exchanger>
+    THRUST_SORTING_NETWORK_INLINE static void apply(Exchanger& exchange) {
+        odd_even_merge_exchanges<N, P, K, J, 0>::apply(exchange);
+        odd_even_merge_blocks<N, P, K, J + 2 * K>::apply(exchange);
+    }
+};
+
+template <unsigned int N, unsigned int P, unsigned int K, unsigned int J>
+struct odd_even_merge_blocks<N, P, K, J, true> {
+    template <typename Exchanger>
+    THRUST_SORTING_NETWORK_INLINE static void apply(Exchanger&) {}
+};
+
+template <unsigned int N, unsigned int P, unsigned int K,
+          bool Done = (K == 0)>
+struct odd_even_merge_strides {
+    template <typename Exchanger>
+    THRUST_SORTING_NETWORK_INLINE static void apply(Exchanger& exchange) {
+        odd_even_merge_blocks<N, P, K, K % P>::apply(exchange);
+        odd_even_merge_strides<N, P, K / 2>::apply(exchange);
+    }
+};
+
+template <unsigned int N, unsigned int P, unsigned int K>
+struct odd_even_merge_strides<N, P, K, true> {
+    template <typename Exchanger>
+    THRUST_SORTING_NETWORK_INLINE static void apply(Exchanger&) {}
+};
+
+template <unsigned int N, unsigned int P = 1,
+          bool Done = (P >= N)>
+struct odd_even_merge_sort {
+    template <typename Exchanger>
+    THRUST_SORTING_NETWORK_INLINE static void apply(Exchanger& exchange) {
+        odd_even_merge_strides<N, P, P>::apply(exchange);
+        odd_even_merge_sort<N, 2 * P>::apply(exchange);
+    }
+};
+
+template <unsigned int N, unsigned int P>
+struct odd_even_merge_sort<N, P, true> {
+    template <typename Exchanger>
+    THRUST_SORTING_NETWORK_INLINE static void apply(Exchanger&) {}
+};
+
+// Loads 0 < n <= N elements into a local array, repeating the last of them
+// to fill it up.  Every load and every index into the array is unconditional
+// so the array stays in registers and the exchanges compile to selects.
+template <unsigned int N, unsigned int I = 0>
+struct unrolled_load {
+    template <typename InputIterator, typename T>
+    THRUST_SORTING_NETWORK_INLINE static void apply(InputIterator first, unsigned int n, T* result) {
+        result[I] = first[I < n ? I : n - 1];
+        unrolled_load<N, I + 1>::apply(first, n, result);
+    }
+};
+
+template <unsigned int N>
+struct unrolled_load<N, N> {
+    template <typename InputIterator, typename T>
+    THRUST_SORTING_NETWORK_INLINE static void apply(InputIterator, unsigned int, T*) {}
+};
+
+// stores the first n of N elements of a local array
+template <unsigned int N, unsigned int I = 0>
+struct unrolled_store {
+    template <typename T, typename OutputIterator>
+    THRUST_SORTING_NETWORK_INLINE static void apply(const T* array, unsigned int n, OutputIterator result) {
+        if (I < n) {
+            result[I] = array[I];
+            unrolled_store<N, I + 1>::apply(array, n, result);
+        }
+    }
+};
+
+template <unsigned int N>
+struct unrolled_store<N, N> {
+    template <typename T, typename OutputIterator>
+    THRUST_SORTING_NETWORK_INLINE static void apply(const T*, unsigned int, OutputIterator) {}
+};
+
+// returns the greatest element of a local array
+template <unsigned int N, unsigned int I = 1>
+struct unrolled_greatest {
+    template <typename T, typename StrictWeakOrdering>
+    THRUST_SORTING_NETWORK_INLINE static T apply(const T* array, T greatest, StrictWeakOrdering comp) {
+        greatest = comp(greatest, array[I]) ? array[I] : greatest;
+        return unrolled_greatest<N, I + 1>::apply(array, greatest, comp);
+    }
+};
+
+template <unsigned int N>
+struct unrolled_greatest<N, N> {
+    template <typename T, typename StrictWeakOrdering>
+    THRUST_SORTING_NETWORK_INLINE static T apply(const T*, T greatest, StrictWeakOrdering) {
+        return greatest;
+    }
+};
+
+// replaces the last N - n elements of a local array with value
+template <unsigned int N, unsigned int I = 0>
+struct unrolled_pad {
+    template <typename T>
+    THRUST_SORTING_NETWORK_INLINE static void apply(T* array, unsigned int n, const T& value) {
+        array[I] = I < n ? array[I] : value;
+        unrolled_pad<N, I + 1>::apply(array, n, value);
+    }
+};
+
+template <unsigned int N>
+struct unrolled_pad<N, N> {
+    template <typename T>
+    THRUST_SORTING_NETWORK_INLINE static void apply(T*, unsigned int, const T&) {}
+};
+
+// sorts 0 < n <= N elements in a local array
+template <unsigned int N>
+struct sorting_network {
+    template <typename RandomAccessIterator, typename StrictWeakOrdering>
+    static void sort(RandomAccessIterator first, unsigned int n, StrictWeakOrdering comp) {
+        typedef typename thrust::iterator_value<RandomAccessIterator>::type T;
+
+        T keys[N];
+        unrolled_load<N>::apply(first, n, keys);
+        unrolled_pad<N>::apply(keys, n, unrolled_greatest<N>::apply(keys, keys[0], comp));
+
+        key_exchanger<T, StrictWeakOrdering> exchange(keys, comp);
+        odd_even_merge_sort<N>::apply(exchange);
+
+        unrolled_store<N>::apply(keys, n, first);
+    }
+
+    template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename StrictWeakOrdering>
+    static void sort_by_key(RandomAccessIterator1 keys_first, RandomAccessIterator2 values_first, unsigned int n, StrictWeakOrdering comp) {
+        typedef typename thrust::iterator_value<RandomAccessIterator1>::type T1;
+        typedef typename thrust::iterator_value<RandomAccessIterator2>::type T2;
+
+        T1 keys[N];
+        T2 values[N];
+        unrolled_load<N>::apply(keys_first, n, keys);
+        unrolled_load<N>::apply(values_first, n, values);
+        unrolled_pad<N>::apply(keys, n, unrolled_greatest<N>::apply(keys, keys[0], comp));
+
+        key_value_exchanger<T1, T2, StrictWeakOrdering> exchange(keys, values, comp);
+        odd_even_merge_sort<N>::apply(exchange);
+
+        unrolled_store<N>::apply(keys, n, keys_first);
+        unrolled_store<N>::apply(values, n, values_first);
+    }
+};
+
+// The networks hold the range in a local array, which needs a default
+// constructible value_type.  Anything else is insertion sorted in place.
+// Ranges are rounded up to networks of 4, 8, 16 or 32 elements, which keeps
+// the number of networks instantiated per type small.
+template <typename RandomAccessIterator, typename StrictWeakOrdering>
+void small_sort(RandomAccessIterator first, RandomAccessIterator last, StrictWeakOrdering comp,
+                thrust::detail::true_type) {
+    unsigned int n = last - first;
+
+    if (n <= 1) {
+        return;
+    } else if (n <= 4) {
+        sorting_network<4>::sort(first, n, comp);
+    } else if (n <= 8) {
+        sorting_network<8>::sort(first, n, comp);
+    } else if (n <= 16) {
+        sorting_network<16>::sort(first, n, comp);
+    } else {
+        sorting_network<32>::sort(first, n, comp);
+    }
+}
+
+template <typename RandomAccessIterator, typename StrictWeakOrdering>
+void small_sort(RandomAccessIterator first, RandomAccessIterator last, StrictWeakOrdering comp,
+                thrust::detail::false_type) {
+    thrust::detail::host::detail::insertion_sort(first, last, comp);
+}
+
+template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename StrictWeakOrdering>
+void small_sort_by_key(RandomAccessIterator1 keys_first, RandomAccessIterator1 keys_last, RandomAccessIterator2 values_first, StrictWeakOrdering comp,
+                       thrust::detail::true_type) {
+    unsigned int n = keys_last - keys_first;
+
+    if (n <= 1) {
+        return;
+    } else if (n <= 4) {
+        sorting_network<4>::sort_by_key(keys_first, values_first, n, comp);
+    } else if (n <= 8) {
+        sorting_network<8>::sort_by_key(keys_first, values_first, n, comp);
+    } else if (n <= 16) {
+        sorting_network<16>::sort_by_key(keys_first, values_first, n, comp);
+    } else {
+        sorting_network<32>::sort_by_key(keys_first, values_first, n, comp);
+    }
+}
+
+template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename StrictWeakOrdering>
+void small_sort_by_key(RandomAccessIterator1 keys_first, RandomAccessIterator1 keys_last, RandomAccessIterator2 values_first, StrictWeakOrdering comp,
+                       thrust::detail::false_type) {
+    thrust::detail::host::detail::insertion_sort_by_key(keys_first, keys_last, values_first, comp);
+}
+
+// Sorts at most sorting_network_max_size elements; not stable.
+template <typename RandomAccessIterator, typename StrictWeakOrdering>
+void small_sort(RandomAccessIterator first, RandomAccessIterator last, StrictWeakOrdering comp) {
+    typedef typename thrust::iterator_value<RandomAccessIterator>::type T;
+
+    thrust::detail::host::detail::small_sort(first, last, comp,
+            typename thrust::detail::has_trivial_constructor<T>::type());
+}
+
+template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename StrictWeakOrdering>
+void small_sort_by_key(RandomAccessIterator1 keys_first, RandomAccessIterator1 keys_last, RandomAccessIterator2 values_first, StrictWeakOrdering comp) {
+    typedef typename thrust::iterator_value<RandomAccessIterator1>::type T1;
+    typedef typename thrust::iterator_value<RandomAccessIterator2>::type T2;
+
+    typedef thrust::detail::integral_constant<bool,
+            thrust::detail::has_trivial_constructor<T1>::value &&
+            thrust::detail::has_trivial_constructor<T2>::value> use_network;
+
+    thrust::detail::host::detail::small_sort_by_key(keys_first, keys_last, values_first, comp, use_network());
+}
+
+} // end namespace detail
+} // end namespace host
+} // end namespace detail
+} // end namespace thrust
+
+#undef THRUST_SORTING_NETWORK_INLINE
+
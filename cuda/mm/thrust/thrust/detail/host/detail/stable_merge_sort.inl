@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <thrust/host_vector.h>
+#include <thrust/experimental/caching_allocator.h>
 
 #include <thrust/iterator/iterator_traits.h>
 
@@ -136,8 +137,10 @@ void inplace_merge(RandomAccessIterator first,
 {
     typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
 
-    thrust::host_vector<value_type> a( first, middle);
-    thrust::host_vector<value_type> b(middle,   last);
+    typedef thrust::host_vector<value_type, thrust::experimental::caching_allocator<value_type> > temp_vector;
+
+    temp_vector a( first, middle);
+    temp_vector b(middle,   last);
 
     std::merge(a.begin(), a.end(), b.begin(), b.end(), first, comp);
 }
@@ -245,10 +248,13 @@ void inplace_merge_by_key(RandomAccessIterator1 first1,
     RandomAccessIterator2 middle2 = first2 + (middle1 - first1);
     RandomAccessIterator2 last2   = first2 + (last1   - first1);
 
-    thrust::host_vector<value_type1> lhs1( first1, middle1);
-    thrust::host_vector<value_type1> rhs1(middle1,   last1);
-    thrust::host_vector<value_type2> lhs2( first2, middle2);
-    thrust::host_vector<value_type2> rhs2(middle2,   last2);
+    typedef thrust::host_vector<value_type1, thrust::experimental::caching_allocator<value_type1> > temp_vector1;
+    typedef thrust::host_vector<value_type2, thrust::experimental::caching_allocator<value_type2> > temp_vector2;
+
+    temp_vector1 lhs1( first1, middle1);
+    temp_vector1 rhs1(middle1,   last1);
+    temp_vector2 lhs2( first2, middle2);
+    temp_vector2 rhs2(middle2,   last2);
 
     merge_by_key(lhs1.begin(), lhs1.end(), rhs1.begin(), rhs1.end(),
                  lhs2.begin(), rhs2.begin(),
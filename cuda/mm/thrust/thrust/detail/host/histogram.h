@@ -0,0 +1,104 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file histogram.h
+ *  \brief Host implementation of histogram_even and histogram_range.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/raw_buffer.h>
+#include <thrust/detail/histogram_bins.h>
+
+namespace thrust {
+
+namespace detail {
+
+namespace host {
+
+template < typename InputIterator,
+         typename OutputIterator,
+         typename Size,
+         typename T >
+OutputIterator histogram_even(InputIterator first,
+                              InputIterator last,
+                              OutputIterator output,
+                              Size num_bins,
+                              T lower,
+                              T upper) {
+    typedef typename thrust::iterator_value<OutputIterator>::type CountType;
+
+    if (num_bins <= 0) {
+        return output;
+    }
+
+    // the last bin collects the samples which fall outside
+    thrust::detail::raw_host_buffer<CountType> counts(num_bins + 1);
+    std::fill(counts.begin(), counts.end(), CountType(0));
+
+    thrust::detail::even_bin<T, Size> bin_of(lower, upper, num_bins);
+
+    for (; first != last; ++first) {
+        ++counts[bin_of(*first)];
+    }
+
+    return std::copy(counts.begin(), counts.begin() + num_bins, output);
+} // end histogram_even()
+
+template < typename InputIterator,
+         typename ForwardIterator,
+         typename OutputIterator >
+OutputIterator histogram_range(InputIterator first,
+                               InputIterator last,
+                               ForwardIterator levels_first,
+                               ForwardIterator levels_last,
+                               OutputIterator output) {
+    typedef typename thrust::iterator_value<OutputIterator>::type        CountType;
+    typedef typename thrust::iterator_difference<ForwardIterator>::type  Size;
+
+    const Size num_levels = std::distance(levels_first, levels_last);
+
+    if (num_levels < 2) {
+        return output;
+    }
+
+    const Size num_bins = num_levels - 1;
+
+    thrust::detail::raw_host_buffer<CountType> counts(num_bins);
+    std::fill(counts.begin(), counts.end(), CountType(0));
+
+    for (; first != last; ++first) {
+        // the bin is the last level not greater than the sample
+        Size level = std::distance(levels_first, std::upper_bound(levels_first, levels_last, *first));
+
+        if (level != 0 && level != num_levels) {
+            ++counts[level - 1];
+        }
+    }
+
+    return std::copy(counts.begin(), counts.end(), output);
+} // end histogram_range()
+
+} // end host
+
+} // end detail
+
+} // end thrust
+
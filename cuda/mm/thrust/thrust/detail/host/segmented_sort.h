@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file segmented_sort.h
+ *  \brief Host implementation of segmented_sort and segmented_sort_by_key.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/host/detail/stable_merge_sort.h>
+#include <thrust/detail/host/detail/sorting_network.h>
+
+namespace thrust {
+
+namespace detail {
+
+namespace host {
+
+namespace detail {
+
+// sorts one segment, with a sorting network when it is small enough
+template < typename RandomAccessIterator,
+         typename StrictWeakOrdering >
+void sort_segment(RandomAccessIterator first,
+                  RandomAccessIterator last,
+                  StrictWeakOrdering comp) {
+    if (last - first <= thrust::detail::host::detail::sorting_network_max_size) {
+        thrust::detail::host::detail::small_sort(first, last, comp);
+    } else {
+        std::sort(first, last, comp);
+    }
+} // end sort_segment()
+
+template < typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering >
+void sort_segment_by_key(RandomAccessIterator1 keys_first,
+                         RandomAccessIterator1 keys_last,
+                         RandomAccessIterator2 values_first,
+                         StrictWeakOrdering comp) {
+    if (keys_last - keys_first <= thrust::detail::host::detail::sorting_network_max_size) {
+        thrust::detail::host::detail::small_sort_by_key(keys_first, keys_last, values_first, comp);
+    } else {
+        thrust::detail::host::detail::stable_merge_sort_by_key(keys_first, keys_last, values_first, comp);
+    }
+} // end sort_segment_by_key()
+
+} // end detail
+
+template < typename RandomAccessIterator,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename StrictWeakOrdering >
+void segmented_sort(RandomAccessIterator keys_first,
+                    InputIterator1 begin_offsets_first,
+                    InputIterator1 begin_offsets_last,
+                    InputIterator2 end_offsets_first,
+                    StrictWeakOrdering comp) {
+    for (; begin_offsets_first != begin_offsets_last; ++begin_offsets_first, ++end_offsets_first) {
+        thrust::detail::host::detail::sort_segment(keys_first + *begin_offsets_first,
+                keys_first + *end_offsets_first,
+                comp);
+    }
+} // end segmented_sort()
+
+template < typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename StrictWeakOrdering >
+void segmented_sort_by_key(RandomAccessIterator1 keys_first,
+                           RandomAccessIterator2 values_first,
+                           InputIterator1 begin_offsets_first,
+                           InputIterator1 begin_offsets_last,
+                           InputIterator2 end_offsets_first,
+                           StrictWeakOrdering comp) {
+    for (; begin_offsets_first != begin_offsets_last; ++begin_offsets_first, ++end_offsets_first) {
+        thrust::detail::host::detail::sort_segment_by_key(keys_first + *begin_offsets_first,
+                keys_first + *end_offsets_first,
+                values_first + *begin_offsets_first,
+                comp);
+    }
+} // end segmented_sort_by_key()
+
+} // end host
+
+} // end detail
+
+} // end thrust
+
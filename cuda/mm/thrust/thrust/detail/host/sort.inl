@@ -22,6 +22,7 @@
 #include <thrust/detail/trivial_sequence.h>
 
 #include <thrust/detail/host/detail/stable_merge_sort.h>
+#include <thrust/detail/host/detail/sorting_network.h>
 
 #include <algorithm>
 
@@ -38,6 +39,13 @@ template<typename RandomAccessIterator,
             RandomAccessIterator last,
             StrictWeakOrdering comp)
 {
+    // tiny ranges are sorted in place with a sorting network
+    if(last - first <= thrust::detail::host::detail::sorting_network_max_size)
+    {
+        thrust::detail::host::detail::small_sort(first, last, comp);
+        return;
+    }
+
     // ensure sequence has trivial iterators
     thrust::detail::trivial_sequence<RandomAccessIterator> keys(first, last);
  
@@ -55,6 +63,13 @@ template<typename RandomAccessIterator,
                    RandomAccessIterator last,
                    StrictWeakOrdering comp)
 {
+    // tiny ranges are insertion sorted in place
+    if(last - first <= thrust::detail::host::detail::sorting_network_max_size)
+    {
+        thrust::detail::host::detail::insertion_sort(first, last, comp);
+        return;
+    }
+
     // ensure sequence has trivial iterators
     thrust::detail::trivial_sequence<RandomAccessIterator> keys(first, last);
 
@@ -86,6 +101,13 @@ template<typename RandomAccessIterator1,
                           RandomAccessIterator2 values_first,
                           StrictWeakOrdering comp)
 {
+    // tiny ranges are insertion sorted in place
+    if(keys_last - keys_first <= thrust::detail::host::detail::sorting_network_max_size)
+    {
+        thrust::detail::host::detail::insertion_sort_by_key(keys_first, keys_last, values_first, comp);
+        return;
+    }
+
     // ensure sequences have trivial iterators
     RandomAccessIterator2 values_last = values_first + (keys_last - keys_first);
     thrust::detail::trivial_sequence<RandomAccessIterator1> keys(keys_first, keys_last);
@@ -0,0 +1,138 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file memory_pool.h
+ *  \brief A thread-safe, size-class caching pool for host memory.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/mutex.h>
+#include <cstddef>
+
+namespace thrust {
+namespace detail {
+
+// Requests up to 2^max_thread_cached_class bytes are rounded up to a power
+// of two, with the header kept outside the rounded size, and cached on free
+// instead of being returned to the system.  Each thread keeps a small private
+// cache of recently freed blocks; the rest go to a central cache shared by
+// all threads, up to max_central_cached_bytes, past which they are freed.
+// Larger requests go straight to malloc and free: rounding them would waste
+// up to half the block, and caching them would pin the footprint of the
+// largest problem ever run.  Cached memory goes back to the system through
+// trim().
+class memory_pool {
+public:
+    // smallest block holds 2^min_size_class bytes
+    static const unsigned int min_size_class = 6;
+
+    // requests up to 2^max_thread_cached_class bytes are pooled
+    static const unsigned int max_thread_cached_class = 20;
+
+    // per size class limit of a thread cache
+    static const std::size_t max_thread_cached_blocks = 4;
+
+    // limit of the central cache, headers included
+    static const std::size_t max_central_cached_bytes = std::size_t(64) << 20;
+
+    static const unsigned int num_size_classes = 8 * sizeof(std::size_t);
+
+    // bytes in front of every block; keeps the user pointer 16-byte aligned
+    static const std::size_t header_size = 16;
+
+    // allocates at least num_bytes bytes; throws std::bad_alloc on failure
+    inline void* allocate(std::size_t num_bytes);
+
+    // returns a block obtained from allocate() to the cache
+    inline void deallocate(void* ptr);
+
+    // releases every cached block back to the system
+    inline void trim(void);
+
+    // bytes currently obtained from the system, cached or in use
+    inline std::size_t bytes_reserved(void);
+
+    // bytes currently sitting in caches
+    inline std::size_t bytes_cached(void);
+
+    // largest value bytes_reserved() has reached
+    inline std::size_t high_water_mark(void);
+
+    // the process-wide pool
+    inline static memory_pool& instance(void);
+
+private:
+    // size_class of the blocks which bypass the caches
+    static const unsigned int large_size_class = num_size_classes;
+
+    struct block {
+        unsigned int size_class;
+        union {
+            block* next;       // while cached
+            std::size_t size;  // of a large block, header included
+        };
+    };
+
+    // bytes obtained from the system for a block of size class k
+    inline static std::size_t block_bytes(unsigned int k);
+
+    struct free_list {
+        block* head;
+        std::size_t count;
+    };
+
+    struct thread_cache {
+        mutex lock;
+        free_list lists[num_size_classes];
+        thread_cache* next;
+    };
+
+    inline memory_pool(void);
+
+    inline thread_cache* local_cache(void);
+
+    inline static void retire_thread_cache(void* cache);
+
+    inline std::size_t release(free_list& list);
+
+    // caches b centrally, or frees it once the central cache is full;
+    // the caller holds m_lock
+    inline void cache_central(block* b);
+
+    mutex m_lock;
+    free_list m_central[num_size_classes];
+    thread_cache* m_caches;
+    thread_cache* m_retired;
+    std::size_t m_bytes_reserved;
+    std::size_t m_central_bytes;
+    std::size_t m_high_water_mark;
+    thread_local_pointer m_local_cache;
+
+    // the pool is never destroyed
+    ~memory_pool(void);
+    memory_pool(const memory_pool&);
+    memory_pool& operator=(const memory_pool&);
+}; // end memory_pool
+
+} // end namespace detail
+} // end namespace thrust
+
+#include <thrust/detail/memory_pool.inl>
+
@@ -0,0 +1,368 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <thrust/detail/memory_pool.h>
+#include <cstdlib>
+#include <new>
+
+namespace thrust
+{
+namespace detail
+{
+
+memory_pool
+  ::memory_pool(void)
+    : m_caches(0),
+      m_retired(0),
+      m_bytes_reserved(0),
+      m_central_bytes(0),
+      m_high_water_mark(0),
+      m_local_cache(&memory_pool::retire_thread_cache)
+{
+  for(unsigned int k = 0; k < num_size_classes; ++k)
+  {
+    m_central[k].head  = 0;
+    m_central[k].count = 0;
+  }
+} // end memory_pool::memory_pool()
+
+
+std::size_t memory_pool
+  ::block_bytes(unsigned int k)
+{
+  return (std::size_t(1) << k) + header_size;
+} // end memory_pool::block_bytes()
+
+
+memory_pool &memory_pool
+  ::instance(void)
+{
+  // leaked deliberately: containers with static storage may free into the
+  // pool after any static pool object would have been destroyed
+  static memory_pool *pool = new memory_pool;
+  return *pool;
+} // end memory_pool::instance()
+
+
+memory_pool::thread_cache *memory_pool
+  ::local_cache(void)
+{
+  thread_cache *cache = static_cast<thread_cache*>(m_local_cache.get());
+
+  if(cache == 0)
+  {
+    scoped_lock guard(m_lock);
+
+    // reuse the cache of a thread which has exited
+    if(m_retired != 0)
+    {
+      cache = m_retired;
+      m_retired = cache->next;
+    }
+    else
+    {
+      cache = new thread_cache;
+
+      for(unsigned int k = 0; k < num_size_classes; ++k)
+      {
+        cache->lists[k].head  = 0;
+        cache->lists[k].count = 0;
+      }
+    }
+
+    cache->next = m_caches;
+    m_caches = cache;
+
+    m_local_cache.set(cache);
+  }
+
+  return cache;
+} // end memory_pool::local_cache()
+
+
+void memory_pool
+  ::retire_thread_cache(void *ptr)
+{
+  memory_pool &pool = instance();
+  thread_cache *cache = static_cast<thread_cache*>(ptr);
+
+  scoped_lock guard(pool.m_lock);
+
+  // hand the exiting thread's blocks to the central cache
+  {
+    scoped_lock cache_guard(cache->lock);
+
+    for(unsigned int k = 0; k < num_size_classes; ++k)
+    {
+      while(cache->lists[k].head != 0)
+      {
+        block *b = cache->lists[k].head;
+        cache->lists[k].head = b->next;
+
+        pool.cache_central(b);
+      }
+      cache->lists[k].count = 0;
+    }
+  }
+
+  // unlink from the live caches and park it for the next new thread
+  thread_cache **link = &pool.m_caches;
+  while(*link != cache)
+    link = &(*link)->next;
+  *link = cache->next;
+
+  cache->next = pool.m_retired;
+  pool.m_retired = cache;
+} // end memory_pool::retire_thread_cache()
+
+
+void *memory_pool
+  ::allocate(std::size_t num_bytes)
+{
+  // large requests bypass the caches
+  if(num_bytes > (std::size_t(1) << max_thread_cached_class))
+  {
+    if(num_bytes > std::size_t(-1) - header_size)
+      throw std::bad_alloc();
+
+    std::size_t size = num_bytes + header_size;
+
+    void *raw = std::malloc(size);
+    if(raw == 0)
+    {
+      trim();
+      raw = std::malloc(size);
+    }
+
+    if(raw == 0)
+      throw std::bad_alloc();
+
+    block *b = static_cast<block*>(raw);
+    b->size_class = large_size_class;
+    b->size = size;
+
+    scoped_lock guard(m_lock);
+    m_bytes_reserved += size;
+    if(m_bytes_reserved > m_high_water_mark)
+      m_high_water_mark = m_bytes_reserved;
+
+    return reinterpret_cast<char*>(b) + header_size;
+  }
+
+  // find the size class; the header is not part of it
+  unsigned int k = min_size_class;
+  while((std::size_t(1) << k) < num_bytes)
+    ++k;
+
+  block *b = 0;
+
+  // try the thread cache
+  {
+    thread_cache *cache = local_cache();
+    scoped_lock guard(cache->lock);
+
+    free_list &list = cache->lists[k];
+    if(list.head != 0)
+    {
+      b = list.head;
+      list.head = b->next;
+      --list.count;
+    }
+  }
+
+  // try the central cache
+  if(b == 0)
+  {
+    scoped_lock guard(m_lock);
+
+    free_list &list = m_central[k];
+    if(list.head != 0)
+    {
+      b = list.head;
+      list.head = b->next;
+      --list.count;
+      m_central_bytes -= block_bytes(k);
+    }
+  }
+
+  // go to the system, trimming the caches once if it refuses
+  if(b == 0)
+  {
+    std::size_t size = block_bytes(k);
+
+    void *raw = std::malloc(size);
+    if(raw == 0)
+    {
+      trim();
+      raw = std::malloc(size);
+    }
+
+    if(raw == 0)
+      throw std::bad_alloc();
+
+    b = static_cast<block*>(raw);
+    b->size_class = k;
+
+    scoped_lock guard(m_lock);
+    m_bytes_reserved += size;
+    if(m_bytes_reserved > m_high_water_mark)
+      m_high_water_mark = m_bytes_reserved;
+  }
+
+  return reinterpret_cast<char*>(b) + header_size;
+} // end memory_pool::allocate()
+
+
+void memory_pool
+  ::deallocate(void *ptr)
+{
+  if(ptr == 0) return;
+
+  block *b = reinterpret_cast<block*>(static_cast<char*>(ptr) - header_size);
+  unsigned int k = b->size_class;
+
+  if(k == large_size_class)
+  {
+    std::size_t size = b->size;
+    std::free(b);
+
+    scoped_lock guard(m_lock);
+    m_bytes_reserved -= size;
+    return;
+  }
+
+  // keep blocks close to the thread which freed them
+  {
+    thread_cache *cache = local_cache();
+    scoped_lock guard(cache->lock);
+
+    free_list &list = cache->lists[k];
+    if(list.count < max_thread_cached_blocks)
+    {
+      b->next = list.head;
+      list.head = b;
+      ++list.count;
+      return;
+    }
+  }
+
+  scoped_lock guard(m_lock);
+  cache_central(b);
+} // end memory_pool::deallocate()
+
+
+void memory_pool
+  ::cache_central(block *b)
+{
+  unsigned int k = b->size_class;
+  std::size_t size = block_bytes(k);
+
+  if(m_central_bytes + size > max_central_cached_bytes)
+  {
+    std::free(b);
+    m_bytes_reserved -= size;
+    return;
+  }
+
+  b->next = m_central[k].head;
+  m_central[k].head = b;
+  ++m_central[k].count;
+  m_central_bytes += size;
+} // end memory_pool::cache_central()
+
+
+std::size_t memory_pool
+  ::release(free_list &list)
+{
+  std::size_t result = 0;
+
+  while(list.head != 0)
+  {
+    block *b = list.head;
+    list.head = b->next;
+
+    result += block_bytes(b->size_class);
+    std::free(b);
+  }
+
+  list.count = 0;
+
+  return result;
+} // end memory_pool::release()
+
+
+void memory_pool
+  ::trim(void)
+{
+  scoped_lock guard(m_lock);
+
+  std::size_t released = 0;
+
+  for(unsigned int k = 0; k < num_size_classes; ++k)
+    released += release(m_central[k]);
+
+  for(thread_cache *cache = m_caches; cache != 0; cache = cache->next)
+  {
+    scoped_lock cache_guard(cache->lock);
+
+    for(unsigned int k = 0; k < num_size_classes; ++k)
+      released += release(cache->lists[k]);
+  }
+
+  m_bytes_reserved -= released;
+  m_central_bytes = 0;
+} // end memory_pool::trim()
+
+
+std::size_t memory_pool
+  ::bytes_reserved(void)
+{
+  scoped_lock guard(m_lock);
+  return m_bytes_reserved;
+} // end memory_pool::bytes_reserved()
+
+
+std::size_t memory_pool
+  ::bytes_cached(void)
+{
+  scoped_lock guard(m_lock);
+
+  std::size_t result = m_central_bytes;
+
+  for(thread_cache *cache = m_caches; cache != 0; cache = cache->next)
+  {
+    scoped_lock cache_guard(cache->lock);
+
+    for(unsigned int k = 0; k < num_size_classes; ++k)
+      result += cache->lists[k].count * block_bytes(k);
+  }
+
+  return result;
+} // end memory_pool::bytes_cached()
+
+
+std::size_t memory_pool
+  ::high_water_mark(void)
+{
+  scoped_lock guard(m_lock);
+  return m_high_water_mark;
+} // end memory_pool::high_water_mark()
+
+} // end detail
+
+} // end thrust
+
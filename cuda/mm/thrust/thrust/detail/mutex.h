@@ -0,0 +1,172 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file mutex.h
+ *  \brief Minimal mutex, condition variable and thread-local slot
+ *         wrappers over the native threading API.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif // THRUST_HOST_COMPILER
+
+namespace thrust {
+namespace detail {
+
+class mutex {
+public:
+    inline mutex();
+
+    inline ~mutex();
+
+    inline void lock();
+
+    inline void unlock();
+
+private:
+#if THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC
+    CRITICAL_SECTION m_impl;
+#else
+    pthread_mutex_t m_impl;
+#endif // THRUST_HOST_COMPILER
+
+    friend class condition_variable;
+
+    // disallow copy and assignment
+    mutex(const mutex&);
+    mutex& operator=(const mutex&);
+}; // end mutex
+
+
+class scoped_lock {
+public:
+    explicit scoped_lock(mutex& m) : m_mutex(m) { m_mutex.lock(); }
+
+    ~scoped_lock() { m_mutex.unlock(); }
+
+private:
+    mutex& m_mutex;
+
+    // disallow copy and assignment
+    scoped_lock(const scoped_lock&);
+    scoped_lock& operator=(const scoped_lock&);
+}; // end scoped_lock
+
+
+class condition_variable {
+public:
+    inline condition_variable();
+
+    inline ~condition_variable();
+
+    // atomically releases m and blocks; m is held again on return
+    inline void wait(mutex& m);
+
+    inline void notify_one();
+
+    inline void notify_all();
+
+private:
+#if THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC
+    CONDITION_VARIABLE m_impl;
+#else
+    pthread_cond_t m_impl;
+#endif // THRUST_HOST_COMPILER
+
+    // disallow copy and assignment
+    condition_variable(const condition_variable&);
+    condition_variable& operator=(const condition_variable&);
+}; // end condition_variable
+
+
+// a per-thread pointer slot; the destructor, if any, runs with the slot's
+// value when a thread that set a non-null value exits (POSIX only)
+class thread_local_pointer {
+public:
+    inline explicit thread_local_pointer(void (*destructor)(void*) = 0);
+
+    inline ~thread_local_pointer();
+
+    inline void* get() const;
+
+    inline void set(void* value);
+
+private:
+#if THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC
+    DWORD m_key;
+#else
+    pthread_key_t m_key;
+#endif // THRUST_HOST_COMPILER
+
+    // disallow copy and assignment
+    thread_local_pointer(const thread_local_pointer&);
+    thread_local_pointer& operator=(const thread_local_pointer&);
+}; // end thread_local_pointer
+
+
+#if THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC
+
+mutex::mutex()                 { InitializeCriticalSection(&m_impl); }
+mutex::~mutex()                { DeleteCriticalSection(&m_impl); }
+void mutex::lock()             { EnterCriticalSection(&m_impl); }
+void mutex::unlock()           { LeaveCriticalSection(&m_impl); }
+
+condition_variable::condition_variable()  { InitializeConditionVariable(&m_impl); }
+condition_variable::~condition_variable() {}
+void condition_variable::wait(mutex& m)   { SleepConditionVariableCS(&m_impl, &m.m_impl, INFINITE); }
+void condition_variable::notify_one()     { WakeConditionVariable(&m_impl); }
+void condition_variable::notify_all()     { WakeAllConditionVariable(&m_impl); }
+
+// XXX TLS slots have no destructor hook on Windows
+thread_local_pointer::thread_local_pointer(void (*)(void*)) : m_key(TlsAlloc()) {}
+thread_local_pointer::~thread_local_pointer() { TlsFree(m_key); }
+void* thread_local_pointer::get() const       { return TlsGetValue(m_key); }
+void thread_local_pointer::set(void* value)   { TlsSetValue(m_key, value); }
+
+#else
+
+mutex::mutex()                 { pthread_mutex_init(&m_impl, 0); }
+mutex::~mutex()                { pthread_mutex_destroy(&m_impl); }
+void mutex::lock()             { pthread_mutex_lock(&m_impl); }
+void mutex::unlock()           { pthread_mutex_unlock(&m_impl); }
+
+condition_variable::condition_variable()  { pthread_cond_init(&m_impl, 0); }
+condition_variable::~condition_variable() { pthread_cond_destroy(&m_impl); }
+void condition_variable::wait(mutex& m)   { pthread_cond_wait(&m_impl, &m.m_impl); }
+void condition_variable::notify_one()     { pthread_cond_signal(&m_impl); }
+void condition_variable::notify_all()     { pthread_cond_broadcast(&m_impl); }
+
+thread_local_pointer::thread_local_pointer(void (*destructor)(void*)) { pthread_key_create(&m_key, destructor); }
+thread_local_pointer::~thread_local_pointer() { pthread_key_delete(m_key); }
+void* thread_local_pointer::get() const       { return pthread_getspecific(m_key); }
+void thread_local_pointer::set(void* value)   { pthread_setspecific(m_key, value); }
+
+#endif // THRUST_HOST_COMPILER
+
+} // end namespace detail
+} // end namespace thrust
+
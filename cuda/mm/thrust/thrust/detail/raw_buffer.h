@@ -21,6 +21,7 @@
 #pragma once
 
 #include <thrust/detail/device/internal_allocator.h>
+#include <thrust/experimental/caching_allocator.h>
 #include <thrust/iterator/detail/normal_iterator.h>
 #include <thrust/iterator/iterator_traits.h>
 #include <memory>
@@ -47,7 +48,8 @@ struct choose_raw_buffer_allocator
         // XXX this check is technically incorrect: any could convert to host
         is_convertible<Space, thrust::host_space_tag>::value,
 
-        identity_< std::allocator<T> >,
+        // temporaries are short-lived and frequent, so draw them from the cache
+        identity_< thrust::experimental::caching_allocator<T> >,
 
         // XXX add backend-specific allocators here?
 
@@ -0,0 +1,90 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file thread_pool.h
+ *  \brief A process-wide pool of host worker threads.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/mutex.h>
+#include <cstddef>
+
+namespace thrust {
+namespace detail {
+
+// A fixed set of detached worker threads pulling tasks from a FIFO queue.
+// Workers start on the first submit() and live until the process exits.
+// Each task runs its OpenMP regions with the processors split evenly among
+// the tasks running when it starts, so P concurrent tasks share P cores
+// instead of starting P full teams.
+class thread_pool {
+public:
+    // a unit of work; the pool deletes it after run() returns
+    struct task {
+        task() : next(0) {}
+
+        virtual ~task() {}
+
+        virtual void run() = 0;
+
+        task* next;
+    }; // end task
+
+    // queues t for execution; takes ownership of t
+    inline void submit(task* t);
+
+    // number of worker threads
+    inline std::size_t size(void) const;
+
+    // the process-wide pool, sized to the number of processors
+    inline static thread_pool& instance(void);
+
+private:
+    inline explicit thread_pool(std::size_t num_threads);
+
+    inline void start(void);
+
+    inline void work(void);
+
+#if THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC
+    inline static unsigned long __stdcall worker(void* pool);
+#else
+    inline static void* worker(void* pool);
+#endif // THRUST_HOST_COMPILER
+
+    mutex m_lock;
+    condition_variable m_not_empty;
+    task* m_head;
+    task* m_tail;
+    std::size_t m_num_threads;
+    std::size_t m_num_running;
+    bool m_started;
+
+    // the pool is never destroyed
+    ~thread_pool(void);
+    thread_pool(const thread_pool&);
+    thread_pool& operator=(const thread_pool&);
+}; // end thread_pool
+
+} // end namespace detail
+} // end namespace thrust
+
+#include <thrust/detail/thread_pool.inl>
+
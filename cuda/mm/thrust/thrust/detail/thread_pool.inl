@@ -0,0 +1,182 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file thread_pool.inl
+ *  \brief Inline file for thread_pool.h.
+ */
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <thrust/detail/thread_pool.h>
+#include <new>
+
+#if THRUST_HOST_COMPILER != THRUST_HOST_COMPILER_MSVC
+#include <unistd.h>
+#endif // THRUST_HOST_COMPILER
+
+namespace thrust
+{
+namespace detail
+{
+
+thread_pool
+  ::thread_pool(std::size_t num_threads)
+    : m_head(0),
+      m_tail(0),
+      m_num_threads(num_threads < 2 ? 2 : num_threads),
+      m_num_running(0),
+      m_started(false)
+{
+  ;
+} // end thread_pool::thread_pool()
+
+
+thread_pool &thread_pool
+  ::instance(void)
+{
+  long num_processors = 0;
+
+#if THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  num_processors = info.dwNumberOfProcessors;
+#else
+  num_processors = sysconf(_SC_NPROCESSORS_ONLN);
+#endif // THRUST_HOST_COMPILER
+
+  // leaked deliberately: workers may still be waiting on the queue at exit
+  static thread_pool *pool = new thread_pool(num_processors > 0 ? num_processors : 1);
+  return *pool;
+} // end thread_pool::instance()
+
+
+std::size_t thread_pool
+  ::size(void) const
+{
+  return m_num_threads;
+} // end thread_pool::size()
+
+
+void thread_pool
+  ::start(void)
+{
+  for(std::size_t i = 0; i < m_num_threads; ++i)
+  {
+#if THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC
+    HANDLE handle = CreateThread(0, 0, &thread_pool::worker, this, 0, 0);
+    if(handle == 0)
+      throw std::bad_alloc();
+    CloseHandle(handle);
+#else
+    pthread_t thread;
+    if(pthread_create(&thread, 0, &thread_pool::worker, this) != 0)
+      throw std::bad_alloc();
+    pthread_detach(thread);
+#endif // THRUST_HOST_COMPILER
+  }
+
+  m_started = true;
+} // end thread_pool::start()
+
+
+void thread_pool
+  ::submit(task *t)
+{
+  scoped_lock guard(m_lock);
+
+  if(!m_started)
+    start();
+
+  t->next = 0;
+
+  if(m_tail != 0)
+    m_tail->next = t;
+  else
+    m_head = t;
+
+  m_tail = t;
+
+  m_not_empty.notify_one();
+} // end thread_pool::submit()
+
+
+void thread_pool
+  ::work(void)
+{
+  while(true)
+  {
+    task *t = 0;
+    std::size_t team_size = 1;
+
+    {
+      scoped_lock guard(m_lock);
+
+      while(m_head == 0)
+        m_not_empty.wait(m_lock);
+
+      t = m_head;
+      m_head = t->next;
+      if(m_head == 0)
+        m_tail = 0;
+
+      // this thread's share of the processors
+      ++m_num_running;
+      team_size = m_num_threads / m_num_running;
+      if(team_size < 1)
+        team_size = 1;
+    }
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    // sets this thread's default team size only
+    omp_set_num_threads(static_cast<int>(team_size));
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+    t->run();
+    delete t;
+
+    {
+      scoped_lock guard(m_lock);
+      --m_num_running;
+    }
+  }
+} // end thread_pool::work()
+
+
+#if THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC
+unsigned long __stdcall thread_pool
+  ::worker(void *pool)
+{
+  static_cast<thread_pool*>(pool)->work();
+  return 0;
+} // end thread_pool::worker()
+#else
+void *thread_pool
+  ::worker(void *pool)
+{
+  static_cast<thread_pool*>(pool)->work();
+  return 0;
+} // end thread_pool::worker()
+#endif // THRUST_HOST_COMPILER
+
+} // end detail
+
+} // end thrust
+
@@ -22,10 +22,109 @@
 #include <thrust/reduce.h>
 
 #include <thrust/iterator/transform_iterator.h>
+#include <thrust/tuple.h>
 
 namespace thrust
 {
 
+namespace detail
+{
+
+// elementwise application of tuples of functions, one element at a time
+template<int I, int N>
+struct multi_reduce_elements
+{
+  template<typename UnaryFunctionTuple, typename OutputTuple, typename InputType>
+  __host__ __device__
+  static void transform(const UnaryFunctionTuple &unary_ops, OutputTuple &result, const InputType &x)
+  {
+    thrust::get<I>(result) = thrust::get<I>(unary_ops)(x);
+    multi_reduce_elements<I + 1, N>::transform(unary_ops, result, x);
+  }
+
+  template<typename BinaryFunctionTuple, typename OutputTuple>
+  __host__ __device__
+  static void reduce(const BinaryFunctionTuple &binary_ops, OutputTuple &result, const OutputTuple &a, const OutputTuple &b)
+  {
+    thrust::get<I>(result) = thrust::get<I>(binary_ops)(thrust::get<I>(a), thrust::get<I>(b));
+    multi_reduce_elements<I + 1, N>::reduce(binary_ops, result, a, b);
+  }
+
+  template<typename OutputTuple>
+  __host__ __device__
+  static void sum(OutputTuple &result, const OutputTuple &a, const OutputTuple &b)
+  {
+    thrust::get<I>(result) = thrust::get<I>(a) + thrust::get<I>(b);
+    multi_reduce_elements<I + 1, N>::sum(result, a, b);
+  }
+}; // end multi_reduce_elements
+
+template<int N>
+struct multi_reduce_elements<N, N>
+{
+  template<typename UnaryFunctionTuple, typename OutputTuple, typename InputType>
+  __host__ __device__
+  static void transform(const UnaryFunctionTuple &, OutputTuple &, const InputType &) {}
+
+  template<typename BinaryFunctionTuple, typename OutputTuple>
+  __host__ __device__
+  static void reduce(const BinaryFunctionTuple &, OutputTuple &, const OutputTuple &, const OutputTuple &) {}
+
+  template<typename OutputTuple>
+  __host__ __device__
+  static void sum(OutputTuple &, const OutputTuple &, const OutputTuple &) {}
+}; // end multi_reduce_elements
+
+// applies every function of a tuple to one element
+template<typename UnaryFunctionTuple, typename OutputTuple>
+struct multi_transform_functor
+{
+  UnaryFunctionTuple unary_ops;
+
+  multi_transform_functor(UnaryFunctionTuple unary_ops) : unary_ops(unary_ops) {}
+
+  template<typename InputType>
+  __host__ __device__
+  OutputTuple operator()(const InputType &x) const
+  {
+    OutputTuple result;
+    multi_reduce_elements<0, thrust::tuple_size<OutputTuple>::value>::transform(unary_ops, result, x);
+    return result;
+  }
+}; // end multi_transform_functor
+
+// combines two tuples of partial results elementwise
+template<typename BinaryFunctionTuple, typename OutputTuple>
+struct multi_reduce_functor
+{
+  BinaryFunctionTuple binary_ops;
+
+  multi_reduce_functor(BinaryFunctionTuple binary_ops) : binary_ops(binary_ops) {}
+
+  __host__ __device__
+  OutputTuple operator()(const OutputTuple &a, const OutputTuple &b) const
+  {
+    OutputTuple result;
+    multi_reduce_elements<0, thrust::tuple_size<OutputTuple>::value>::reduce(binary_ops, result, a, b);
+    return result;
+  }
+}; // end multi_reduce_functor
+
+// adds two tuples of partial results elementwise
+template<typename OutputTuple>
+struct multi_plus_functor
+{
+  __host__ __device__
+  OutputTuple operator()(const OutputTuple &a, const OutputTuple &b) const
+  {
+    OutputTuple result;
+    multi_reduce_elements<0, thrust::tuple_size<OutputTuple>::value>::sum(result, a, b);
+    return result;
+  }
+}; // end multi_plus_functor
+
+} // end namespace detail
+
 template<typename InputIterator, 
          typename UnaryFunction, 
          typename OutputType,
@@ -42,5 +141,36 @@ template<typename InputIterator,
     return thrust::reduce(_first, _last, init, binary_op);
 }
 
+template<typename InputIterator,
+         typename UnaryFunctionTuple,
+         typename OutputTuple,
+         typename BinaryFunctionTuple>
+  OutputTuple multi_transform_reduce(InputIterator first,
+                                     InputIterator last,
+                                     UnaryFunctionTuple unary_ops,
+                                     OutputTuple init,
+                                     BinaryFunctionTuple binary_ops)
+{
+    // one transformed reduction whose values are tuples
+    return thrust::transform_reduce(first, last,
+                                    detail::multi_transform_functor<UnaryFunctionTuple, OutputTuple>(unary_ops),
+                                    init,
+                                    detail::multi_reduce_functor<BinaryFunctionTuple, OutputTuple>(binary_ops));
+}
+
+template<typename InputIterator,
+         typename UnaryFunctionTuple,
+         typename OutputTuple>
+  OutputTuple multi_transform_reduce(InputIterator first,
+                                     InputIterator last,
+                                     UnaryFunctionTuple unary_ops,
+                                     OutputTuple init)
+{
+    return thrust::transform_reduce(first, last,
+                                    detail::multi_transform_functor<UnaryFunctionTuple, OutputTuple>(unary_ops),
+                                    init,
+                                    detail::multi_plus_functor<OutputTuple>());
+}
+
 } // end namespace thrust
 
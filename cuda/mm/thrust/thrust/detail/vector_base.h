@@ -27,6 +27,7 @@
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/type_traits.h>
 #include <thrust/utility.h>
+#include <thrust/experimental/default_init_allocator.h>
 #include <vector>
 
 namespace thrust {
@@ -60,12 +61,19 @@ public:
     __host__
     vector_base(void* p, size_type n);
 
+    /*! This constructor creates a vector_base with default-valued
+     *  elements.  They are left uninitialized when the allocator is a
+     *  \p default_init_allocator and value_type is trivially constructible.
+     *  \param n The number of elements to initially create.
+     */
+    explicit vector_base(size_type n);
+
     /*! This constructor creates a vector_base with copies
      *  of an exemplar element.
      *  \param n The number of elements to initially create.
      *  \param value An element to copy.
      */
-    explicit vector_base(size_type n, const value_type& value = value_type());
+    explicit vector_base(size_type n, const value_type& value);
 
     /*! Copy constructor copies from an exemplar vector_base.
      *  \param v The vector_base to copy.
@@ -130,7 +138,28 @@ public:
      *  size this vector_base is truncated, otherwise this vector_base is
      *  extended and new elements are populated with given data.
      */
-    void resize(size_type new_size, value_type x = value_type());
+    void resize(size_type new_size, value_type x);
+
+    /*! \brief Resizes this vector_base to the specified number of elements.
+     *  \param new_size Number of elements this vector_base should contain.
+     *  \throw std::length_error If n exceeds max_size().
+     *
+     *  This method behaves like resize(new_size, value_type()), except that
+     *  new elements are left uninitialized when the allocator is a
+     *  \p default_init_allocator and value_type is trivially constructible.
+     */
+    void resize(size_type new_size);
+
+    /*! \brief Resizes this vector_base to the specified number of elements
+     *         without initializing new elements.
+     *  \param new_size Number of elements this vector_base should contain.
+     *  \throw std::length_error If n exceeds max_size().
+     *
+     *  This method behaves like resize() except that the new elements are
+     *  left uninitialized, which saves a pass over memory the caller is
+     *  about to overwrite.  value_type must have a trivial constructor.
+     */
+    void uninitialized_resize(size_type new_size);
 
     /*! Returns the number of elements in this vector_base.
      */
@@ -403,6 +432,15 @@ private:
 
     void fill_init(size_type n, const T& x);
 
+    // whether elements created without an exemplar are left uninitialized
+    typedef integral_constant<bool,
+            is_default_init_allocator<Alloc>::value &&
+            has_trivial_constructor<value_type>::value> default_initializes;
+
+    void default_resize(size_type new_size, true_type);
+
+    void default_resize(size_type new_size, false_type);
+
     // these methods resolve the ambiguity of the insert() template of form (iterator, InputIterator, InputIterator)
     template<typename InputIteratorOrIntegralType>
     void insert_dispatch(iterator position, InputIteratorOrIntegralType first, InputIteratorOrIntegralType last, false_type);
@@ -29,6 +29,7 @@
 #include <thrust/advance.h>
 #include <thrust/detail/destroy.h>
 #include <thrust/detail/type_traits.h>
+#include <thrust/detail/static_assert.h>
 
 #include <algorithm>
 #include <stdexcept>
@@ -55,6 +56,17 @@ template<typename T, typename Alloc>
   ;
 } // end vector_base::vector_base()
 
+template<typename T, typename Alloc>
+  vector_base<T,Alloc>
+    ::vector_base(size_type n)
+      :mBegin(pointer(static_cast<T*>(0))),
+       mSize(0),
+       mCapacity(0),
+       mAllocator()
+{
+  default_resize(n, default_initializes());
+} // end vector_base::vector_base()
+
 template<typename T, typename Alloc>
   vector_base<T,Alloc>
     ::vector_base(size_type n, const value_type &value)
@@ -235,6 +247,55 @@ template<typename T, typename Alloc>
     insert(end(), new_size - size(), x);
 } // end vector_base::resize()
 
+template<typename T, typename Alloc>
+  void vector_base<T,Alloc>
+    ::resize(size_type new_size)
+{
+  default_resize(new_size, default_initializes());
+} // end vector_base::resize()
+
+template<typename T, typename Alloc>
+  void vector_base<T,Alloc>
+    ::default_resize(size_type new_size, true_type)
+{
+  uninitialized_resize(new_size);
+} // end vector_base::default_resize()
+
+template<typename T, typename Alloc>
+  void vector_base<T,Alloc>
+    ::default_resize(size_type new_size, false_type)
+{
+  resize(new_size, value_type());
+} // end vector_base::default_resize()
+
+template<typename T, typename Alloc>
+  void vector_base<T,Alloc>
+    ::uninitialized_resize(size_type new_size)
+{
+  // leaving the new elements unconstructed is only valid for trivial types
+  THRUST_STATIC_ASSERT(thrust::detail::has_trivial_constructor<T>::value);
+
+  if(new_size < size())
+  {
+    erase(begin() + new_size, end());
+  } // end if
+  else if(new_size > size())
+  {
+    if(new_size > max_size())
+    {
+      throw std::length_error("uninitialized_resize(): new_size exceeds max_size().");
+    } // end if
+
+    if(new_size > capacity())
+    {
+      // grow exponentially, as insert() does
+      reserve(std::min<size_type>(std::max<size_type>(new_size, 2 * capacity()), max_size()));
+    } // end if
+
+    mSize = new_size;
+  } // end else if
+} // end vector_base::uninitialized_resize()
+
 template<typename T, typename Alloc>
   typename vector_base<T,Alloc>::size_type
     vector_base<T,Alloc>
@@ -77,13 +77,22 @@ public:
     device_vector(void* p, std::size_t n)
         : Parent(p, n) {}
 
+    /*! This constructor creates a \p device_vector with default-valued
+     *  elements.  They are left uninitialized when \p Alloc is a
+     *  \p default_init_allocator and \c T is trivially constructible.
+     *  \param n The number of elements to initially create.
+     */
+    __host__
+    explicit device_vector(size_type n)
+        : Parent(n) {}
+
     /*! This constructor creates a \p device_vector with copies
      *  of an exemplar element.
      *  \param n The number of elements to initially create.
      *  \param value An element to copy.
      */
     __host__
-    explicit device_vector(size_type n, const value_type& value = value_type())
+    explicit device_vector(size_type n, const value_type& value)
         : Parent(n, value) {}
 
     /*! Copy constructor copies from an exemplar \p device_vector.
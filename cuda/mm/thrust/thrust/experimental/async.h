@@ -0,0 +1,282 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file async.h
+ *  \brief Asynchronous launches of Thrust algorithms on a shared
+ *         pool of host threads.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/async_state.h>
+#include <thrust/iterator/iterator_traits.h>
+
+namespace thrust {
+
+namespace experimental {
+
+/*! \addtogroup async Asynchronous Launches
+ *  \{
+ */
+
+/*! \p event tracks the completion of an asynchronous operation launched
+ *  with one of the \p async_ functions.  Copies of an \p event refer to
+ *  the same operation.
+ *
+ *  Every \p async_ function may be given an \p event to wait for; the new
+ *  operation is queued behind it without occupying a worker thread.  If
+ *  that operation failed, the failure is passed on to the new one.
+ */
+class event {
+public:
+    /*! Creates an \p event which refers to no operation.
+     */
+    event(void) : m_state(0) {}
+
+    event(const event& other) : m_state(other.m_state) {
+        if (m_state != 0) m_state->retain();
+    }
+
+    event& operator=(const event& other) {
+        if (other.m_state != 0) other.m_state->retain();
+        if (m_state != 0) m_state->release();
+        m_state = other.m_state;
+        return *this;
+    }
+
+    ~event(void) {
+        if (m_state != 0) m_state->release();
+    }
+
+    /*! \return \c true if this \p event refers to an operation.
+     */
+    bool valid(void) const {
+        return m_state != 0;
+    }
+
+    /*! \return \c true if the operation has finished, either normally or
+     *          with an exception, or if this \p event is not \p valid.
+     */
+    bool ready(void) const {
+        return m_state == 0 || m_state->ready();
+    }
+
+    /*! Blocks until the operation has finished.
+     *  \throw std::runtime_error carrying the message of the exception
+     *         which ended the operation, if it failed.
+     */
+    inline void wait(void) const;
+
+protected:
+    explicit event(thrust::detail::async_state* state) : m_state(state) {}
+
+    thrust::detail::async_state* m_state;
+
+    friend struct thrust::detail::async_access;
+}; // end event
+
+
+/*! \p future is an \p event which also carries the value produced by the
+ *  operation.
+ */
+template<typename T>
+class future : public event {
+public:
+    typedef T value_type;
+
+    /*! Creates a \p future which refers to no operation.
+     */
+    future(void) {}
+
+    /*! Blocks until the operation has finished and returns its value.
+     *  \throw std::runtime_error if the operation failed.
+     */
+    inline T get(void) const;
+
+protected:
+    explicit future(thrust::detail::async_value_state<T>* state) : event(state) {}
+
+    friend struct thrust::detail::async_access;
+}; // end future
+
+
+/*! \p async_reduce launches <tt>thrust::reduce(first, last)</tt> on the
+ *  shared thread pool.
+ *
+ *  The input range must remain valid until the returned \p future is
+ *  ready.  Only host and OpenMP device iterators are supported.
+ *
+ *  \return A \p future holding the result of the reduction.
+ *  \see reduce
+ */
+template<typename InputIterator>
+  future<typename thrust::iterator_value<InputIterator>::type>
+    async_reduce(InputIterator first,
+                 InputIterator last);
+
+/*! \p async_reduce launches <tt>thrust::reduce(first, last, init)</tt>
+ *  on the shared thread pool.
+ */
+template<typename InputIterator, typename T>
+  future<T>
+    async_reduce(InputIterator first,
+                 InputIterator last,
+                 T init);
+
+/*! \p async_reduce launches
+ *  <tt>thrust::reduce(first, last, init, binary_op)</tt> on the shared
+ *  thread pool.
+ */
+template<typename InputIterator, typename T, typename BinaryFunction>
+  future<T>
+    async_reduce(InputIterator first,
+                 InputIterator last,
+                 T init,
+                 BinaryFunction binary_op);
+
+/*! These versions of \p async_reduce start once \p after has finished.
+ */
+template<typename InputIterator>
+  future<typename thrust::iterator_value<InputIterator>::type>
+    async_reduce(const event& after,
+                 InputIterator first,
+                 InputIterator last);
+
+template<typename InputIterator, typename T>
+  future<T>
+    async_reduce(const event& after,
+                 InputIterator first,
+                 InputIterator last,
+                 T init);
+
+template<typename InputIterator, typename T, typename BinaryFunction>
+  future<T>
+    async_reduce(const event& after,
+                 InputIterator first,
+                 InputIterator last,
+                 T init,
+                 BinaryFunction binary_op);
+
+
+/*! \p async_sort launches <tt>thrust::sort(first, last)</tt> on the
+ *  shared thread pool.
+ *
+ *  The range must remain valid, and must not be accessed, until the
+ *  returned \p event is ready.
+ *
+ *  \see sort
+ */
+template<typename RandomAccessIterator>
+  event async_sort(RandomAccessIterator first,
+                   RandomAccessIterator last);
+
+/*! \p async_sort launches <tt>thrust::sort(first, last, comp)</tt> on
+ *  the shared thread pool.
+ */
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+  event async_sort(RandomAccessIterator first,
+                   RandomAccessIterator last,
+                   StrictWeakOrdering comp);
+
+/*! These versions of \p async_sort start once \p after has finished.
+ */
+template<typename RandomAccessIterator>
+  event async_sort(const event& after,
+                   RandomAccessIterator first,
+                   RandomAccessIterator last);
+
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+  event async_sort(const event& after,
+                   RandomAccessIterator first,
+                   RandomAccessIterator last,
+                   StrictWeakOrdering comp);
+
+
+/*! \p async_transform launches
+ *  <tt>thrust::transform(first, last, result, op)</tt> on the shared
+ *  thread pool.
+ *
+ *  \return A \p future holding the end of the output range.
+ *  \see transform
+ */
+template<typename InputIterator, typename OutputIterator, typename UnaryFunction>
+  future<OutputIterator>
+    async_transform(InputIterator first, InputIterator last,
+                    OutputIterator result,
+                    UnaryFunction op);
+
+/*! \p async_transform launches
+ *  <tt>thrust::transform(first1, last1, first2, result, op)</tt> on the
+ *  shared thread pool.
+ */
+template<typename InputIterator1, typename InputIterator2, typename OutputIterator, typename BinaryFunction>
+  future<OutputIterator>
+    async_transform(InputIterator1 first1, InputIterator1 last1,
+                    InputIterator2 first2,
+                    OutputIterator result,
+                    BinaryFunction op);
+
+/*! These versions of \p async_transform start once \p after has finished.
+ */
+template<typename InputIterator, typename OutputIterator, typename UnaryFunction>
+  future<OutputIterator>
+    async_transform(const event& after,
+                    InputIterator first, InputIterator last,
+                    OutputIterator result,
+                    UnaryFunction op);
+
+template<typename InputIterator1, typename InputIterator2, typename OutputIterator, typename BinaryFunction>
+  future<OutputIterator>
+    async_transform(const event& after,
+                    InputIterator1 first1, InputIterator1 last1,
+                    InputIterator2 first2,
+                    OutputIterator result,
+                    BinaryFunction op);
+
+
+/*! \p async_copy launches <tt>thrust::copy(first, last, result)</tt> on
+ *  the shared thread pool.
+ *
+ *  \return A \p future holding the end of the output range.
+ *  \see copy
+ */
+template<typename InputIterator, typename OutputIterator>
+  future<OutputIterator>
+    async_copy(InputIterator first,
+               InputIterator last,
+               OutputIterator result);
+
+/*! This version of \p async_copy starts once \p after has finished.
+ */
+template<typename InputIterator, typename OutputIterator>
+  future<OutputIterator>
+    async_copy(const event& after,
+               InputIterator first,
+               InputIterator last,
+               OutputIterator result);
+
+/*! \}
+ */
+
+} // end namespace experimental
+
+} // end namespace thrust
+
+#include <thrust/experimental/async.inl>
+
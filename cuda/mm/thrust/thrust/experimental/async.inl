@@ -0,0 +1,463 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file async.inl
+ *  \brief Inline file for async.h.
+ */
+
+#include <thrust/experimental/async.h>
+#include <thrust/reduce.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+#include <thrust/copy.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/type_traits.h>
+#include <stdexcept>
+
+namespace thrust
+{
+
+namespace detail
+{
+
+struct async_access
+{
+  static async_state *state(const thrust::experimental::event &e)
+  {
+    return e.m_state;
+  }
+
+  static thrust::experimental::event make_event(async_state *state)
+  {
+    return thrust::experimental::event(state);
+  }
+
+  template<typename T>
+  static thrust::experimental::future<T> make_future(async_value_state<T> *state)
+  {
+    return thrust::experimental::future<T>(state);
+  }
+}; // end async_access
+
+
+// pool threads cannot issue work to a CUDA context they do not own
+template<typename Iterator>
+  struct is_async_launchable
+    : integral_constant<
+        bool,
+        !is_same<
+          typename thrust::iterator_space<Iterator>::type,
+          thrust::detail::cuda_device_space_tag
+        >::value
+      >
+{};
+
+
+template<typename InputIterator, typename T, typename BinaryFunction>
+  class async_reduce_task
+    : public async_task
+{
+  public:
+    async_reduce_task(async_value_state<T> *state, async_state *after,
+                      InputIterator first, InputIterator last,
+                      T init, BinaryFunction binary_op)
+      : async_task(state, after),
+        m_first(first), m_last(last), m_init(init), m_binary_op(binary_op)
+    {}
+
+  protected:
+    void execute(void)
+    {
+      static_cast<async_value_state<T>*>(m_state)->value =
+        thrust::reduce(m_first, m_last, m_init, m_binary_op);
+    }
+
+  private:
+    InputIterator m_first, m_last;
+    T m_init;
+    BinaryFunction m_binary_op;
+}; // end async_reduce_task
+
+
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+  class async_sort_task
+    : public async_task
+{
+  public:
+    async_sort_task(async_state *state, async_state *after,
+                    RandomAccessIterator first, RandomAccessIterator last,
+                    StrictWeakOrdering comp)
+      : async_task(state, after),
+        m_first(first), m_last(last), m_comp(comp)
+    {}
+
+  protected:
+    void execute(void)
+    {
+      thrust::sort(m_first, m_last, m_comp);
+    }
+
+  private:
+    RandomAccessIterator m_first, m_last;
+    StrictWeakOrdering m_comp;
+}; // end async_sort_task
+
+
+template<typename InputIterator, typename OutputIterator, typename UnaryFunction>
+  class async_unary_transform_task
+    : public async_task
+{
+  public:
+    async_unary_transform_task(async_value_state<OutputIterator> *state, async_state *after,
+                               InputIterator first, InputIterator last,
+                               OutputIterator result, UnaryFunction op)
+      : async_task(state, after),
+        m_first(first), m_last(last), m_result(result), m_op(op)
+    {}
+
+  protected:
+    void execute(void)
+    {
+      static_cast<async_value_state<OutputIterator>*>(m_state)->value =
+        thrust::transform(m_first, m_last, m_result, m_op);
+    }
+
+  private:
+    InputIterator m_first, m_last;
+    OutputIterator m_result;
+    UnaryFunction m_op;
+}; // end async_unary_transform_task
+
+
+template<typename InputIterator1, typename InputIterator2, typename OutputIterator, typename BinaryFunction>
+  class async_binary_transform_task
+    : public async_task
+{
+  public:
+    async_binary_transform_task(async_value_state<OutputIterator> *state, async_state *after,
+                                InputIterator1 first1, InputIterator1 last1,
+                                InputIterator2 first2,
+                                OutputIterator result, BinaryFunction op)
+      : async_task(state, after),
+        m_first1(first1), m_last1(last1), m_first2(first2), m_result(result), m_op(op)
+    {}
+
+  protected:
+    void execute(void)
+    {
+      static_cast<async_value_state<OutputIterator>*>(m_state)->value =
+        thrust::transform(m_first1, m_last1, m_first2, m_result, m_op);
+    }
+
+  private:
+    InputIterator1 m_first1, m_last1;
+    InputIterator2 m_first2;
+    OutputIterator m_result;
+    BinaryFunction m_op;
+}; // end async_binary_transform_task
+
+
+template<typename InputIterator, typename OutputIterator>
+  class async_copy_task
+    : public async_task
+{
+  public:
+    async_copy_task(async_value_state<OutputIterator> *state, async_state *after,
+                    InputIterator first, InputIterator last,
+                    OutputIterator result)
+      : async_task(state, after),
+        m_first(first), m_last(last), m_result(result)
+    {}
+
+  protected:
+    void execute(void)
+    {
+      static_cast<async_value_state<OutputIterator>*>(m_state)->value =
+        thrust::copy(m_first, m_last, m_result);
+    }
+
+  private:
+    InputIterator m_first, m_last;
+    OutputIterator m_result;
+}; // end async_copy_task
+
+} // end detail
+
+
+namespace experimental
+{
+
+void event
+  ::wait(void) const
+{
+  if(m_state == 0) return;
+
+  m_state->wait();
+
+  if(m_state->failed())
+    throw std::runtime_error(m_state->what());
+} // end event::wait()
+
+
+template<typename T>
+  T future<T>
+    ::get(void) const
+{
+  if(!valid())
+    throw std::runtime_error("future::get(): no associated operation");
+
+  wait();
+
+  return static_cast<thrust::detail::async_value_state<T>*>(m_state)->value;
+} // end future::get()
+
+
+///////////////
+// Reduction //
+///////////////
+
+template<typename InputIterator, typename T, typename BinaryFunction>
+  future<T>
+    async_reduce(const event &after,
+                 InputIterator first,
+                 InputIterator last,
+                 T init,
+                 BinaryFunction binary_op)
+{
+  THRUST_STATIC_ASSERT( (thrust::detail::is_async_launchable<InputIterator>::value) );
+
+  using thrust::detail::async_access;
+
+  thrust::detail::async_value_state<T> *state = new thrust::detail::async_value_state<T>;
+  future<T> result = async_access::make_future(state);
+
+  thrust::detail::async_task *task =
+    new thrust::detail::async_reduce_task<InputIterator,T,BinaryFunction>(state, async_access::state(after), first, last, init, binary_op);
+  task->launch();
+
+  return result;
+} // end async_reduce()
+
+template<typename InputIterator, typename T>
+  future<T>
+    async_reduce(const event &after,
+                 InputIterator first,
+                 InputIterator last,
+                 T init)
+{
+  return thrust::experimental::async_reduce(after, first, last, init, thrust::plus<T>());
+} // end async_reduce()
+
+template<typename InputIterator>
+  future<typename thrust::iterator_value<InputIterator>::type>
+    async_reduce(const event &after,
+                 InputIterator first,
+                 InputIterator last)
+{
+  typedef typename thrust::iterator_value<InputIterator>::type InputType;
+
+  return thrust::experimental::async_reduce(after, first, last, InputType(0), thrust::plus<InputType>());
+} // end async_reduce()
+
+template<typename InputIterator, typename T, typename BinaryFunction>
+  future<T>
+    async_reduce(InputIterator first,
+                 InputIterator last,
+                 T init,
+                 BinaryFunction binary_op)
+{
+  return thrust::experimental::async_reduce(event(), first, last, init, binary_op);
+} // end async_reduce()
+
+template<typename InputIterator, typename T>
+  future<T>
+    async_reduce(InputIterator first,
+                 InputIterator last,
+                 T init)
+{
+  return thrust::experimental::async_reduce(event(), first, last, init);
+} // end async_reduce()
+
+template<typename InputIterator>
+  future<typename thrust::iterator_value<InputIterator>::type>
+    async_reduce(InputIterator first,
+                 InputIterator last)
+{
+  return thrust::experimental::async_reduce(event(), first, last);
+} // end async_reduce()
+
+
+/////////////
+// Sorting //
+/////////////
+
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+  event async_sort(const event &after,
+                   RandomAccessIterator first,
+                   RandomAccessIterator last,
+                   StrictWeakOrdering comp)
+{
+  THRUST_STATIC_ASSERT( (thrust::detail::is_async_launchable<RandomAccessIterator>::value) );
+
+  using thrust::detail::async_access;
+
+  thrust::detail::async_state *state = new thrust::detail::async_state;
+  event result = async_access::make_event(state);
+
+  thrust::detail::async_task *task =
+    new thrust::detail::async_sort_task<RandomAccessIterator,StrictWeakOrdering>(state, async_access::state(after), first, last, comp);
+  task->launch();
+
+  return result;
+} // end async_sort()
+
+template<typename RandomAccessIterator>
+  event async_sort(const event &after,
+                   RandomAccessIterator first,
+                   RandomAccessIterator last)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type KeyType;
+
+  return thrust::experimental::async_sort(after, first, last, thrust::less<KeyType>());
+} // end async_sort()
+
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+  event async_sort(RandomAccessIterator first,
+                   RandomAccessIterator last,
+                   StrictWeakOrdering comp)
+{
+  return thrust::experimental::async_sort(event(), first, last, comp);
+} // end async_sort()
+
+template<typename RandomAccessIterator>
+  event async_sort(RandomAccessIterator first,
+                   RandomAccessIterator last)
+{
+  return thrust::experimental::async_sort(event(), first, last);
+} // end async_sort()
+
+
+///////////////
+// Transform //
+///////////////
+
+template<typename InputIterator, typename OutputIterator, typename UnaryFunction>
+  future<OutputIterator>
+    async_transform(const event &after,
+                    InputIterator first, InputIterator last,
+                    OutputIterator result,
+                    UnaryFunction op)
+{
+  THRUST_STATIC_ASSERT( (thrust::detail::is_async_launchable<InputIterator>::value) );
+  THRUST_STATIC_ASSERT( (thrust::detail::is_async_launchable<OutputIterator>::value) );
+
+  using thrust::detail::async_access;
+
+  thrust::detail::async_value_state<OutputIterator> *state = new thrust::detail::async_value_state<OutputIterator>;
+  future<OutputIterator> end = async_access::make_future(state);
+
+  thrust::detail::async_task *task =
+    new thrust::detail::async_unary_transform_task<InputIterator,OutputIterator,UnaryFunction>(state, async_access::state(after), first, last, result, op);
+  task->launch();
+
+  return end;
+} // end async_transform()
+
+template<typename InputIterator1, typename InputIterator2, typename OutputIterator, typename BinaryFunction>
+  future<OutputIterator>
+    async_transform(const event &after,
+                    InputIterator1 first1, InputIterator1 last1,
+                    InputIterator2 first2,
+                    OutputIterator result,
+                    BinaryFunction op)
+{
+  THRUST_STATIC_ASSERT( (thrust::detail::is_async_launchable<InputIterator1>::value) );
+  THRUST_STATIC_ASSERT( (thrust::detail::is_async_launchable<InputIterator2>::value) );
+  THRUST_STATIC_ASSERT( (thrust::detail::is_async_launchable<OutputIterator>::value) );
+
+  using thrust::detail::async_access;
+
+  thrust::detail::async_value_state<OutputIterator> *state = new thrust::detail::async_value_state<OutputIterator>;
+  future<OutputIterator> end = async_access::make_future(state);
+
+  thrust::detail::async_task *task =
+    new thrust::detail::async_binary_transform_task<InputIterator1,InputIterator2,OutputIterator,BinaryFunction>(state, async_access::state(after), first1, last1, first2, result, op);
+  task->launch();
+
+  return end;
+} // end async_transform()
+
+template<typename InputIterator, typename OutputIterator, typename UnaryFunction>
+  future<OutputIterator>
+    async_transform(InputIterator first, InputIterator last,
+                    OutputIterator result,
+                    UnaryFunction op)
+{
+  return thrust::experimental::async_transform(event(), first, last, result, op);
+} // end async_transform()
+
+template<typename InputIterator1, typename InputIterator2, typename OutputIterator, typename BinaryFunction>
+  future<OutputIterator>
+    async_transform(InputIterator1 first1, InputIterator1 last1,
+                    InputIterator2 first2,
+                    OutputIterator result,
+                    BinaryFunction op)
+{
+  return thrust::experimental::async_transform(event(), first1, last1, first2, result, op);
+} // end async_transform()
+
+
+//////////
+// Copy //
+//////////
+
+template<typename InputIterator, typename OutputIterator>
+  future<OutputIterator>
+    async_copy(const event &after,
+               InputIterator first,
+               InputIterator last,
+               OutputIterator result)
+{
+  THRUST_STATIC_ASSERT( (thrust::detail::is_async_launchable<InputIterator>::value) );
+  THRUST_STATIC_ASSERT( (thrust::detail::is_async_launchable<OutputIterator>::value) );
+
+  using thrust::detail::async_access;
+
+  thrust::detail::async_value_state<OutputIterator> *state = new thrust::detail::async_value_state<OutputIterator>;
+  future<OutputIterator> end = async_access::make_future(state);
+
+  thrust::detail::async_task *task =
+    new thrust::detail::async_copy_task<InputIterator,OutputIterator>(state, async_access::state(after), first, last, result);
+  task->launch();
+
+  return end;
+} // end async_copy()
+
+template<typename InputIterator, typename OutputIterator>
+  future<OutputIterator>
+    async_copy(InputIterator first,
+               InputIterator last,
+               OutputIterator result)
+{
+  return thrust::experimental::async_copy(event(), first, last, result);
+} // end async_copy()
+
+} // end experimental
+
+} // end thrust
+
@@ -0,0 +1,222 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file caching_allocator.h
+ *  \brief A standard C++ allocator class for host memory drawn
+ *         from a thread-safe size-class cache.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/memory_pool.h>
+#include <limits>
+#include <stdexcept>
+
+namespace thrust {
+
+namespace experimental {
+
+/*! \addtogroup memory_management Memory Management
+ *  \addtogroup memory_management_classes
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! \p caching_allocator is a host memory allocator which keeps freed
+ *  blocks in a process-wide cache and hands them out again on later
+ *  allocations of the same size class.  Blocks of up to 1 MiB are rounded
+ *  up to powers of two.  The cache is shared by all threads and keeps a
+ *  small private cache per thread, so repeated temporary allocations
+ *  neither touch the system allocator nor contend on a lock.
+ *
+ *  Larger blocks are neither rounded nor cached: they go straight to the
+ *  system allocator.  The shared cache holds at most 64 MiB; beyond that,
+ *  and otherwise on \p caching_allocator_trim, cached memory is released.
+ *
+ *  Thrust's temporary buffers in the host and OpenMP device spaces are
+ *  drawn from the same cache.
+ *
+ *  \see http://www.sgi.com/tech/stl/Allocators.html
+ */
+template<typename T> class caching_allocator;
+
+template<>
+class caching_allocator<void> {
+public:
+    typedef void           value_type;
+    typedef void*          pointer;
+    typedef const void*    const_pointer;
+    typedef std::size_t    size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    // convert a caching_allocator<void> to caching_allocator<U>
+    template<typename U>
+    struct rebind {
+        typedef caching_allocator<U> other;
+    }; // end rebind
+}; // end caching_allocator
+
+
+template<typename T>
+class caching_allocator {
+public:
+    typedef T              value_type;
+    typedef T*             pointer;
+    typedef const T*       const_pointer;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef std::size_t    size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    // convert a caching_allocator<T> to caching_allocator<U>
+    template<typename U>
+    struct rebind {
+        typedef caching_allocator<U> other;
+    }; // end rebind
+
+    /*! \p caching_allocator's null constructor does nothing.
+     */
+    inline caching_allocator() {}
+
+    /*! \p caching_allocator's null destructor does nothing.
+     */
+    inline ~caching_allocator() {}
+
+    /*! \p caching_allocator's copy constructor does nothing.
+     */
+    inline caching_allocator(caching_allocator const&) {}
+
+    /*! This version of \p caching_allocator's copy constructor
+     *  is templated on the \c value_type of the \p caching_allocator
+     *  to copy from.  It is provided merely for convenience; it
+     *  does nothing.
+     */
+    template<typename U>
+    inline caching_allocator(caching_allocator<U> const&) {}
+
+    /*! This method returns the address of a \c reference of
+     *  interest.
+     *
+     *  \p r The \c reference of interest.
+     *  \return \c r's address.
+     */
+    inline pointer address(reference r) { return &r; }
+
+    /*! This method returns the address of a \c const_reference
+     *  of interest.
+     *
+     *  \p r The \c const_reference of interest.
+     *  \return \c r's address.
+     */
+    inline const_pointer address(const_reference r) { return &r; }
+
+    /*! This method allocates storage for objects from the cache.
+     *
+     *  \p cnt The number of objects to allocate.
+     *  \return a \c pointer to the newly allocated objects.
+     *  \note This method does not invoke \p value_type's constructor.
+     *        It is the responsibility of the caller to initialize the
+     *        objects at the returned \c pointer.
+     */
+    inline pointer allocate(size_type cnt,
+                            const_pointer = 0) {
+        if (cnt > this->max_size()) {
+            throw std::bad_alloc();
+        } // end if
+
+        return static_cast<pointer>(thrust::detail::memory_pool::instance().allocate(cnt * sizeof(value_type)));
+    } // end allocate()
+
+    /*! This method returns storage previously allocated with this
+     *  \c caching_allocator to the cache.
+     *
+     *  \p p A \c pointer to the previously allocated memory.
+     *  \p cnt The number of objects previously allocated at
+     *         \p p.
+     *  \note This method does not invoke \p value_type's destructor.
+     *        It is the responsibility of the caller to destroy
+     *        the objects stored at \p p.
+     */
+    inline void deallocate(pointer p, size_type) {
+        thrust::detail::memory_pool::instance().deallocate(p);
+    } // end deallocate()
+
+    /*! This method returns the maximum size of the \c cnt parameter
+     *  accepted by the \p allocate() method.
+     *
+     *  \return The maximum number of objects that may be allocated
+     *          by a single call to \p allocate().
+     */
+    inline size_type max_size() const {
+        return (std::numeric_limits<size_type>::max() / 2) / sizeof(T);
+    } // end max_size()
+
+    /*! This method tests this \p caching_allocator for equality to
+     *  another.
+     *
+     *  \param x The other \p caching_allocator of interest.
+     *  \return This method always returns \c true.
+     */
+    inline bool operator==(caching_allocator const&) const { return true; }
+
+    /*! This method tests this \p caching_allocator for inequality
+     *  to another.
+     *
+     *  \param x The other \p caching_allocator of interest.
+     *  \return This method always returns \c false.
+     */
+    inline bool operator!=(caching_allocator const& x) const { return !operator==(x); }
+}; // end caching_allocator
+
+
+/*! This function releases every block held in the cache shared by
+ *  \p caching_allocator and Thrust's temporary buffers back to the system.
+ *  Blocks currently in use are unaffected.
+ */
+inline void caching_allocator_trim(void) {
+    thrust::detail::memory_pool::instance().trim();
+}
+
+/*! \return The number of bytes the cache currently holds from the system,
+ *          whether cached or in use.
+ */
+inline std::size_t caching_allocator_bytes_reserved(void) {
+    return thrust::detail::memory_pool::instance().bytes_reserved();
+}
+
+/*! \return The number of bytes currently cached and not in use.
+ */
+inline std::size_t caching_allocator_bytes_cached(void) {
+    return thrust::detail::memory_pool::instance().bytes_cached();
+}
+
+/*! \return The largest value \p caching_allocator_bytes_reserved has
+ *          reached since the program started.
+ */
+inline std::size_t caching_allocator_high_water_mark(void) {
+    return thrust::detail::memory_pool::instance().high_water_mark();
+}
+
+/*! \}
+ */
+
+} // end experimental
+
+} // end thrust
+
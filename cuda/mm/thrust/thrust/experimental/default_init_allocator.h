@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file default_init_allocator.h
+ *  \brief An allocator adaptor which makes vectors skip the value
+ *         initialization of new elements.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/type_traits.h>
+#include <memory>
+
+namespace thrust {
+
+namespace experimental {
+
+/*! \addtogroup memory_management Memory Management
+ *  \addtogroup memory_management_classes
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! \p default_init_allocator adapts another allocator so that vectors
+ *  using it default initialize, rather than value initialize, the elements
+ *  they create without an exemplar value.  For a trivially constructible
+ *  \c value_type this means that
+ *
+ *  \code
+ *  typedef thrust::experimental::default_init_allocator<float> alloc;
+ *  thrust::host_vector<float, alloc> v(n);
+ *  v.resize(2 * n);
+ *  \endcode
+ *
+ *  leaves the new elements uninitialized instead of writing zeros over
+ *  memory which the caller is about to overwrite anyway.  Constructing or
+ *  resizing with an explicit value still copies that value, and elements
+ *  with a non-trivial constructor are still value initialized.
+ *
+ *  Storage is obtained from \p Allocator, which may be any host or device
+ *  allocator; for example, <tt>default_init_allocator<T, thrust::device_malloc_allocator<T> ></tt>
+ *  gives the same behavior to a \p device_vector.
+ *
+ *  \see host_vector
+ *  \see device_vector
+ */
+template<typename T, typename Allocator = std::allocator<T> >
+class default_init_allocator
+        : public Allocator {
+public:
+    // convert a default_init_allocator<T> to default_init_allocator<U>
+    template<typename U>
+    struct rebind {
+        typedef default_init_allocator<U, typename Allocator::template rebind<U>::other> other;
+    }; // end rebind
+
+    /*! \p default_init_allocator's null constructor default constructs
+     *  the adapted allocator.
+     */
+    inline default_init_allocator() {}
+
+    /*! This constructor adapts a copy of an existing allocator.
+     */
+    inline default_init_allocator(const Allocator& a) : Allocator(a) {}
+
+    /*! This version of \p default_init_allocator's copy constructor
+     *  is templated on the \c value_type of the \p default_init_allocator
+     *  to copy from.
+     */
+    template<typename U, typename OtherAllocator>
+    inline default_init_allocator(const default_init_allocator<U, OtherAllocator>& a) : Allocator(a) {}
+}; // end default_init_allocator
+
+/*! \}
+ */
+
+} // end experimental
+
+namespace detail {
+
+// whether vectors using Alloc should skip value initializing new elements
+template<typename Alloc>
+struct is_default_init_allocator : false_type {};
+
+template<typename T, typename Allocator>
+struct is_default_init_allocator< thrust::experimental::default_init_allocator<T, Allocator> > : true_type {};
+
+} // end detail
+
+} // end thrust
+
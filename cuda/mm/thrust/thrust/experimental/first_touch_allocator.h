@@ -0,0 +1,205 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file first_touch_allocator.h
+ *  \brief A standard C++ allocator class for host memory whose pages
+ *         are placed by the threads which work on them.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/first_touch.h>
+#include <limits>
+#include <stdexcept>
+#include <new>
+
+namespace thrust {
+
+namespace experimental {
+
+/*! \addtogroup memory_management Memory Management
+ *  \addtogroup memory_management_classes
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! \p first_touch_allocator is a host memory allocator for large arrays
+ *  which are processed in parallel by the OpenMP algorithms.  On a NUMA
+ *  machine a page is placed on the node of the thread which first writes
+ *  it, so an array initialized by a single thread ends up on one node and
+ *  later parallel passes over it are limited by that node's bandwidth.
+ *
+ *  \p first_touch_allocator writes every new page from the thread which
+ *  owns it under the static partition of the OpenMP algorithms before
+ *  returning the storage.  Allocations of 2MB or more are also aligned to,
+ *  and on Linux advised onto, transparent huge pages.
+ *
+ *  The pages are placed by \p allocate, so a vector using this allocator
+ *  keeps the placement however its elements are initialized afterwards.
+ *  Pair it with \p uninitialized_resize to skip the serial value
+ *  initialization of elements which are about to be overwritten.
+ *
+ *  Without OpenMP support the pages are not touched.
+ *
+ *  \see http://www.sgi.com/tech/stl/Allocators.html
+ */
+template<typename T> class first_touch_allocator;
+
+template<>
+class first_touch_allocator<void> {
+public:
+    typedef void           value_type;
+    typedef void*          pointer;
+    typedef const void*    const_pointer;
+    typedef std::size_t    size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    // convert a first_touch_allocator<void> to first_touch_allocator<U>
+    template<typename U>
+    struct rebind {
+        typedef first_touch_allocator<U> other;
+    }; // end rebind
+}; // end first_touch_allocator
+
+
+template<typename T>
+class first_touch_allocator {
+public:
+    typedef T              value_type;
+    typedef T*             pointer;
+    typedef const T*       const_pointer;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef std::size_t    size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    // convert a first_touch_allocator<T> to first_touch_allocator<U>
+    template<typename U>
+    struct rebind {
+        typedef first_touch_allocator<U> other;
+    }; // end rebind
+
+    /*! \p first_touch_allocator's null constructor does nothing.
+     */
+    inline first_touch_allocator() {}
+
+    /*! \p first_touch_allocator's null destructor does nothing.
+     */
+    inline ~first_touch_allocator() {}
+
+    /*! \p first_touch_allocator's copy constructor does nothing.
+     */
+    inline first_touch_allocator(first_touch_allocator const&) {}
+
+    /*! This version of \p first_touch_allocator's copy constructor
+     *  is templated on the \c value_type of the \p first_touch_allocator
+     *  to copy from.  It is provided merely for convenience; it
+     *  does nothing.
+     */
+    template<typename U>
+    inline first_touch_allocator(first_touch_allocator<U> const&) {}
+
+    /*! This method returns the address of a \c reference of
+     *  interest.
+     *
+     *  \p r The \c reference of interest.
+     *  \return \c r's address.
+     */
+    inline pointer address(reference r) { return &r; }
+
+    /*! This method returns the address of a \c const_reference
+     *  of interest.
+     *
+     *  \p r The \c const_reference of interest.
+     *  \return \c r's address.
+     */
+    inline const_pointer address(const_reference r) { return &r; }
+
+    /*! This method allocates storage for objects and places its pages
+     *  on the NUMA nodes of the threads which own them.
+     *
+     *  \p cnt The number of objects to allocate.
+     *  \return a \c pointer to the newly allocated objects.
+     *  \note This method does not invoke \p value_type's constructor.
+     *        It is the responsibility of the caller to initialize the
+     *        objects at the returned \c pointer.
+     */
+    inline pointer allocate(size_type cnt,
+                            const_pointer = 0) {
+        if (cnt > this->max_size()) {
+            throw std::bad_alloc();
+        } // end if
+
+        void* result = thrust::detail::first_touch_malloc(cnt, sizeof(value_type));
+
+        if (result == 0) {
+            throw std::bad_alloc();
+        } // end if
+
+        return static_cast<pointer>(result);
+    } // end allocate()
+
+    /*! This method deallocates storage for objects previously allocated
+     *  with this \c first_touch_allocator.
+     *
+     *  \p p A \c pointer to the previously allocated memory.
+     *  \p cnt The number of objects previously allocated at
+     *         \p p.
+     *  \note This method does not invoke \p value_type's destructor.
+     *        It is the responsibility of the caller to destroy
+     *        the objects stored at \p p.
+     */
+    inline void deallocate(pointer p, size_type) {
+        thrust::detail::first_touch_free(p);
+    } // end deallocate()
+
+    /*! This method returns the maximum size of the \c cnt parameter
+     *  accepted by the \p allocate() method.
+     *
+     *  \return The maximum number of objects that may be allocated
+     *          by a single call to \p allocate().
+     */
+    inline size_type max_size() const {
+        return (std::numeric_limits<size_type>::max() / 2) / sizeof(T);
+    } // end max_size()
+
+    /*! This method tests this \p first_touch_allocator for equality to
+     *  another.
+     *
+     *  \param x The other \p first_touch_allocator of interest.
+     *  \return This method always returns \c true.
+     */
+    inline bool operator==(first_touch_allocator const&) const { return true; }
+
+    /*! This method tests this \p first_touch_allocator for inequality
+     *  to another.
+     *
+     *  \param x The other \p first_touch_allocator of interest.
+     *  \return This method always returns \c false.
+     */
+    inline bool operator!=(first_touch_allocator const& x) const { return !operator==(x); }
+}; // end first_touch_allocator
+
+/*! \}
+ */
+
+} // end experimental
+
+} // end thrust
+
@@ -0,0 +1,138 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file histogram.h
+ *  \brief Counting samples into bins.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+namespace thrust {
+
+/*! \addtogroup reductions
+ *  \{
+ */
+
+/*! \p histogram_even counts the samples in <tt>[first, last)</tt> which
+ *  fall into each of \p num_bins bins of equal width dividing the
+ *  half-open interval <tt>[lower, upper)</tt>.  Sample \c x is counted
+ *  in bin <tt>(x - lower) * num_bins / (upper - lower)</tt>; samples
+ *  outside <tt>[lower, upper)</tt> are not counted.  The counts are
+ *  written to <tt>[output, output + num_bins)</tt>, replacing its
+ *  previous contents.
+ *
+ *  On the OpenMP backend every thread counts its part of the input into
+ *  private bins, which are summed at the end.
+ *
+ *  \param first The beginning of the samples.
+ *  \param last The end of the samples.
+ *  \param output The beginning of the bin counts.
+ *  \param num_bins The number of bins.
+ *  \param lower The lower bound of the first bin.
+ *  \param upper The upper bound of the last bin.
+ *  \return <tt>output + num_bins</tt>
+ *
+ *  \tparam InputIterator is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          and \p InputIterator's \c value_type is comparable with \p T and convertible to \c double.
+ *  \tparam OutputIterator is a model of <a href="http://www.sgi.com/tech/stl/OutputIterator.html">Output Iterator</a>
+ *          whose \c value_type is an integral type.
+ *  \tparam Size is an integral type.
+ *  \tparam T is convertible to \c double.
+ *
+ *  The following code snippet demonstrates how to use \p histogram_even
+ *  to count integers into five bins of width two.
+ *
+ *  \code
+ *  #include <thrust/histogram.h>
+ *  ...
+ *  int samples[8] = {0, 1, 3, 3, 4, 9, 10, -1};
+ *  int counts[5];
+ *
+ *  thrust::histogram_even(samples, samples + 8, counts, 5, 0, 10);
+ *  // counts is now {2, 2, 1, 0, 1}
+ *  \endcode
+ *
+ *  \see \p histogram_range
+ */
+template < typename InputIterator,
+         typename OutputIterator,
+         typename Size,
+         typename T >
+OutputIterator histogram_even(InputIterator first,
+                              InputIterator last,
+                              OutputIterator output,
+                              Size num_bins,
+                              T lower,
+                              T upper);
+
+
+/*! \p histogram_range counts the samples in <tt>[first, last)</tt> which
+ *  fall into each of the bins delimited by the sorted levels in
+ *  <tt>[levels_first, levels_last)</tt>.  Bin \c i holds the samples
+ *  \c x with <tt>levels_first[i] <= x < levels_first[i + 1]</tt>, so
+ *  \c n levels delimit <tt>n - 1</tt> bins.  Samples outside the levels
+ *  are not counted.  The counts are written to <tt>[output, output +
+ *  n - 1)</tt>, replacing its previous contents.
+ *
+ *  \param first The beginning of the samples.
+ *  \param last The end of the samples.
+ *  \param levels_first The beginning of the bin boundaries.
+ *  \param levels_last The end of the bin boundaries.
+ *  \param output The beginning of the bin counts.
+ *  \return The end of the bin counts.
+ *
+ *  \tparam InputIterator is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          and \p InputIterator's \c value_type is comparable with \p ForwardIterator's \c value_type.
+ *  \tparam ForwardIterator is a model of <a href="http://www.sgi.com/tech/stl/ForwardIterator.html">Forward Iterator</a>
+ *          in the same space as \p InputIterator.
+ *  \tparam OutputIterator is a model of <a href="http://www.sgi.com/tech/stl/OutputIterator.html">Output Iterator</a>
+ *          whose \c value_type is an integral type.
+ *
+ *  The following code snippet demonstrates how to use \p histogram_range
+ *  to count floats into bins of unequal width.
+ *
+ *  \code
+ *  #include <thrust/histogram.h>
+ *  ...
+ *  float samples[6] = {0.5f, 1.0f, 1.5f, 2.5f, 7.0f, 9.5f};
+ *  float levels[4]  = {0.0f, 1.0f, 2.0f, 8.0f};
+ *  int counts[3];
+ *
+ *  thrust::histogram_range(samples, samples + 6, levels, levels + 4, counts);
+ *  // counts is now {1, 2, 2}
+ *  \endcode
+ *
+ *  \see \p histogram_even
+ */
+template < typename InputIterator,
+         typename ForwardIterator,
+         typename OutputIterator >
+OutputIterator histogram_range(InputIterator first,
+                               InputIterator last,
+                               ForwardIterator levels_first,
+                               ForwardIterator levels_last,
+                               OutputIterator output);
+
+/*! \} // end reductions
+ */
+
+} // end thrust
+
+#include <thrust/detail/histogram.inl>
+
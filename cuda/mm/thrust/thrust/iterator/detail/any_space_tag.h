@@ -30,6 +30,8 @@ struct any_space_tag {
     operator detail::cuda_device_space_tag() {return detail::cuda_device_space_tag();};
 
     operator detail::omp_device_space_tag() {return detail::omp_device_space_tag();};
+
+    operator detail::threads_device_space_tag() {return detail::threads_device_space_tag();};
 };
 
 } // end thrust
@@ -78,6 +78,35 @@ struct random_access_omp_device_iterator_tag
     operator random_access_device_iterator_tag() {return random_access_device_iterator_tag();}
 };
 
+
+
+struct threads_device_iterator_tag {};
+
+struct input_threads_device_iterator_tag
+        : threads_device_iterator_tag {
+    operator input_device_iterator_tag() {return input_device_iterator_tag();}
+};
+
+struct output_threads_device_iterator_tag
+        : threads_device_iterator_tag {
+    operator output_device_iterator_tag() {return output_device_iterator_tag();}
+};
+
+struct forward_threads_device_iterator_tag
+        : input_threads_device_iterator_tag {
+    operator forward_device_iterator_tag() {return forward_device_iterator_tag();}
+};
+
+struct bidirectional_threads_device_iterator_tag
+        : forward_threads_device_iterator_tag {
+    operator bidirectional_device_iterator_tag() {return bidirectional_device_iterator_tag();}
+};
+
+struct random_access_threads_device_iterator_tag
+        : bidirectional_threads_device_iterator_tag {
+    operator random_access_device_iterator_tag() {return random_access_device_iterator_tag();}
+};
+
 } // end namespace detail
 } // end namespace thrust
 
@@ -24,11 +24,14 @@ namespace detail {
 // define these in detail for now
 struct cuda_device_space_tag : device_space_tag {};
 struct omp_device_space_tag : device_space_tag {};
+struct threads_device_space_tag : device_space_tag {};
 
 #if   THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_CUDA
 typedef cuda_device_space_tag default_device_space_tag;
 #elif THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_OMP
 typedef omp_device_space_tag  default_device_space_tag;
+#elif THRUST_DEVICE_BACKEND == THRUST_DEVICE_BACKEND_THREADS
+typedef threads_device_space_tag default_device_space_tag;
 #else
 #error Unknown device backend.
 #endif // THRUST_DEVICE_BACKEND
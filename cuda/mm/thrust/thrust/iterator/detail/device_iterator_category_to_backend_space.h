@@ -38,6 +38,12 @@ struct device_iterator_category_to_backend_space
 
         detail::identity_<thrust::detail::omp_device_space_tag>,
 
+        // convertible to threads?
+        eval_if <
+        is_convertible<DeviceCategory, thrust::detail::threads_device_iterator_tag>::value,
+
+        detail::identity_<thrust::detail::threads_device_space_tag>,
+
         // convertible to device_space_tag?
         eval_if <
         is_convertible<DeviceCategory, thrust::device_space_tag>::value,
@@ -49,6 +55,7 @@ struct device_iterator_category_to_backend_space
         >
         >
         >
+        >
 {};
 
 } // end detail
@@ -183,6 +183,20 @@ template<>
   > : thrust::detail::true_type
 {};
 
+template<>
+  struct are_spaces_interoperable<
+    thrust::host_space_tag,
+    thrust::detail::threads_device_space_tag
+  > : thrust::detail::true_type
+{};
+
+template<>
+  struct are_spaces_interoperable<
+    thrust::detail::threads_device_space_tag,
+    thrust::host_space_tag
+  > : thrust::detail::true_type
+{};
+
 } // end namespace detail
 
 } // end namespace thrust
@@ -30,6 +30,8 @@ struct input_universal_iterator_tag {
     operator thrust::detail::input_cuda_device_iterator_tag() {return thrust::detail::input_cuda_device_iterator_tag();}
 
     operator detail::input_omp_device_iterator_tag() {return detail::input_omp_device_iterator_tag();}
+
+    operator detail::input_threads_device_iterator_tag() {return detail::input_threads_device_iterator_tag();}
 };
 
 struct output_universal_iterator_tag {
@@ -38,6 +40,8 @@ struct output_universal_iterator_tag {
     operator detail::output_cuda_device_iterator_tag() {return detail::output_cuda_device_iterator_tag();}
 
     operator detail::output_omp_device_iterator_tag() {return detail::output_omp_device_iterator_tag();}
+
+    operator detail::output_threads_device_iterator_tag() {return detail::output_threads_device_iterator_tag();}
 };
 
 struct forward_universal_iterator_tag
@@ -47,6 +51,8 @@ struct forward_universal_iterator_tag
     operator detail::forward_cuda_device_iterator_tag() {return detail::forward_cuda_device_iterator_tag();};
 
     operator detail::forward_omp_device_iterator_tag() {return detail::forward_omp_device_iterator_tag();};
+
+    operator detail::forward_threads_device_iterator_tag() {return detail::forward_threads_device_iterator_tag();};
 };
 
 struct bidirectional_universal_iterator_tag
@@ -56,6 +62,8 @@ struct bidirectional_universal_iterator_tag
     operator detail::bidirectional_cuda_device_iterator_tag() {return detail::bidirectional_cuda_device_iterator_tag();};
 
     operator detail::bidirectional_omp_device_iterator_tag() {return detail::bidirectional_omp_device_iterator_tag();};
+
+    operator detail::bidirectional_threads_device_iterator_tag() {return detail::bidirectional_threads_device_iterator_tag();};
 };
 
 
@@ -80,6 +88,8 @@ struct random_access_universal_iterator_tag {
 
     operator detail::random_access_omp_device_iterator_tag() {return detail::random_access_omp_device_iterator_tag();};
 
+    operator detail::random_access_threads_device_iterator_tag() {return detail::random_access_threads_device_iterator_tag();};
+
     // bidirectional_universal_iterator_tag is P1
     operator detail::one_degree_of_separation<bidirectional_universal_iterator_tag> () {return detail::one_degree_of_separation<bidirectional_universal_iterator_tag>();}
 
@@ -0,0 +1,135 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file merge.h
+ *  \brief Merging sorted ranges.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+namespace thrust {
+
+/*! \addtogroup merging Merging
+ *  \ingroup algorithms
+ *  \{
+ */
+
+/*! \p merge combines two sorted ranges <tt>[first1, last1)</tt>
+ *  and <tt>[first2, last2)</tt> into a single sorted range beginning
+ *  at \p result. The return value is <tt>result + (last1 - first1) +
+ *  (last2 - first2)</tt>.
+ *
+ *  \p merge is stable: the relative order of equivalent elements
+ *  within each input range is preserved, and elements from the first
+ *  range precede equivalent elements from the second range.
+ *
+ *  On the OpenMP backend the inputs are divided along their merge
+ *  path, so each thread merges an independent slice of equal length.
+ *
+ *  This version of \p merge compares objects using
+ *  \c operator<.
+ *
+ *  \param first1 The beginning of the first input range.
+ *  \param last1 The end of the first input range.
+ *  \param first2 The beginning of the second input range.
+ *  \param last2 The end of the second input range.
+ *  \param result The beginning of the output range.
+ *  \return The end of the output range.
+ *
+ *  \tparam InputIterator1 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          \p InputIterator1 and \p InputIterator2 have the same \c value_type,
+ *          \p InputIterator1's \c value_type is a model of <a href="http://www.sgi.com/tech/stl/LessThanComparable">LessThan Comparable</a>,
+ *          and \p InputIterator1's \c value_type is convertable to a type in \p OutputIterator's set of \c value_types.
+ *  \tparam InputIterator2 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          \p InputIterator2 and \p InputIterator1 have the same \c value_type,
+ *          \p InputIterator2's \c value_type is a model of <a href="http://www.sgi.com/tech/stl/LessThanComparable">LessThan Comparable</a>,
+ *          and \p InputIterator2's \c value_type is convertable to a type in \p OutputIterator's set of \c value_types.
+ *  \tparam OutputIterator is a model of <a href="http://www.sgi.com/tech/stl/OutputIterator.html">Output Iterator</a>.
+ *
+ *  The following code snippet demonstrates how to use
+ *  \p merge to merge two sorted arrays of integers.
+ *
+ *  \code
+ *  #include <thrust/merge.h>
+ *  ...
+ *  int A1[6] = {1, 3, 5, 7, 9, 11};
+ *  int A2[7] = {1, 1, 2, 3, 5,  8, 13};
+ *
+ *  int result[13];
+ *
+ *  int *result_end = thrust::merge(A1, A1 + 6, A2, A2 + 7, result);
+ *  // result[0] = 1
+ *  // result[1] = 1
+ *  // result[2] = 1
+ *  // result[3] = 2
+ *  // result[4] = 3
+ *  // result[5] = 3
+ *  // result[6] = 5
+ *  // result[7] = 5
+ *  // result[8] = 7
+ *  // result[9] = 8
+ *  // result[10] = 9
+ *  // result[11] = 11
+ *  // result[12] = 13
+ *  \endcode
+ *
+ *  \see http://www.sgi.com/tech/stl/merge.html
+ *  \see \p sort
+ *  \see \p is_sorted
+ */
+template < typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator >
+OutputIterator merge(InputIterator1 first1,
+                     InputIterator1 last1,
+                     InputIterator2 first2,
+                     InputIterator2 last2,
+                     OutputIterator result);
+
+
+/*! This version of \p merge compares objects using the
+ *  function object \p comp, which must be a strict weak ordering
+ *  under which both input ranges are sorted.
+ *
+ *  \param first1 The beginning of the first input range.
+ *  \param last1 The end of the first input range.
+ *  \param first2 The beginning of the second input range.
+ *  \param last2 The end of the second input range.
+ *  \param result The beginning of the output range.
+ *  \param comp Comparison operator.
+ *  \return The end of the output range.
+ */
+template < typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering >
+OutputIterator merge(InputIterator1 first1,
+                     InputIterator1 last1,
+                     InputIterator2 first2,
+                     InputIterator2 last2,
+                     OutputIterator result,
+                     StrictWeakOrdering comp);
+
+/*! \} // end merging
+ */
+
+} // end thrust
+
+#include <thrust/detail/merge.inl>
+
@@ -0,0 +1,172 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <thrust/random/generate.h>
+#include <thrust/random/uniform_real_distribution.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/for_each.h>
+#include <thrust/distance.h>
+#include <math.h>
+
+namespace thrust
+{
+
+namespace random
+{
+
+namespace experimental
+{
+
+namespace detail
+{
+
+// each work item produces this many consecutive outputs from consecutive
+// values of the engine, one full block of philox4x32 or threefry4x32,
+// so no block is generated to use only part of it
+const unsigned int variates_per_item = 4;
+
+template<typename RandomAccessIterator, typename Engine, typename RealType>
+  struct uniform_variates
+{
+  RandomAccessIterator first;
+  unsigned long long n;
+  Engine rng;
+  RealType a, b;
+
+  uniform_variates(RandomAccessIterator first, unsigned long long n,
+                   const Engine &rng, RealType a, RealType b)
+    : first(first), n(n), rng(rng), a(a), b(b) {}
+
+  __host__ __device__
+  void operator()(unsigned long long item) const
+  {
+    unsigned long long i = item * variates_per_item;
+    unsigned long long end = (n - i < variates_per_item) ? n : i + variates_per_item;
+
+    Engine e = rng;
+    e.discard(i);
+
+    thrust::random::uniform_real_distribution<RealType> dist(a, b);
+
+    RandomAccessIterator out = first;
+    out += i;
+
+    for(; i < end; ++i, ++out)
+      *out = dist(e);
+  }
+}; // end uniform_variates
+
+
+template<typename RandomAccessIterator, typename Engine, typename RealType>
+  struct normal_variates
+{
+  RandomAccessIterator first;
+  unsigned long long n;
+  Engine rng;
+  RealType mean, stddev;
+
+  normal_variates(RandomAccessIterator first, unsigned long long n,
+                  const Engine &rng, RealType mean, RealType stddev)
+    : first(first), n(n), rng(rng), mean(mean), stddev(stddev) {}
+
+  __host__ __device__
+  void operator()(unsigned long long item) const
+  {
+    unsigned long long i = item * variates_per_item;
+    unsigned long long end = (n - i < variates_per_item) ? n : i + variates_per_item;
+
+    Engine e = rng;
+    e.discard(i);
+
+    thrust::random::uniform_real_distribution<RealType> dist(0, 1);
+
+    const RealType two_pi = static_cast<RealType>(6.2831853071795864769252867665590);
+
+    RandomAccessIterator out = first;
+    out += i;
+
+    // elements 2j and 2j+1 are the cosine and sine of one Box-Muller pair
+    for(; i < end; i += 2)
+    {
+      // u1 lies in (0,1] so that its logarithm is finite
+      RealType u1 = RealType(1) - dist(e);
+      RealType u2 = dist(e);
+
+      RealType r = static_cast<RealType>(sqrt(-2 * log(u1)));
+      RealType theta = two_pi * u2;
+
+      *out = mean + stddev * static_cast<RealType>(r * cos(theta));
+      ++out;
+
+      if(i + 1 < end)
+      {
+        *out = mean + stddev * static_cast<RealType>(r * sin(theta));
+        ++out;
+      }
+    }
+  }
+}; // end normal_variates
+
+} // end detail
+
+
+template<typename ForwardIterator, typename Engine, typename RealType>
+  void generate_uniform(ForwardIterator first,
+                        ForwardIterator last,
+                        const Engine &rng,
+                        RealType a,
+                        RealType b)
+{
+  const unsigned long long n = thrust::distance(first, last);
+  const unsigned long long num_items = (n + detail::variates_per_item - 1) / detail::variates_per_item;
+
+  // the items run in the space of the output
+  typedef typename thrust::iterator_space<ForwardIterator>::type Space;
+  thrust::counting_iterator<unsigned long long, Space> item(0);
+
+  thrust::for_each(item, item + num_items,
+                   detail::uniform_variates<ForwardIterator,Engine,RealType>(first, n, rng, a, b));
+} // end generate_uniform()
+
+
+template<typename ForwardIterator, typename Engine, typename RealType>
+  void generate_normal(ForwardIterator first,
+                       ForwardIterator last,
+                       const Engine &rng,
+                       RealType mean,
+                       RealType stddev)
+{
+  const unsigned long long n = thrust::distance(first, last);
+  const unsigned long long num_items = (n + detail::variates_per_item - 1) / detail::variates_per_item;
+
+  // the items run in the space of the output
+  typedef typename thrust::iterator_space<ForwardIterator>::type Space;
+  thrust::counting_iterator<unsigned long long, Space> item(0);
+
+  thrust::for_each(item, item + num_items,
+                   detail::normal_variates<ForwardIterator,Engine,RealType>(first, n, rng, mean, stddev));
+} // end generate_normal()
+
+
+
+} // end experimental
+
+} // end random
+
+} // end thrust
+
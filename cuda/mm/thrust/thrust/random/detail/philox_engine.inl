@@ -0,0 +1,238 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <thrust/random/philox_engine.h>
+#include <thrust/random/detail/random_core_access.h>
+
+namespace thrust
+{
+
+namespace random
+{
+
+namespace detail
+{
+
+struct philox4x32_bijection
+{
+  typedef thrust::detail::uint32_t uint32_t;
+  typedef thrust::detail::uint64_t uint64_t;
+
+  __host__ __device__ __inline__
+  static uint32_t mulhilo(uint32_t a, uint32_t b, uint32_t &hi)
+  {
+    uint64_t product = static_cast<uint64_t>(a) * static_cast<uint64_t>(b);
+    hi = static_cast<uint32_t>(product >> 32);
+    return static_cast<uint32_t>(product);
+  }
+
+  template<unsigned int rounds>
+  __host__ __device__
+  static void apply(uint32_t ctr[4], const uint32_t key[2])
+  {
+    const uint32_t M0 = 0xD2511F53u, M1 = 0xCD9E8D57u;
+    const uint32_t W0 = 0x9E3779B9u, W1 = 0xBB67AE85u;
+
+    uint32_t k0 = key[0], k1 = key[1];
+
+    for(unsigned int r = 0; r < rounds; ++r)
+    {
+      uint32_t hi0, hi1;
+      uint32_t lo0 = mulhilo(M0, ctr[0], hi0);
+      uint32_t lo1 = mulhilo(M1, ctr[2], hi1);
+
+      ctr[0] = hi1 ^ ctr[1] ^ k0;
+      ctr[1] = lo1;
+      ctr[2] = hi0 ^ ctr[3] ^ k1;
+      ctr[3] = lo0;
+
+      // bump the key with the Weyl sequence
+      k0 += W0;
+      k1 += W1;
+    }
+  }
+}; // end philox4x32_bijection
+
+} // end detail
+
+
+template<unsigned int rounds>
+  philox4x32_engine<rounds>
+    ::philox4x32_engine(seed_type s, seed_type stream)
+{
+  seed(s, stream);
+} // end philox4x32_engine::philox4x32_engine()
+
+
+template<unsigned int rounds>
+  void philox4x32_engine<rounds>
+    ::seed(seed_type s, seed_type stream)
+{
+  m_key[0]   = static_cast<result_type>(s);
+  m_key[1]   = static_cast<result_type>(s >> 32);
+  m_stream   = stream;
+  m_position = 0;
+} // end philox4x32_engine::seed()
+
+
+template<unsigned int rounds>
+  void philox4x32_engine<rounds>
+    ::generate_block(void)
+{
+  // the counter is (block index, stream id); block i holds positions [4i, 4i + 4)
+  const unsigned long long block = m_position >> 2;
+
+  m_block[0] = static_cast<result_type>(block);
+  m_block[1] = static_cast<result_type>(block >> 32);
+  m_block[2] = static_cast<result_type>(m_stream);
+  m_block[3] = static_cast<result_type>(m_stream >> 32);
+
+  detail::philox4x32_bijection::template apply<rounds>(m_block, m_key);
+} // end philox4x32_engine::generate_block()
+
+
+template<unsigned int rounds>
+  typename philox4x32_engine<rounds>::result_type
+    philox4x32_engine<rounds>
+      ::operator()(void)
+{
+  const unsigned int lane = static_cast<unsigned int>(m_position & 3);
+
+  // blocks are produced lazily when the position crosses into them
+  if(lane == 0)
+    generate_block();
+
+  ++m_position;
+
+  return m_block[lane];
+} // end philox4x32_engine::operator()()
+
+
+template<unsigned int rounds>
+  void philox4x32_engine<rounds>
+    ::discard(unsigned long long z)
+{
+  m_position += z;
+
+  // landing inside a block means its remaining lanes must be available
+  if(m_position & 3)
+    generate_block();
+} // end philox4x32_engine::discard()
+
+
+template<unsigned int rounds>
+  template<typename CharT, typename Traits>
+    std::basic_ostream<CharT,Traits>& philox4x32_engine<rounds>
+      ::stream_out(std::basic_ostream<CharT,Traits> &os) const
+{
+  typedef std::basic_ostream<CharT,Traits> ostream_type;
+  typedef typename ostream_type::ios_base  ios_base;
+
+  // save old flags & fill character
+  const typename ios_base::fmtflags flags = os.flags();
+  const CharT fill = os.fill();
+
+  const CharT space = os.widen(' ');
+  os.flags(ios_base::dec | ios_base::fixed | ios_base::left);
+  os.fill(space);
+
+  // output key, stream & position
+  os << m_key[0] << space << m_key[1] << space << m_stream << space << m_position;
+
+  // restore flags & fill character
+  os.flags(flags);
+  os.fill(fill);
+
+  return os;
+}
+
+
+template<unsigned int rounds>
+  template<typename CharT, typename Traits>
+    std::basic_istream<CharT,Traits>& philox4x32_engine<rounds>
+      ::stream_in(std::basic_istream<CharT,Traits> &is)
+{
+  typedef std::basic_istream<CharT,Traits> istream_type;
+  typedef typename istream_type::ios_base     ios_base;
+
+  // save old flags
+  const typename ios_base::fmtflags flags = is.flags();
+
+  is.flags(ios_base::dec | ios_base::skipws);
+
+  // input key, stream & position
+  is >> m_key[0] >> m_key[1] >> m_stream >> m_position;
+
+  // restore the partially consumed block, if any
+  if(m_position & 3)
+    generate_block();
+
+  // restore flags
+  is.flags(flags);
+
+  return is;
+}
+
+
+template<unsigned int rounds>
+bool philox4x32_engine<rounds>
+  ::equal(const philox4x32_engine<rounds> &rhs) const
+{
+  return m_key[0] == rhs.m_key[0] && m_key[1] == rhs.m_key[1] &&
+         m_stream == rhs.m_stream && m_position == rhs.m_position;
+}
+
+
+template<unsigned int rounds_>
+__host__ __device__
+bool operator==(const philox4x32_engine<rounds_> &lhs,
+                const philox4x32_engine<rounds_> &rhs)
+{
+  return detail::random_core_access::equal(lhs,rhs);
+}
+
+
+template<unsigned int rounds_>
+bool operator!=(const philox4x32_engine<rounds_> &lhs,
+                const philox4x32_engine<rounds_> &rhs)
+{
+  return !(lhs == rhs);
+}
+
+
+template<unsigned int rounds_, typename CharT, typename Traits>
+std::basic_ostream<CharT,Traits>&
+operator<<(std::basic_ostream<CharT,Traits> &os,
+           const philox4x32_engine<rounds_> &e)
+{
+  return detail::random_core_access::stream_out(os,e);
+}
+
+
+template<unsigned int rounds_, typename CharT, typename Traits>
+std::basic_istream<CharT,Traits>&
+operator>>(std::basic_istream<CharT,Traits> &is,
+           philox4x32_engine<rounds_> &e)
+{
+  return detail::random_core_access::stream_in(is,e);
+}
+
+
+} // end random
+
+} // end thrust
+
@@ -0,0 +1,257 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <thrust/random/threefry_engine.h>
+#include <thrust/random/detail/random_core_access.h>
+
+namespace thrust
+{
+
+namespace random
+{
+
+namespace detail
+{
+
+struct threefry4x32_bijection
+{
+  typedef thrust::detail::uint32_t uint32_t;
+
+  __host__ __device__ __inline__
+  static uint32_t rotl(uint32_t x, unsigned int n)
+  {
+    return (x << n) | (x >> (32 - n));
+  }
+
+  template<unsigned int rounds>
+  __host__ __device__
+  static void apply(uint32_t ctr[4], const uint32_t key[2])
+  {
+    // rotation constants of Threefry-4x32, indexed by round mod 8
+    const unsigned int R[8][2] = {{10, 26}, {11, 21}, {13, 27}, {23,  5},
+                                  { 6, 20}, {17, 11}, {25, 10}, {18, 20}};
+
+    // the key is (seed, 0); the fifth word is the parity of the other four
+    uint32_t ks[5];
+    ks[0] = key[0];
+    ks[1] = key[1];
+    ks[2] = 0;
+    ks[3] = 0;
+    ks[4] = 0x1BD11BDAu ^ ks[0] ^ ks[1] ^ ks[2] ^ ks[3];
+
+    uint32_t x0 = ctr[0] + ks[0], x1 = ctr[1] + ks[1];
+    uint32_t x2 = ctr[2] + ks[2], x3 = ctr[3] + ks[3];
+
+    for(unsigned int r = 0; r < rounds; ++r)
+    {
+      const unsigned int *rot = R[r & 7];
+
+      if((r & 1) == 0)
+      {
+        x0 += x1; x1 = rotl(x1, rot[0]); x1 ^= x0;
+        x2 += x3; x3 = rotl(x3, rot[1]); x3 ^= x2;
+      }
+      else
+      {
+        x0 += x3; x3 = rotl(x3, rot[0]); x3 ^= x0;
+        x2 += x1; x1 = rotl(x1, rot[1]); x1 ^= x2;
+      }
+
+      // inject the key schedule after every fourth round
+      if((r & 3) == 3)
+      {
+        const unsigned int s = (r >> 2) + 1;
+        x0 += ks[ s      % 5];
+        x1 += ks[(s + 1) % 5];
+        x2 += ks[(s + 2) % 5];
+        x3 += ks[(s + 3) % 5] + s;
+      }
+    }
+
+    ctr[0] = x0; ctr[1] = x1; ctr[2] = x2; ctr[3] = x3;
+  }
+}; // end threefry4x32_bijection
+
+} // end detail
+
+
+template<unsigned int rounds>
+  threefry4x32_engine<rounds>
+    ::threefry4x32_engine(seed_type s, seed_type stream)
+{
+  seed(s, stream);
+} // end threefry4x32_engine::threefry4x32_engine()
+
+
+template<unsigned int rounds>
+  void threefry4x32_engine<rounds>
+    ::seed(seed_type s, seed_type stream)
+{
+  m_key[0]   = static_cast<result_type>(s);
+  m_key[1]   = static_cast<result_type>(s >> 32);
+  m_stream   = stream;
+  m_position = 0;
+} // end threefry4x32_engine::seed()
+
+
+template<unsigned int rounds>
+  void threefry4x32_engine<rounds>
+    ::generate_block(void)
+{
+  // the counter is (block index, stream id); block i holds positions [4i, 4i + 4)
+  const unsigned long long block = m_position >> 2;
+
+  m_block[0] = static_cast<result_type>(block);
+  m_block[1] = static_cast<result_type>(block >> 32);
+  m_block[2] = static_cast<result_type>(m_stream);
+  m_block[3] = static_cast<result_type>(m_stream >> 32);
+
+  detail::threefry4x32_bijection::template apply<rounds>(m_block, m_key);
+} // end threefry4x32_engine::generate_block()
+
+
+template<unsigned int rounds>
+  typename threefry4x32_engine<rounds>::result_type
+    threefry4x32_engine<rounds>
+      ::operator()(void)
+{
+  const unsigned int lane = static_cast<unsigned int>(m_position & 3);
+
+  // blocks are produced lazily when the position crosses into them
+  if(lane == 0)
+    generate_block();
+
+  ++m_position;
+
+  return m_block[lane];
+} // end threefry4x32_engine::operator()()
+
+
+template<unsigned int rounds>
+  void threefry4x32_engine<rounds>
+    ::discard(unsigned long long z)
+{
+  m_position += z;
+
+  // landing inside a block means its remaining lanes must be available
+  if(m_position & 3)
+    generate_block();
+} // end threefry4x32_engine::discard()
+
+
+template<unsigned int rounds>
+  template<typename CharT, typename Traits>
+    std::basic_ostream<CharT,Traits>& threefry4x32_engine<rounds>
+      ::stream_out(std::basic_ostream<CharT,Traits> &os) const
+{
+  typedef std::basic_ostream<CharT,Traits> ostream_type;
+  typedef typename ostream_type::ios_base  ios_base;
+
+  // save old flags & fill character
+  const typename ios_base::fmtflags flags = os.flags();
+  const CharT fill = os.fill();
+
+  const CharT space = os.widen(' ');
+  os.flags(ios_base::dec | ios_base::fixed | ios_base::left);
+  os.fill(space);
+
+  // output key, stream & position
+  os << m_key[0] << space << m_key[1] << space << m_stream << space << m_position;
+
+  // restore flags & fill character
+  os.flags(flags);
+  os.fill(fill);
+
+  return os;
+}
+
+
+template<unsigned int rounds>
+  template<typename CharT, typename Traits>
+    std::basic_istream<CharT,Traits>& threefry4x32_engine<rounds>
+      ::stream_in(std::basic_istream<CharT,Traits> &is)
+{
+  typedef std::basic_istream<CharT,Traits> istream_type;
+  typedef typename istream_type::ios_base     ios_base;
+
+  // save old flags
+  const typename ios_base::fmtflags flags = is.flags();
+
+  is.flags(ios_base::dec | ios_base::skipws);
+
+  // input key, stream & position
+  is >> m_key[0] >> m_key[1] >> m_stream >> m_position;
+
+  // restore the partially consumed block, if any
+  if(m_position & 3)
+    generate_block();
+
+  // restore flags
+  is.flags(flags);
+
+  return is;
+}
+
+
+template<unsigned int rounds>
+bool threefry4x32_engine<rounds>
+  ::equal(const threefry4x32_engine<rounds> &rhs) const
+{
+  return m_key[0] == rhs.m_key[0] && m_key[1] == rhs.m_key[1] &&
+         m_stream == rhs.m_stream && m_position == rhs.m_position;
+}
+
+
+template<unsigned int rounds_>
+__host__ __device__
+bool operator==(const threefry4x32_engine<rounds_> &lhs,
+                const threefry4x32_engine<rounds_> &rhs)
+{
+  return detail::random_core_access::equal(lhs,rhs);
+}
+
+
+template<unsigned int rounds_>
+bool operator!=(const threefry4x32_engine<rounds_> &lhs,
+                const threefry4x32_engine<rounds_> &rhs)
+{
+  return !(lhs == rhs);
+}
+
+
+template<unsigned int rounds_, typename CharT, typename Traits>
+std::basic_ostream<CharT,Traits>&
+operator<<(std::basic_ostream<CharT,Traits> &os,
+           const threefry4x32_engine<rounds_> &e)
+{
+  return detail::random_core_access::stream_out(os,e);
+}
+
+
+template<unsigned int rounds_, typename CharT, typename Traits>
+std::basic_istream<CharT,Traits>&
+operator>>(std::basic_istream<CharT,Traits> &is,
+           threefry4x32_engine<rounds_> &e)
+{
+  return detail::random_core_access::stream_in(is,e);
+}
+
+
+} // end random
+
+} // end thrust
+
@@ -0,0 +1,118 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file generate.h
+ *  \brief Bulk generation of uniformly and normally distributed variates.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+namespace thrust {
+
+namespace random {
+
+namespace experimental {
+
+/*! \addtogroup random_number_distributions
+ *  \{
+ */
+
+/*! \p generate_uniform fills the range <tt>[first, last)</tt> with real numbers uniformly
+ *  distributed on <tt>[a, b)</tt>.  Element \c i is computed from the <tt>i</tt>-th value
+ *  \p rng would produce, so the result is identical for every backend and thread count.
+ *  The range is filled in parallel on the space of \p first, four consecutive elements
+ *  per work item so that each block of a 4x32 engine is generated once.
+ *
+ *  \param first The beginning of the range to fill.  \p ForwardIterator must also
+ *         be a model of Random Access Iterator.
+ *  \param last The end of the range to fill.
+ *  \param rng The engine whose sequence is consumed.  It is not modified; call
+ *         <tt>rng.discard(last - first)</tt> to continue past the generated values.
+ *  \param a The lower bound of the distribution.
+ *  \param b The upper bound of the distribution.
+ *
+ *  \note Each element seeks \p rng with \p discard, so this is intended for engines whose
+ *        \p discard runs in constant time, such as \p philox4x32 and \p threefry4x32.
+ *
+ *  The following code snippet fills a \p device_vector with random floats in <tt>[0, 100)</tt>:
+ *
+ *  \code
+ *  #include <thrust/random.h>
+ *  #include <thrust/device_vector.h>
+ *
+ *  int main(void)
+ *  {
+ *    thrust::device_vector<float> v(1 << 20);
+ *
+ *    thrust::random::experimental::generate_uniform(v.begin(), v.end(),
+ *                                                   thrust::philox4x32(13), 0.0f, 100.0f);
+ *
+ *    return 0;
+ *  }
+ *  \endcode
+ *
+ *  \see generate_normal
+ */
+template<typename ForwardIterator, typename Engine, typename RealType>
+void generate_uniform(ForwardIterator first,
+                      ForwardIterator last,
+                      const Engine& rng,
+                      RealType a,
+                      RealType b);
+
+
+/*! \p generate_normal fills the range <tt>[first, last)</tt> with real numbers drawn from the
+ *  Normal distribution with the given mean and standard deviation.  Elements <tt>2j</tt> and
+ *  <tt>2j+1</tt> are the cosine and sine outputs of the Box-Muller transform of values
+ *  <tt>2j</tt> and <tt>2j+1</tt> of \p rng's sequence, so the result is identical for every
+ *  backend and thread count.  The range is filled in parallel on the space of \p first,
+ *  four consecutive elements per work item.
+ *
+ *  \param first The beginning of the range to fill.  \p ForwardIterator must also
+ *         be a model of Random Access Iterator.
+ *  \param last The end of the range to fill.
+ *  \param rng The engine whose sequence is consumed.  It is not modified; call
+ *         <tt>rng.discard((last - first + 1) / 2 * 2)</tt> to continue past the generated
+ *         values.
+ *  \param mean The mean of the distribution.
+ *  \param stddev The standard deviation of the distribution.
+ *
+ *  \note Each element seeks \p rng with \p discard, so this is intended for engines whose
+ *        \p discard runs in constant time, such as \p philox4x32 and \p threefry4x32.
+ *
+ *  \see generate_uniform
+ */
+template<typename ForwardIterator, typename Engine, typename RealType>
+void generate_normal(ForwardIterator first,
+                     ForwardIterator last,
+                     const Engine& rng,
+                     RealType mean,
+                     RealType stddev);
+
+/*! \} // end random_number_distributions
+ */
+
+} // end experimental
+
+} // end random
+
+} // end thrust
+
+#include <thrust/random/detail/generate.inl>
+
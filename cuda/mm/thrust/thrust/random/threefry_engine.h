@@ -0,0 +1,248 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file threefry_engine.h
+ *  \brief A counter-based pseudorandom number engine built on the Threefry bijection.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <iostream>
+#include <thrust/detail/cstdint.h>
+#include <thrust/random/detail/random_core_access.h>
+
+namespace thrust {
+
+namespace random {
+
+/*! \addtogroup random_number_engine_templates Random Number Engine Class Templates
+ *  \ingroup random
+ *  \{
+ */
+
+/*! \class threefry4x32_engine
+ *  \brief A \p threefry4x32_engine random number engine produces 32-bit unsigned integer
+ *         random numbers by encrypting a 128-bit counter with the Threefry block function
+ *         of Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3" (SC'11), a
+ *         reduced variant of the Threefish cipher which needs only adds, rotates and xors.
+ *
+ *         The seed fills the low half of the 128-bit key.  The low two words of the counter hold the
+ *         block index and the high two words hold a user-supplied stream id, so engines
+ *         with equal seeds and distinct streams never overlap.  Each block yields four
+ *         values.  Because the state is simply a position, \p discard runs in constant
+ *         time, which makes it cheap to give every element of a parallel computation
+ *         its own disjoint subsequence.
+ *
+ *  \tparam rounds The number of Threefry rounds to apply to each block.
+ *
+ *  \note Inexperienced users should not use this class template directly.  Instead, use
+ *  \p threefry4x32.
+ *
+ *  The following code snippet shows examples of use of a \p threefry4x32_engine instance:
+ *
+ *  \code
+ *  #include <thrust/random/threefry_engine.h>
+ *  #include <iostream>
+ *
+ *  int main(void)
+ *  {
+ *    // create a threefry4x32 object with seed 7 on stream 3
+ *    thrust::threefry4x32 rng(7, 3);
+ *
+ *    // jump a billion values ahead, in constant time
+ *    rng.discard(1000000000ull);
+ *
+ *    // output the next random value to cout
+ *    std::cout << rng() << std::endl;
+ *
+ *    return 0;
+ *  }
+ *  \endcode
+ *
+ *  \see thrust::random::threefry4x32
+ *  \see thrust::random::philox4x32_engine
+ */
+template<unsigned int rounds>
+class threefry4x32_engine {
+public:
+    // types
+
+    /*! \typedef result_type
+     *  \brief The type of the unsigned integer produced by this \p threefry4x32_engine.
+     */
+    typedef thrust::detail::uint32_t result_type;
+
+    /*! \typedef seed_type
+     *  \brief The type of the seed and stream id accepted by this \p threefry4x32_engine.
+     */
+    typedef thrust::detail::uint64_t seed_type;
+
+    // engine characteristics
+
+    /*! The number of rounds applied to each block.
+     */
+    static const unsigned int round_count = rounds;
+
+    /*! The smallest value this \p threefry4x32_engine may potentially produce.
+     */
+    static const result_type min = 0u;
+
+    /*! The largest value this \p threefry4x32_engine may potentially produce.
+     */
+    static const result_type max = 0xffffffffu;
+
+    /*! The default seed of this \p threefry4x32_engine.
+     */
+    static const result_type default_seed = 0u;
+
+    // constructors and seeding functions
+
+    /*! This constructor, which optionally accepts a seed and a stream id, initializes a new
+     *  \p threefry4x32_engine positioned at the beginning of its sequence.
+     *
+     *  \param s The seed used as this \p threefry4x32_engine's key.
+     *  \param stream The id of the subsequence this \p threefry4x32_engine produces.
+     */
+    __host__ __device__
+    explicit threefry4x32_engine(seed_type s = default_seed, seed_type stream = 0);
+
+    /*! This method initializes this \p threefry4x32_engine's state, and optionally accepts
+     *  a seed and a stream id.
+     *
+     *  \param s The seed used as this \p threefry4x32_engine's key.
+     *  \param stream The id of the subsequence this \p threefry4x32_engine produces.
+     */
+    __host__ __device__
+    void seed(seed_type s = default_seed, seed_type stream = 0);
+
+    // generating functions
+
+    /*! This member function produces a new random value and updates this \p threefry4x32_engine's state.
+     *  \return A new random number.
+     */
+    __host__ __device__
+    result_type operator()(void);
+
+    /*! This member function advances this \p threefry4x32_engine's state a given number of times
+     *  and discards the results.  It runs in constant time.
+     *
+     *  \param z The number of random values to discard.
+     */
+    __host__ __device__
+    void discard(unsigned long long z);
+
+    /*! \cond
+     */
+private:
+    result_type m_key[2];
+    seed_type m_stream;
+    unsigned long long m_position;
+    result_type m_block[4];
+
+    __host__ __device__
+    void generate_block(void);
+
+    friend struct thrust::random::detail::random_core_access;
+
+    __host__ __device__
+    bool equal(const threefry4x32_engine& rhs) const;
+
+    template<typename CharT, typename Traits>
+    std::basic_ostream<CharT, Traits>& stream_out(std::basic_ostream<CharT, Traits>& os) const;
+
+    template<typename CharT, typename Traits>
+    std::basic_istream<CharT, Traits>& stream_in(std::basic_istream<CharT, Traits>& is);
+
+    /*! \endcond
+     */
+}; // end threefry4x32_engine
+
+
+/*! This function checks two \p threefry4x32_engines for equality.
+ *  \param lhs The first \p threefry4x32_engine to test.
+ *  \param rhs The second \p threefry4x32_engine to test.
+ *  \return \c true if \p lhs is equal to \p rhs; \c false, otherwise.
+ */
+template<unsigned int rounds_>
+__host__ __device__
+bool operator==(const threefry4x32_engine<rounds_>& lhs,
+                const threefry4x32_engine<rounds_>& rhs);
+
+
+/*! This function checks two \p threefry4x32_engines for inequality.
+ *  \param lhs The first \p threefry4x32_engine to test.
+ *  \param rhs The second \p threefry4x32_engine to test.
+ *  \return \c true if \p lhs is not equal to \p rhs; \c false, otherwise.
+ */
+template<unsigned int rounds_>
+__host__ __device__
+bool operator!=(const threefry4x32_engine<rounds_>& lhs,
+                const threefry4x32_engine<rounds_>& rhs);
+
+
+/*! This function streams a threefry4x32_engine to a \p std::basic_ostream.
+ *  \param os The \p basic_ostream to stream out to.
+ *  \param e The \p threefry4x32_engine to stream out.
+ *  \return \p os
+ */
+template<unsigned int rounds_, typename CharT, typename Traits>
+std::basic_ostream<CharT, Traits>&
+operator<<(std::basic_ostream<CharT, Traits>& os,
+           const threefry4x32_engine<rounds_>& e);
+
+
+/*! This function streams a threefry4x32_engine in from a std::basic_istream.
+ *  \param is The \p basic_istream to stream from.
+ *  \param e The \p threefry4x32_engine to stream in.
+ *  \return \p is
+ */
+template<unsigned int rounds_, typename CharT, typename Traits>
+std::basic_istream<CharT, Traits>&
+operator>>(std::basic_istream<CharT, Traits>& is,
+           threefry4x32_engine<rounds_>& e);
+
+
+/*! \} // random_number_engine_templates
+ */
+
+
+/*! \addtogroup predefined_random
+ *  \{
+ */
+
+/*! \typedef threefry4x32
+ *  \brief A random number engine with predefined parameters which implements the
+ *         Threefry-4x32-20 counter-based random number generation algorithm.
+ *  \note The first four invocations of a default-constructed object of type \p threefry4x32
+ *        shall produce the values \c 0x9c6ca96a, \c 0xe17eae66, \c 0xfc10ecd4 and \c 0x5256a7d8 .
+ */
+typedef threefry4x32_engine<20> threefry4x32;
+
+/*! \} // predefined_random
+ */
+
+} // end random
+
+// import names into thrust::
+using random::threefry4x32_engine;
+using random::threefry4x32;
+
+} // end thrust
+
+#include <thrust/random/detail/threefry_engine.inl>
+
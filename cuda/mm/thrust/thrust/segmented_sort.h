@@ -0,0 +1,209 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file segmented_sort.h
+ *  \brief Sorting many independent segments of a range.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+namespace thrust {
+
+/*! \addtogroup sorting
+ *  \{
+ */
+
+/*! \p segmented_sort sorts each of the segments
+ *  <tt>[keys_first + begin_offsets_first[i], keys_first + end_offsets_first[i])</tt>,
+ *  for \c i in <tt>[0, begin_offsets_last - begin_offsets_first)</tt>,
+ *  into ascending order using \c operator<.  Segments may be empty, and
+ *  elements outside every segment are left untouched, so both CSR style
+ *  offsets (the end offsets are the begin offsets shifted by one) and
+ *  fixed stride lists with per-segment counts can be described.  The
+ *  segments must not overlap.  The sort is not stable.
+ *
+ *  \p segmented_sort is meant for many small segments, such as per-atom
+ *  neighbor lists.  Segments of at most 32 elements are sorted with a
+ *  sorting network in registers; on the OpenMP backend the segments are
+ *  sorted in parallel.
+ *
+ *  \param keys_first The beginning of the keys.
+ *  \param begin_offsets_first The beginning of the offsets at which the segments begin.
+ *  \param begin_offsets_last The end of the offsets at which the segments begin.
+ *  \param end_offsets_first The beginning of the offsets at which the segments end.
+ *
+ *  \tparam RandomAccessIterator is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>,
+ *          \p RandomAccessIterator is mutable,
+ *          and \p RandomAccessIterator's \c value_type is a model of <a href="http://www.sgi.com/tech/stl/LessThanComparable.html">LessThan Comparable</a>.
+ *  \tparam InputIterator1 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>
+ *          whose \c value_type is an integral type.
+ *  \tparam InputIterator2 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>
+ *          whose \c value_type is an integral type.
+ *
+ *  The following code snippet demonstrates how to use \p segmented_sort
+ *  to sort three segments of an array.
+ *
+ *  \code
+ *  #include <thrust/segmented_sort.h>
+ *  ...
+ *  int A[8]     = {3, 1, 2, 9, 5, 7, 6, 4};
+ *  int begin[3] = {0, 3, 5};
+ *  int end[3]   = {3, 5, 8};
+ *
+ *  thrust::segmented_sort(A, begin, begin + 3, end);
+ *  // A is now {1, 2, 3, 5, 9, 4, 6, 7}
+ *  \endcode
+ *
+ *  \see \p sort
+ */
+template < typename RandomAccessIterator,
+         typename InputIterator1,
+         typename InputIterator2 >
+void segmented_sort(RandomAccessIterator keys_first,
+                    InputIterator1 begin_offsets_first,
+                    InputIterator1 begin_offsets_last,
+                    InputIterator2 end_offsets_first);
+
+/*! \p segmented_sort sorts each of the segments
+ *  <tt>[keys_first + begin_offsets_first[i], keys_first + end_offsets_first[i])</tt>
+ *  into ascending order using the function object \p comp.  The sort is
+ *  not stable.
+ *
+ *  \param keys_first The beginning of the keys.
+ *  \param begin_offsets_first The beginning of the offsets at which the segments begin.
+ *  \param begin_offsets_last The end of the offsets at which the segments begin.
+ *  \param end_offsets_first The beginning of the offsets at which the segments end.
+ *  \param comp Comparison operator.
+ *
+ *  \tparam RandomAccessIterator is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>,
+ *          \p RandomAccessIterator is mutable,
+ *          and \p RandomAccessIterator's \c value_type is convertible to \p StrictWeakOrdering's
+ *          \c first_argument_type and \c second_argument_type.
+ *  \tparam InputIterator1 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>
+ *          whose \c value_type is an integral type.
+ *  \tparam InputIterator2 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>
+ *          whose \c value_type is an integral type.
+ *  \tparam StrictWeakOrdering is a model of <a href="http://www.sgi.com/tech/stl/StrictWeakOrdering.html">Strict Weak Ordering</a>.
+ *
+ *  \see \p sort
+ */
+template < typename RandomAccessIterator,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename StrictWeakOrdering >
+void segmented_sort(RandomAccessIterator keys_first,
+                    InputIterator1 begin_offsets_first,
+                    InputIterator1 begin_offsets_last,
+                    InputIterator2 end_offsets_first,
+                    StrictWeakOrdering comp);
+
+/*! \p segmented_sort_by_key sorts the keys of each segment like
+ *  \p segmented_sort and applies the same permutation to the values
+ *  at the same positions of <tt>values_first</tt>.  The sort is not stable.
+ *
+ *  \param keys_first The beginning of the keys.
+ *  \param values_first The beginning of the values.
+ *  \param begin_offsets_first The beginning of the offsets at which the segments begin.
+ *  \param begin_offsets_last The end of the offsets at which the segments begin.
+ *  \param end_offsets_first The beginning of the offsets at which the segments end.
+ *
+ *  \tparam RandomAccessIterator1 is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>,
+ *          \p RandomAccessIterator1 is mutable,
+ *          and \p RandomAccessIterator1's \c value_type is a model of <a href="http://www.sgi.com/tech/stl/LessThanComparable.html">LessThan Comparable</a>.
+ *  \tparam RandomAccessIterator2 is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>,
+ *          and \p RandomAccessIterator2 is mutable.
+ *  \tparam InputIterator1 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>
+ *          whose \c value_type is an integral type.
+ *  \tparam InputIterator2 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>
+ *          whose \c value_type is an integral type.
+ *
+ *  The following code snippet demonstrates how to use \p segmented_sort_by_key
+ *  to order fixed stride neighbor lists by distance.
+ *
+ *  \code
+ *  #include <thrust/segmented_sort.h>
+ *  ...
+ *  // two atoms with room for four neighbors each
+ *  float distance[8] = {2.0f, 0.5f, 1.0f, 0.0f,  3.0f, 1.5f, 0.0f, 0.0f};
+ *  int   neighbor[8] = {   7,    4,    9,   -1,     2,    5,   -1,   -1};
+ *  int   begin[2]    = {0, 4};
+ *  int   end[2]      = {3, 6};  // three and two neighbors
+ *
+ *  thrust::segmented_sort_by_key(distance, neighbor, begin, begin + 2, end);
+ *  // distance is now {0.5f, 1.0f, 2.0f, 0.0f,  1.5f, 3.0f, 0.0f, 0.0f}
+ *  // neighbor is now {   4,    9,    7,   -1,     5,    2,   -1,   -1}
+ *  \endcode
+ *
+ *  \see \p sort_by_key
+ */
+template < typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename InputIterator1,
+         typename InputIterator2 >
+void segmented_sort_by_key(RandomAccessIterator1 keys_first,
+                           RandomAccessIterator2 values_first,
+                           InputIterator1 begin_offsets_first,
+                           InputIterator1 begin_offsets_last,
+                           InputIterator2 end_offsets_first);
+
+/*! \p segmented_sort_by_key sorts the keys of each segment using the
+ *  function object \p comp and applies the same permutation to the
+ *  values at the same positions of <tt>values_first</tt>.  The sort is
+ *  not stable.
+ *
+ *  \param keys_first The beginning of the keys.
+ *  \param values_first The beginning of the values.
+ *  \param begin_offsets_first The beginning of the offsets at which the segments begin.
+ *  \param begin_offsets_last The end of the offsets at which the segments begin.
+ *  \param end_offsets_first The beginning of the offsets at which the segments end.
+ *  \param comp Comparison operator.
+ *
+ *  \tparam RandomAccessIterator1 is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>,
+ *          \p RandomAccessIterator1 is mutable,
+ *          and \p RandomAccessIterator1's \c value_type is convertible to \p StrictWeakOrdering's
+ *          \c first_argument_type and \c second_argument_type.
+ *  \tparam RandomAccessIterator2 is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>,
+ *          and \p RandomAccessIterator2 is mutable.
+ *  \tparam InputIterator1 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>
+ *          whose \c value_type is an integral type.
+ *  \tparam InputIterator2 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>
+ *          whose \c value_type is an integral type.
+ *  \tparam StrictWeakOrdering is a model of <a href="http://www.sgi.com/tech/stl/StrictWeakOrdering.html">Strict Weak Ordering</a>.
+ *
+ *  \see \p sort_by_key
+ */
+template < typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename StrictWeakOrdering >
+void segmented_sort_by_key(RandomAccessIterator1 keys_first,
+                           RandomAccessIterator2 values_first,
+                           InputIterator1 begin_offsets_first,
+                           InputIterator1 begin_offsets_last,
+                           InputIterator2 end_offsets_first,
+                           StrictWeakOrdering comp);
+
+/*! \} // end sorting
+ */
+
+} // end thrust
+
+#include <thrust/detail/segmented_sort.inl>
+
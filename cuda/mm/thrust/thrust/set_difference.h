@@ -0,0 +1,123 @@
+/*
+ *  Copyright 2008-2010 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file set_difference.h
+ *  \brief Set difference for sorted ranges.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+namespace thrust {
+
+/*! \addtogroup set_operations
+ *  \{
+ */
+
+/*! \p set_difference constructs a sorted range that is the
+ *  difference of sorted ranges <tt>[first1, last1)</tt> and
+ *  <tt>[first2, last2)</tt>: the elements of the first range which are
+ *  not in the second. The return value is the end of the output range.
+ *
+ *  If a value appears \c m times in <tt>[first1, last1)</tt> and \c n
+ *  times in <tt>[first2, last2)</tt>, then it appears <tt>max(m-n,0)</tt>
+ *  times in the output range. \p set_difference is stable: the
+ *  relative order of the output is the same as in the first range.
+ *
+ *  This version of \p set_difference compares objects using
+ *  \c operator<.
+ *
+ *  \param first1 The beginning of the first input range.
+ *  \param last1 The end of the first input range.
+ *  \param first2 The beginning of the second input range.
+ *  \param last2 The end of the second input range.
+ *  \param result The beginning of the output range.
+ *  \return The end of the output range.
+ *
+ *  \tparam InputIterator1 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          \p InputIterator1 and \p InputIterator2 have the same \c value_type,
+ *          \p InputIterator1's \c value_type is a model of <a href="http://www.sgi.com/tech/stl/LessThanComparable">LessThan Comparable</a>,
+ *          and \p InputIterator1's \c value_type is convertable to a type in \p OutputIterator's set of \c value_types.
+ *  \tparam InputIterator2 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          \p InputIterator2 and \p InputIterator1 have the same \c value_type,
+ *          \p InputIterator2's \c value_type is a model of <a href="http://www.sgi.com/tech/stl/LessThanComparable">LessThan Comparable</a>,
+ *          and \p InputIterator2's \c value_type is convertable to a type in \p OutputIterator's set of \c value_types.
+ *  \tparam OutputIterator is a model of <a href="http://www.sgi.com/tech/stl/OutputIterator.html">Output Iterator</a>.
+ *
+ *  The following code snippet demonstrates how to use
+ *  \p set_difference to compute the difference of two sorted sets of integers.
+ *
+ *  \code
+ *  #include <thrust/set_difference.h>
+ *  ...
+ *  int A1[6] = {1, 3, 5, 7, 9, 11};
+ *  int A2[7] = {1, 1, 2, 3, 5,  8, 13};
+ *
+ *  int result[6];
+ *
+ *  int *result_end = thrust::set_difference(A1, A1 + 6, A2, A2 + 7, result);
+ *  // result[0] = 7
+ *  // result[1] = 9
+ *  // result[2] = 11
+ *  // values beyond result[2] are undefined
+ *  \endcode
+ *
+ *  \see http://www.sgi.com/tech/stl/set_difference.html
+ *  \see \p sort
+ *  \see \p is_sorted
+ */
+template < typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator >
+OutputIterator set_difference(InputIterator1 first1,
+                              InputIterator1 last1,
+                              InputIterator2 first2,
+                              InputIterator2 last2,
+                              OutputIterator result);
+
+
+/*! This version of \p set_difference compares objects using the
+ *  function object \p comp, which must be a strict weak ordering
+ *  under which both input ranges are sorted.
+ *
+ *  \param first1 The beginning of the first input range.
+ *  \param last1 The end of the first input range.
+ *  \param first2 The beginning of the second input range.
+ *  \param last2 The end of the second input range.
+ *  \param result The beginning of the output range.
+ *  \param comp Comparison operator.
+ *  \return The end of the output range.
+ */
+template < typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering >
+OutputIterator set_difference(InputIterator1 first1,
+                              InputIterator1 last1,
+                              InputIterator2 first2,
+                              InputIterator2 last2,
+                              OutputIterator result,
+                              StrictWeakOrdering comp);
+
+/*! \} // end set_operations
+ */
+
+} // end thrust
+
+#include <thrust/detail/set_difference.inl>
+
@@ -92,6 +92,98 @@ OutputType transform_reduce(InputIterator first,
                             OutputType init,
                             BinaryFunction binary_op);
 
+
+/*! \p multi_transform_reduce computes several transformed reductions of
+ *  the sequence <tt>[first, last)</tt> in a single pass.  \p unary_ops,
+ *  \p init and \p binary_ops are tuples of equal length: element \c i of
+ *  the result is the reduction with <tt>get<i>(binary_ops)</tt> of
+ *  <tt>get<i>(unary_ops)</tt> applied to every element of the sequence,
+ *  initialized with <tt>get<i>(init)</tt>.
+ *
+ *  Compared to a \p transform_reduce per result, the input is read once and
+ *  no intermediate sequence is stored.  Several input sequences are reduced
+ *  together by passing a \p zip_iterator, whose elements are tuples.  The
+ *  order of reduction is not specified, so every binary operation must be
+ *  both commutative and associative.
+ *
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param unary_ops A \p tuple of functions to apply to each element of the sequence.
+ *  \param init A \p tuple of initial values.
+ *  \param binary_ops A \p tuple of reduction operations.
+ *  \return A \p tuple of the results of the transformed reductions.
+ *
+ *  \tparam InputIterator is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>.
+ *  \tparam UnaryFunctionTuple is a \p tuple of models of <a href="http://www.sgi.com/tech/stl/UnaryFunction.html">Unary Function</a>.
+ *  \tparam OutputTuple is a \p tuple of models of <a href="http://www.sgi.com/tech/stl/Assignable.html">Assignable</a>.
+ *  \tparam BinaryFunctionTuple is a \p tuple of models of <a href="http://www.sgi.com/tech/stl/BinaryFunction.html">Binary Function</a>.
+ *
+ *  The following code snippet demonstrates how to use \p multi_transform_reduce
+ *  to compute the sum and the maximum of the absolute values of a range.
+ *
+ *  \code
+ *  #include <thrust/transform_reduce.h>
+ *  #include <thrust/functional.h>
+ *  #include <thrust/tuple.h>
+ *  ...
+ *  int data[6] = {-1, 0, -2, -2, 1, -3};
+ *  thrust::tuple<int,int> result =
+ *    thrust::multi_transform_reduce(data, data + 6,
+ *                                   thrust::make_tuple(thrust::identity<int>(), thrust::absolute_value<int>()),
+ *                                   thrust::make_tuple(0, 0),
+ *                                   thrust::make_tuple(thrust::plus<int>(), thrust::maximum<int>()));
+ *  // thrust::get<0>(result) == -7
+ *  // thrust::get<1>(result) == 3
+ *  \endcode
+ *
+ *  \see \c transform_reduce
+ *  \see \c zip_iterator
+ */
+template < typename InputIterator,
+         typename UnaryFunctionTuple,
+         typename OutputTuple,
+         typename BinaryFunctionTuple >
+OutputTuple multi_transform_reduce(InputIterator first,
+                                   InputIterator last,
+                                   UnaryFunctionTuple unary_ops,
+                                   OutputTuple init,
+                                   BinaryFunctionTuple binary_ops);
+
+/*! This version of \p multi_transform_reduce sums every transformed
+ *  sequence, as if every element of \p binary_ops were \p plus.
+ *
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param unary_ops A \p tuple of functions to apply to each element of the sequence.
+ *  \param init A \p tuple of initial values.
+ *  \return A \p tuple of the sums of the transformed sequences.
+ *
+ *  The following code snippet demonstrates how to compute the sums,
+ *  sums of squares and sum of products of two sequences in one pass.
+ *
+ *  \code
+ *  #include <thrust/transform_reduce.h>
+ *  #include <thrust/iterator/zip_iterator.h>
+ *  ...
+ *  struct x  { template<typename T> __host__ __device__ float operator()(const T& t) const { return thrust::get<0>(t); } };
+ *  struct xx { template<typename T> __host__ __device__ float operator()(const T& t) const { return thrust::get<0>(t) * thrust::get<0>(t); } };
+ *  struct xy { template<typename T> __host__ __device__ float operator()(const T& t) const { return thrust::get<0>(t) * thrust::get<1>(t); } };
+ *  ...
+ *  thrust::tuple<float,float,float> sums =
+ *    thrust::multi_transform_reduce(thrust::make_zip_iterator(thrust::make_tuple(a.begin(), b.begin())),
+ *                                   thrust::make_zip_iterator(thrust::make_tuple(a.end(),   b.end())),
+ *                                   thrust::make_tuple(x(), xx(), xy()),
+ *                                   thrust::make_tuple(0.0f, 0.0f, 0.0f));
+ *  \endcode
+ */
+template < typename InputIterator,
+         typename UnaryFunctionTuple,
+         typename OutputTuple >
+OutputTuple multi_transform_reduce(InputIterator first,
+                                   InputIterator last,
+                                   UnaryFunctionTuple unary_ops,
+                                   OutputTuple init);
+
 /*! \} // end transformed_reductions
  *  \} // end reductions
  */
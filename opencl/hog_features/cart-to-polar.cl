@@ -29,3 +29,32 @@ __kernel void cart2polar(__global float* xpart, __global float* ypart, __global
     magnitude[curId] = sqrt((x * x) + (y * y));
 }
 
+
+// 8-bit fast path: clamped central differences as in xfilter / yfilter on
+// the uchar frame, binned by octant comparisons instead of atan2 and
+// weighted by floor(10 * |g| / 255) from squared magnitude thresholds
+// instead of sqrt, written as (weight << 3) | bin.  CHECK octant_bin and
+// integer_weight in hog_cpu.cpp also
+__kernel void grad_bins_u8(__global const uchar* img, __global uchar* packed, int rows, int cols) {
+    int i = get_global_id(0);
+    int j = get_global_id(1);
+    if (i >= rows || j >= cols) { return; }
+    int curId = i * cols + j;
+    int right = (j >= cols - 1) ? curId : curId + 1;
+    int left  = (j < 1) ? curId : curId - 1;
+    int down  = (i >= rows - 1) ? curId : curId + cols;
+    int up    = (i < 1) ? curId : curId - cols;
+    int x = (int)img[right] - (int)img[left];
+    int y = (int)img[down] - (int)img[up];
+
+    int s100 = 100 * (x * x + y * y);
+    int w = 0;
+    while (w < 15 && s100 >= 65025 * (w + 1) * (w + 1)) { ++w; }
+
+    int base = 0;
+    if (y < 0 || (y == 0 && x < 0)) { x = -x; y = -y; base = 4; }  // [180, 360)
+    int bin = (x > 0) ? base + (y < x ? 0 : 1) : base + (y > -x ? 2 : 3);
+
+    packed[curId] = (uchar)((w << 3) | bin);
+}
+
@@ -0,0 +1,485 @@
+/*
+   Copyright [2011] [Chris McClanahan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+//
+// Native CPU HOG engine
+//
+// The image is processed in bands of one cell row (CELLDIM image rows),
+// which fit in cache and are spread over threads.  Each image row of a band
+// is differentiated, converted to magnitude and orientation bin and binned
+// into the band's cell histograms straight away, so none of the gradient,
+// angle or magnitude images is ever written out.
+//
+
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "hog_cpu.h"
+
+#define NBINS    8  // CHECK in main.cpp and kernels.cl also
+#define CELLDIM  16
+#define HOG_PI   3.14159265f
+
+
+// orientation bin of gradient (gx, gy), as in cart2polar + histograms
+static inline int orientation_bin(float gx, float gy) {
+    float a = atan2f(gy, gx);
+    float ang = (a < 0) ? a + 2 * HOG_PI : a;
+    int h = (ang * (180.f / HOG_PI)) / (360.f / (float)NBINS);
+    return h >= NBINS ? NBINS - 1 : h;
+}
+
+
+// orientation bin of an integer gradient, from its octant: the same
+// sectors as orientation_bin, decided by sign and |gx| vs |gy| comparisons
+// CHECK grad_bins_u8 in cart-to-polar.cl also
+static inline int octant_bin(int gx, int gy) {
+    int base = 0;
+    if (gy < 0 || (gy == 0 && gx < 0)) { gx = -gx; gy = -gy; base = NBINS / 2; }  // [180, 360)
+    if (gx > 0) { return base + (gy < gx ? 0 : 1); }
+    return base + (gy > -gx ? 2 : 3);
+}
+
+// histogram weight of an 8-bit gradient, floor(10 * |g| / 255) as the
+// float path's (int)(mag * 10) on a [0, 1] image, from squared magnitude
+// thresholds: weight w needs 100 * (gx^2 + gy^2) >= (255 * w)^2
+static inline int integer_weight(int gx, int gy) {
+    int s100 = 100 * (gx * gx + gy * gy);
+    int w = 0;
+    while (w < 15 && s100 >= 65025 * (w + 1) * (w + 1)) { ++w; }
+    return w;
+}
+
+// (weight << 3) | bin of every 8-bit gradient, indexed by
+// (gx + 255) * 511 + (gy + 255); weight is at most 14, so one byte does
+#define GRAD_LUT_DIM 511
+struct grad_lut {
+    std::vector<unsigned char> packed;
+    grad_lut() : packed(GRAD_LUT_DIM * GRAD_LUT_DIM) {
+        for (int gx = -255; gx <= 255; ++gx) {
+            for (int gy = -255; gy <= 255; ++gy) {
+                packed[(gx + 255) * GRAD_LUT_DIM + (gy + 255)] =
+                    (integer_weight(gx, gy) << 3) | octant_bin(gx, gy);
+            }
+        }
+    }
+};
+
+static const unsigned char* packed_bins() {
+    static const grad_lut lut;  // built once, on first use
+    return &lut.packed[0];
+}
+
+
+// x gradient at column c, clamped at the image border as in xfilter
+static inline float xgrad(const float* row, int c, int cols) {
+    int right = (c >= cols - 1) ? c : c + 1;
+    int left  = (c < 1) ? c : c - 1;
+    return row[right] - row[left];
+}
+static inline short xgrad(const unsigned char* row, int c, int cols) {
+    int right = (c >= cols - 1) ? c : c + 1;
+    int left  = (c < 1) ? c : c - 1;
+    return (short)row[right] - (short)row[left];
+}
+
+
+// per thread scratch for one image row
+struct float_rows {
+    std::vector<float> gx, gy, mag;
+    explicit float_rows(int width) : gx(width), gy(width), mag(width) {}
+};
+struct u8_rows {
+    std::vector<short> gx, gy;
+    explicit u8_rows(int width) : gx(width), gy(width) {}
+};
+
+
+// bins one image row of a band into the band's cell histograms
+static void bin_row(const float* img, int rows, int cols, int y, int c_start, int width,
+                    float_rows& scratch, int* sbins) {
+
+    float* gx  = &scratch.gx[0];
+    float* gy  = &scratch.gy[0];
+    float* mag = &scratch.mag[0];
+
+    // clamped neighbors, as in xfilter / yfilter
+    const float* row  = img + y * cols;
+    const float* up   = img + (y > 0 ? y - 1 : y) * cols;
+    const float* down = img + (y < rows - 1 ? y + 1 : y) * cols;
+
+    // gradients and magnitudes: straight line loops, vectorized by the compiler
+    for (int x = 0; x < width; ++x) {
+        int c = c_start + x;
+        gy[x] = down[c] - up[c];
+    }
+    for (int x = 1; x < width - 1; ++x) {
+        int c = c_start + x;
+        gx[x] = row[c + 1] - row[c - 1];
+    }
+    gx[0]         = xgrad(row, c_start, cols);
+    gx[width - 1] = xgrad(row, c_start + width - 1, cols);
+    for (int x = 0; x < width; ++x) {
+        mag[x] = sqrtf((gx[x] * gx[x]) + (gy[x] * gy[x]));
+    }
+
+    // accumulate
+    for (int x = 0; x < width; ++x) {
+        int weight = mag[x] * 10.f;
+        sbins[(x / CELLDIM) * NBINS + orientation_bin(gx[x], gy[x])] += weight;
+    }
+
+}
+
+// the same on an 8-bit image: int16 gradients, then bin and weight in one
+// table lookup, no atan2 or sqrt
+static void bin_row(const unsigned char* img, int rows, int cols, int y, int c_start, int width,
+                    u8_rows& scratch, int* sbins) {
+
+    short* gx = &scratch.gx[0];
+    short* gy = &scratch.gy[0];
+    const unsigned char* lut = packed_bins();
+
+    const unsigned char* row  = img + y * cols;
+    const unsigned char* up   = img + (y > 0 ? y - 1 : y) * cols;
+    const unsigned char* down = img + (y < rows - 1 ? y + 1 : y) * cols;
+
+    for (int x = 0; x < width; ++x) {
+        int c = c_start + x;
+        gy[x] = (short)down[c] - (short)up[c];
+    }
+    for (int x = 1; x < width - 1; ++x) {
+        int c = c_start + x;
+        gx[x] = (short)row[c + 1] - (short)row[c - 1];
+    }
+    gx[0]         = xgrad(row, c_start, cols);
+    gx[width - 1] = xgrad(row, c_start + width - 1, cols);
+
+    for (int x = 0; x < width; ++x) {
+        int p = lut[(gx[x] + 255) * GRAD_LUT_DIM + (gy[x] + 255)];
+        sbins[(x / CELLDIM) * NBINS + (p & 7)] += p >> 3;
+    }
+
+}
+
+
+// the band loop of hog_cpu_window_hists, for either pixel type
+template <typename Pixel, typename Rows>
+static void window_hists(const Pixel* img, int rows, int cols,
+                         int r_start, int c_start, int w_rows, int w_cols,
+                         float* hists) {
+
+    int ncells_y = w_rows / CELLDIM;
+    int ncells_x = w_cols / CELLDIM;
+    int width    = ncells_x * CELLDIM;
+    if (ncells_x == 0 || ncells_y == 0) { return; }
+
+    #pragma omp parallel
+    {
+        // per thread scratch, one image row and one band of histograms
+        Rows scratch(width);
+        std::vector<int> sbins(ncells_x * NBINS);
+
+        #pragma omp for schedule(static)
+        for (int cy = 0; cy < ncells_y; ++cy) {
+
+            for (int b = 0; b < ncells_x * NBINS; ++b) { sbins[b] = 0; }
+
+            for (int r = 0; r < CELLDIM; ++r) {
+                int y = r_start + cy * CELLDIM + r;
+                bin_row(img, rows, cols, y, c_start, width, scratch, &sbins[0]);
+            }
+
+            // save histos
+            for (int cx = 0; cx < ncells_x; ++cx) {
+                const int* cbins = &sbins[cx * NBINS];
+                int cumsum = 0;
+                for (int hh = 0; hh < NBINS; ++hh) { cumsum += cbins[hh]; }
+                float denom = sqrtf((float)cumsum * cumsum + 0.01f);
+                float* out = hists + (cy * ncells_x + cx) * NBINS;
+                for (int hh = 0; hh < NBINS; ++hh) {
+                    out[hh] = (float)cbins[hh] / denom;  // l2 norm
+                }
+            }
+        }
+    }
+
+}
+
+
+void hog_cpu_window_hists(const float* img, int rows, int cols,
+                          int r_start, int c_start, int w_rows, int w_cols,
+                          float* hists) {
+    window_hists<float, float_rows>(img, rows, cols, r_start, c_start, w_rows, w_cols, hists);
+}
+
+
+void hog_cpu_window_hists_u8(const unsigned char* img, int rows, int cols,
+                             int r_start, int c_start, int w_rows, int w_cols,
+                             float* hists) {
+    packed_bins();  // build the table before the threads race to it
+    window_hists<unsigned char, u8_rows>(img, rows, cols, r_start, c_start, w_rows, w_cols, hists);
+}
+
+
+void hog_cpu_cell_grid(const float* img, int rows, int cols, float* grid) {
+    hog_cpu_window_hists(img, rows, cols, 0, 0, rows, cols, grid);
+}
+
+
+void hog_cpu_cell_grid_u8(const unsigned char* img, int rows, int cols, float* grid) {
+    hog_cpu_window_hists_u8(img, rows, cols, 0, 0, rows, cols, grid);
+}
+
+
+hog_window hog_grid_window(const float* grid, int cols,
+                           int r_start, int c_start, int w_rows, int w_cols) {
+    hog_window w;
+    w.stride   = (cols / CELLDIM) * NBINS;
+    w.cells    = grid + (r_start / CELLDIM) * w.stride + (c_start / CELLDIM) * NBINS;
+    w.ncells_y = w_rows / CELLDIM;
+    w.ncells_x = w_cols / CELLDIM;
+    return w;
+}
+
+
+void hog_window_copy(const hog_window& w, float* hists) {
+    int row_len = w.ncells_x * NBINS;
+    for (int cy = 0; cy < w.ncells_y; ++cy) {
+        memcpy(hists + cy * row_len, w.cells + cy * w.stride, sizeof(float) * row_len);
+    }
+}
+
+
+void hog_cpu_score_map(const float* grid, int grid_rows, int grid_cols,
+                       const float* w, int wcy, int wcx, float b, float* scores) {
+
+    int srows = grid_rows - wcy + 1;
+    int scols = grid_cols - wcx + 1;
+    if (srows < 1 || scols < 1) { return; }
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < srows; ++y) {
+        for (int x = 0; x < scols; ++x) {
+
+            // one partial sum per bin, so the cell loop vectorizes
+            float acc[NBINS];
+            for (int hh = 0; hh < NBINS; ++hh) { acc[hh] = 0; }
+
+            for (int cy = 0; cy < wcy; ++cy) {
+                const float* g  = grid + ((y + cy) * grid_cols + x) * NBINS;
+                const float* wr = w + cy * wcx * NBINS;
+                for (int c = 0; c < wcx * NBINS; c += NBINS) {
+                    for (int hh = 0; hh < NBINS; ++hh) { acc[hh] += g[c + hh] * wr[c + hh]; }
+                }
+            }
+
+            float dot = 0;
+            for (int hh = 0; hh < NBINS; ++hh) { dot += acc[hh]; }
+            scores[y * scols + x] = dot - b;
+        }
+    }
+
+}
+
+
+void hog_score_dets(const float* scores, int srows, int scols, int wcy, int wcx,
+                    float scale, float thresh, std::vector<hog_detection>& dets) {
+    for (int y = 0; y < srows; ++y) {
+        for (int x = 0; x < scols; ++x) {
+            float score = scores[y * scols + x];
+            if (score < thresh) { continue; }
+            hog_detection d;
+            d.row   = y * CELLDIM * scale;
+            d.col   = x * CELLDIM * scale;
+            d.rows  = wcy * CELLDIM * scale;
+            d.cols  = wcx * CELLDIM * scale;
+            d.score = score;
+            dets.push_back(d);
+        }
+    }
+}
+
+
+static bool higher_score(const hog_detection& a, const hog_detection& b) {
+    return a.score > b.score;
+}
+
+static float overlap_ratio(const hog_detection& a, const hog_detection& b) {
+    int r0 = std::max(a.row, b.row), r1 = std::min(a.row + a.rows, b.row + b.rows);
+    int c0 = std::max(a.col, b.col), c1 = std::min(a.col + a.cols, b.col + b.cols);
+    if (r1 <= r0 || c1 <= c0) { return 0; }
+    float inter = (float)(r1 - r0) * (c1 - c0);
+    return inter / ((float)a.rows * a.cols + (float)b.rows * b.cols - inter);
+}
+
+
+void hog_nms(std::vector<hog_detection>& dets, float overlap) {
+    std::sort(dets.begin(), dets.end(), higher_score);
+    std::vector<hog_detection> kept;
+    for (size_t d = 0; d < dets.size(); ++d) {
+        bool keep = true;
+        for (size_t k = 0; k < kept.size() && keep; ++k) {
+            keep = overlap_ratio(dets[d], kept[k]) <= overlap;
+        }
+        if (keep) { kept.push_back(dets[d]); }
+    }
+    dets.swap(kept);
+}
+
+
+// bilinear downscale of src into dst
+static void downscale(const float* src, int rows, int cols, float* dst, int drows, int dcols) {
+
+    float sy = (float)rows / drows, sx = (float)cols / dcols;
+
+    // column taps, shared by every row
+    std::vector<int> x0(dcols);
+    std::vector<float> fx(dcols);
+    for (int x = 0; x < dcols; ++x) {
+        float u = (x + 0.5f) * sx - 0.5f;
+        u = u < 0 ? 0 : u;
+        x0[x] = std::min((int)u, cols - 2 < 0 ? 0 : cols - 2);
+        fx[x] = std::min(u - x0[x], 1.f);
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < drows; ++y) {
+        float v = (y + 0.5f) * sy - 0.5f;
+        v = v < 0 ? 0 : v;
+        int y0 = std::min((int)v, rows - 2 < 0 ? 0 : rows - 2);
+        int y1 = std::min(y0 + 1, rows - 1);
+        float fy = std::min(v - y0, 1.f);
+        const float* r0 = src + y0 * cols;
+        const float* r1 = src + y1 * cols;
+        float* out = dst + y * dcols;
+        for (int x = 0; x < dcols; ++x) {
+            int xa = x0[x], xb = std::min(xa + 1, cols - 1);
+            float top = r0[xa] + fx[x] * (r0[xb] - r0[xa]);
+            float bot = r1[xa] + fx[x] * (r1[xb] - r1[xa]);
+            out[x] = top + fy * (bot - top);
+        }
+    }
+
+}
+
+
+void hog_pyramid(const float* img, int rows, int cols, float scale_step, int max_levels,
+                 int min_rows, int min_cols, std::vector<hog_level>& levels) {
+
+    // levels from an earlier frame keep their storage
+    int nlevels = 0;
+    float scale = 1;
+    for (int l = 0; l < max_levels; ++l, scale *= scale_step) {
+        int lrows = rows / scale, lcols = cols / scale;
+        if (lrows < min_rows || lcols < min_cols) { break; }
+
+        if ((int)levels.size() <= l) { levels.push_back(hog_level()); }
+        hog_level& level = levels[l];
+        level.rows  = lrows;
+        level.cols  = lcols;
+        level.scale = (float)rows / lrows;
+        level.img.resize(lrows * lcols);
+
+        // each level from the one before, which keeps the taps close
+        if (l == 0) {
+            memcpy(&level.img[0], img, sizeof(float) * lrows * lcols);
+        } else {
+            const hog_level& prev = levels[l - 1];
+            downscale(&prev.img[0], prev.rows, prev.cols, &level.img[0], lrows, lcols);
+        }
+        nlevels = l + 1;
+    }
+    levels.resize(nlevels);
+
+}
+
+
+// a slice of one level: cell rows (grid pass) or score rows (score pass)
+struct level_band {
+    int level, begin, end;
+};
+
+#define GRID_BAND   4  // cell rows per grid task
+#define SCORE_BAND  8  // score rows per score task
+
+
+void hog_cpu_detect_multiscale(const float* img, int rows, int cols,
+                               const float* w, int wcy, int wcx, float b, float thresh,
+                               float scale_step, int max_levels, float overlap,
+                               hog_multiscale& ms, std::vector<hog_detection>& dets) {
+
+    hog_pyramid(img, rows, cols, scale_step, max_levels, wcy * CELLDIM, wcx * CELLDIM, ms.levels);
+    int nlevels = ms.levels.size();
+    ms.grids.resize(nlevels);
+    ms.scores.resize(nlevels);
+
+    // the levels cut into bands, largest level first, so every level runs
+    // concurrently and the big ones are spread over all threads
+    std::vector<level_band> grid_bands, score_bands;
+    for (int l = 0; l < nlevels; ++l) {
+        const hog_level& level = ms.levels[l];
+        int grows = level.rows / CELLDIM, gcols = level.cols / CELLDIM;
+        int srows = grows - wcy + 1, scols = gcols - wcx + 1;
+        if (srows < 1 || scols < 1) { continue; }
+
+        ms.grids[l].resize(grows * gcols * NBINS);
+        ms.scores[l].resize(srows * scols);
+        for (int y = 0; y < grows; y += GRID_BAND) {
+            level_band band = { l, y, std::min(y + GRID_BAND, grows) };
+            grid_bands.push_back(band);
+        }
+        for (int y = 0; y < srows; y += SCORE_BAND) {
+            level_band band = { l, y, std::min(y + SCORE_BAND, srows) };
+            score_bands.push_back(band);
+        }
+    }
+
+    // cell grids; the parallel loops inside run on the calling thread
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int t = 0; t < (int)grid_bands.size(); ++t) {
+        const level_band& band = grid_bands[t];
+        const hog_level& level = ms.levels[band.level];
+        int gcols = level.cols / CELLDIM;
+        hog_cpu_window_hists(&level.img[0], level.rows, level.cols,
+                             band.begin * CELLDIM, 0, (band.end - band.begin) * CELLDIM, gcols * CELLDIM,
+                             &ms.grids[band.level][band.begin * gcols * NBINS]);
+    }
+
+    // score maps, each band from the grid rows its windows cover
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int t = 0; t < (int)score_bands.size(); ++t) {
+        const level_band& band = score_bands[t];
+        const hog_level& level = ms.levels[band.level];
+        int gcols = level.cols / CELLDIM, scols = gcols - wcx + 1;
+        hog_cpu_score_map(&ms.grids[band.level][band.begin * gcols * NBINS],
+                          band.end - band.begin + wcy - 1, gcols, w, wcy, wcx, b,
+                          &ms.scores[band.level][band.begin * scols]);
+    }
+
+    dets.clear();
+    for (int l = 0; l < nlevels; ++l) {
+        const hog_level& level = ms.levels[l];
+        int grows = level.rows / CELLDIM, gcols = level.cols / CELLDIM;
+        int srows = grows - wcy + 1, scols = gcols - wcx + 1;
+        if (srows < 1 || scols < 1) { continue; }
+        hog_score_dets(&ms.scores[l][0], srows, scols, wcy, wcx, level.scale, thresh, dets);
+    }
+    hog_nms(dets, overlap);
+
+}
@@ -0,0 +1,163 @@
+/*
+   Copyright [2011] [Chris McClanahan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+//
+// Offline HOG feature extraction for training
+//
+//   hog_extract bboxes.txt image_pattern out.feats [-svmlight out.txt] [-neg]
+//
+// bboxes.txt has a line of 8 numbers per image (the corners of a person's
+// box, the top left at 2,3), image i + 1 is sprintf(image_pattern, i + 1),
+// e.g. data/image_%04d.jpg.  The training sized window at the top left
+// corner of each box is a positive; with -neg the window at the same
+// height on the other side of the image is a negative.  Images are decoded
+// and their windows described in parallel, a batch at a time, and the rows
+// go out in image order through one buffered writer (see hog_io.h).
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include <omp.h>
+#include "hog_cpu.h"
+#include "hog_io.h"
+
+#include <cv.h>
+#include <highgui.h>
+
+using namespace cv;
+
+#define NBINS       8          // CHECK in main.cpp also
+#define CELLDIM    16
+#define TRAIN_WROWS 468
+#define TRAIN_WCOLS 352
+#define BATCH      256         // images decoded between writes
+#define HOG_U8      0          // 8-bit fast path features, CHECK in main.cpp also
+
+
+// top left corners of the boxes, one per image
+static bool read_bboxes(const char* path, std::vector<Point>& corners) {
+
+    FILE* fh = fopen(path, "r");
+    if (!fh) { return false; }
+    float v[8];
+    while (fscanf(fh, "%f %f %f %f %f %f %f %f",
+                  &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7]) == 8) {
+        corners.push_back(Point(v[2], v[3]));
+    }
+    fclose(fh);
+    return true;
+
+}
+
+
+// windows of one image: positive, then negative; returns how many were taken
+static int describe_image(const char* path, Point ul, bool negatives,
+                          float* feats, int* labels, int nfeats) {
+
+    Mat bgr = imread(path);
+    if (bgr.empty()) { return 0; }
+
+    // the frame as run_hog sees it
+    Mat gray8;
+    cvtColor(bgr, gray8, CV_BGR2GRAY);
+#if HOG_U8
+    const unsigned char* img = gray8.data;
+#else
+    Mat gray;
+    gray8.convertTo(gray, CV_32FC1, 1 / 255.0f);
+    const float* img = (const float*)gray.data;
+#endif
+    int rows = gray8.rows, cols = gray8.cols;
+    if (ul.x < 0 || ul.y < 0 || ul.x + TRAIN_WCOLS > cols || ul.y + TRAIN_WROWS > rows) { return 0; }
+
+    // the half the person is not in, for a negative
+    int c_start[2] = { ul.x, (ul.x + TRAIN_WCOLS / 2 > cols / 2) ? 0 : cols - TRAIN_WCOLS };
+    int n = negatives ? 2 : 1;
+    for (int k = 0; k < n; ++k) {
+#if HOG_U8
+        hog_cpu_window_hists_u8(img, rows, cols, ul.y, c_start[k], TRAIN_WROWS, TRAIN_WCOLS, feats + k * nfeats);
+#else
+        hog_cpu_window_hists(img, rows, cols, ul.y, c_start[k], TRAIN_WROWS, TRAIN_WCOLS, feats + k * nfeats);
+#endif
+        labels[k] = k == 0 ? 1 : -1;
+    }
+    return n;
+
+}
+
+
+int main(int argc, char** argv) {
+
+    if (argc < 4) {
+        fprintf(stderr, "usage: %s bboxes.txt image_pattern out.feats [-svmlight out.txt] [-neg]\n", argv[0]);
+        return 1;
+    }
+    const char* svmlight_path = NULL;
+    bool negatives = false;
+    for (int a = 4; a < argc; ++a) {
+        if (!strcmp(argv[a], "-svmlight") && a + 1 < argc) { svmlight_path = argv[++a]; }
+        else if (!strcmp(argv[a], "-neg")) { negatives = true; }
+    }
+
+    std::vector<Point> corners;
+    if (!read_bboxes(argv[1], corners)) { fprintf(stderr, "cannot read %s\n", argv[1]); return 1; }
+
+    int nfeats = (TRAIN_WROWS / CELLDIM) * (TRAIN_WCOLS / CELLDIM) * NBINS;
+    hog_feat_writer wr;
+    if (!hog_feats_open(wr, argv[3], svmlight_path, nfeats)) {
+        fprintf(stderr, "cannot create %s\n", argv[3]);
+        return 1;
+    }
+
+    // up to two windows per image of the batch
+    int per_image = negatives ? 2 : 1;
+    std::vector<float> feats((size_t)BATCH * per_image * nfeats);
+    std::vector<int> labels(BATCH * per_image), taken(BATCH);
+    int nimages = corners.size(), skipped = 0;
+    double t0 = omp_get_wtime();
+
+    for (int first = 0; first < nimages; first += BATCH) {
+        int count = std::min(BATCH, nimages - first);
+
+        // one image per thread; decoding dominates, so hand them out singly
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (int k = 0; k < count; ++k) {
+            char path[1024];
+            snprintf(path, sizeof(path), argv[2], first + k + 1);
+            taken[k] = describe_image(path, corners[first + k], negatives,
+                                      &feats[(size_t)k * per_image * nfeats],
+                                      &labels[k * per_image], nfeats);
+        }
+
+        // in image order
+        for (int k = 0; k < count; ++k) {
+            if (!taken[k]) { ++skipped; continue; }
+            hog_feats_write(wr, &labels[k * per_image], &feats[(size_t)k * per_image * nfeats], taken[k]);
+        }
+
+        int done = first + count;
+        printf("%d / %d images, %.1f images/s \n", done, nimages, done / (omp_get_wtime() - t0));
+    }
+
+    printf("%d windows of %d features, %d images skipped \n", wr.nsamples, nfeats, skipped);
+    hog_feats_close(wr);
+    return 0;
+
+}
@@ -0,0 +1,148 @@
+/*
+   Copyright [2011] [Chris McClanahan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+//
+// HOG feature and model files, see hog_io.h
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "hog_io.h"
+
+#define HOG_FEATS_VERSION  1
+#define HOG_WRITE_BUFFER   (1 << 22)      // bytes of stdio buffer per output
+
+
+bool hog_feats_open(hog_feat_writer& wr, const char* path, const char* svmlight_path, int nfeats) {
+
+    wr.nfeats = nfeats;
+    wr.nsamples = 0;
+    wr.svmlight = NULL;
+    wr.bin = fopen(path, "wb");
+    if (!wr.bin) { return false; }
+    setvbuf(wr.bin, NULL, _IOFBF, HOG_WRITE_BUFFER);
+    if (svmlight_path) {
+        wr.svmlight = fopen(svmlight_path, "w");
+        if (!wr.svmlight) { fclose(wr.bin); wr.bin = NULL; return false; }
+        setvbuf(wr.svmlight, NULL, _IOFBF, HOG_WRITE_BUFFER);
+    }
+
+    int header[4];
+    memcpy(header, "HOGF", 4);
+    header[1] = HOG_FEATS_VERSION;
+    header[2] = nfeats;
+    header[3] = 0;
+    fwrite(header, sizeof(header), 1, wr.bin);
+    return true;
+
+}
+
+
+void hog_feats_write(hog_feat_writer& wr, const int* labels, const float* feats, int rows) {
+
+    for (int r = 0; r < rows; ++r) {
+        const float* row = feats + (size_t)r * wr.nfeats;
+        fwrite(&labels[r], sizeof(int), 1, wr.bin);
+        fwrite(row, sizeof(float), wr.nfeats, wr.bin);
+
+        // sparse, 1 based, as svm_learn wants it
+        if (wr.svmlight) {
+            fprintf(wr.svmlight, "%d", labels[r]);
+            for (int f = 0; f < wr.nfeats; ++f) {
+                if (row[f] != 0) { fprintf(wr.svmlight, " %d:%g", f + 1, row[f]); }
+            }
+            fputc('\n', wr.svmlight);
+        }
+    }
+    wr.nsamples += rows;
+
+}
+
+
+void hog_feats_close(hog_feat_writer& wr) {
+
+    fseek(wr.bin, 3 * sizeof(int), SEEK_SET);
+    fwrite(&wr.nsamples, sizeof(int), 1, wr.bin);
+    fclose(wr.bin);
+    if (wr.svmlight) { fclose(wr.svmlight); }
+    wr.bin = wr.svmlight = NULL;
+
+}
+
+
+// whole file, '\0' terminated
+static bool read_file(const char* path, std::vector<char>& data) {
+
+    struct stat statbuf;
+    FILE* fh = fopen(path, "rb");
+    if (!fh) { return false; }
+    stat(path, &statbuf);
+    data.resize(statbuf.st_size + 1);
+    size_t got = fread(&data[0], 1, statbuf.st_size, fh);
+    fclose(fh);
+    data.resize(got + 1);
+    data[got] = '\0';
+    return true;
+
+}
+
+
+static const char* next_line(const char* p) {
+    while (*p && *p != '\n') { ++p; }
+    return *p ? p + 1 : p;
+}
+
+
+bool hog_load_svm(const char* path, std::vector<float>& w, float& b) {
+
+    std::vector<char> text;
+    if (!read_file(path, text)) { return false; }
+    const char* p = &text[0];
+    char* end;
+
+    // version string, kernel type and the five kernel parameters
+    for (int i = 0; i < 7; ++i) { p = next_line(p); }
+    int nfeats = strtol(p, NULL, 10);
+    p = next_line(p);
+    p = next_line(p);                               // training examples
+    int nsv = strtol(p, NULL, 10) - 1;              // stored "plus 1"
+    p = next_line(p);
+    b = strtod(p, NULL);
+    p = next_line(p);
+    if (nfeats <= 0) { return false; }
+
+    // each support vector line: alpha * y, then sparse idx:val pairs
+    std::vector<double> acc(nfeats, 0.0);
+    for (int sv = 0; sv < nsv && *p; ++sv) {
+        double alpha_y = strtod(p, &end);
+        p = end;
+        for (;;) {
+            while (*p == ' ' || *p == '\t') { ++p; }
+            long idx = strtol(p, &end, 10);
+            if (end == p || *end != ':') { break; }
+            double val = strtod(end + 1, &end);
+            p = end;
+            if (idx >= 1 && idx <= nfeats) { acc[idx - 1] += alpha_y * val; }
+        }
+        p = next_line(p);
+    }
+
+    w.assign(acc.begin(), acc.end());
+    return true;
+
+}
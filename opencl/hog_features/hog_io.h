@@ -0,0 +1,63 @@
+/*
+   Copyright [2011] [Chris McClanahan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+//
+// HOG feature and model files
+//
+// A feature file is a binary matrix, one row per training window:
+//
+//   char  magic[4]   "HOGF"
+//   int   version    1
+//   int   nfeats     floats per row
+//   int   nsamples   rows
+//   nsamples x { int label; float feats[nfeats]; }
+//
+// in host byte order.  Rows are appended through one buffered writer and
+// nsamples is filled in on close, so a crashed run leaves a file that
+// still holds every row up to its last whole one.
+//
+
+#ifndef HOG_IO_H_
+#define HOG_IO_H_
+
+#include <stdio.h>
+#include <vector>
+
+struct hog_feat_writer {
+    FILE* bin;        // feature matrix
+    FILE* svmlight;   // optional "label idx:val ..." text export, or NULL
+    int nfeats;
+    int nsamples;
+};
+
+// Opens a feature file, and an svm-light export unless svmlight_path is
+// NULL.  Returns false if either cannot be created.
+bool hog_feats_open(hog_feat_writer& wr, const char* path, const char* svmlight_path, int nfeats);
+
+// Appends rows samples of wr.nfeats features each.
+void hog_feats_write(hog_feat_writer& wr, const int* labels, const float* feats, int rows);
+
+// Writes the sample count and closes the files.
+void hog_feats_close(hog_feat_writer& wr);
+
+// Loads a linear svm-light model as one weight vector, w = sum of
+// alpha_i y_i x_i over the support vectors, and the threshold b, so that
+// score = w . x - b (see hog_cpu_score_map).  The file is read in one go
+// and parsed in place.  Returns false if it cannot be read.
+bool hog_load_svm(const char* path, std::vector<float>& w, float& b);
+
+#endif /*HOG_IO_H_*/
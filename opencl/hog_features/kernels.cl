@@ -21,6 +21,23 @@
 #define M_PI 3.14159265
 #endif
 
+// l2 normalize a cell's summed bins into the cell grid
+void save_histogram(int cols, __global float* bins, int row, int col,
+                    __local int* sbins, __local int* cumsum) {
+
+    // for l2 norm, every cell of the grid
+    for (int hh = 0; hh < NBINS; ++hh) { *cumsum += sbins[hh]; }
+
+    // save histo
+    int cell_id = (col / CELLDIM) + (row / CELLDIM) * (cols / CELLDIM);
+    float denom = sqrt((*cumsum) * (*cumsum) + 0.01f);
+    for (int hh = 0; hh < NBINS; ++hh) {
+        float normh = (float)sbins[hh] / denom;  // l2 norm
+        bins[cell_id * NBINS + hh] = normh;
+    }
+
+}
+
 //__kernel
 /* void histograms(__global float* ang_i, __global float* mag_i, int rows, int cols, __global float* bins) { */
 void histograms(__global float* ang_i, __global float* mag_i, int rows, int cols, __global float* bins,
@@ -51,21 +68,10 @@ void histograms(__global float* ang_i, __global float* mag_i, int rows, int cols
     }
     mem_fence(CLK_LOCAL_MEM_FENCE); // barrier?
 
-    if (row < NBINS) {
-#pragma OPENCL EXTENSION cl_khr_local_int32_base_atomics: enable
-        atom_add(cumsum, sbins[row]); // for l2 norm
-    }
-
     mem_fence(CLK_GLOBAL_MEM_FENCE); // barrier?
     if (i == 0) {
 #if 1
-        // save histo
-        int cell_id = (col / CELLDIM) + (row / CELLDIM) * (cols / CELLDIM);
-        float denom = sqrt((*cumsum) * (*cumsum) + 0.01f);
-        for (int hh = 0; hh < NBINS; ++hh) {
-            float normh = (float)sbins[hh] / denom;  // l2 norm
-            bins[cell_id * NBINS + hh] = normh;
-        }
+        save_histogram(cols, bins, row, col, sbins, cumsum);
 #endif
 #if 0
         // debug
@@ -111,6 +117,58 @@ void window_hist(__global float* ang_i, __global float* mag_i, int rows_i, int c
 }
 
 
+// as histograms, from grad_bins_u8's (weight << 3) | bin bytes.  Every work
+// item of the cell's group calls it, so all of them reach the barriers; only
+// the active ones (column 0 of the group, inside the window) sum a row
+void histograms_u8(__global const uchar* packed_i, int rows, int cols, __global float* bins,
+                   int row, int col, int i, int j, int cols_i, bool active,
+                   __local int* sbins, __local int* cumsum) {
+
+    if (i == 0 && j == 0) {
+        for (int hh = 0; hh < NBINS; ++hh) { sbins[hh] = 0; }
+        *cumsum = 0;
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    if (active) {
+        for (int jj = 0; jj < CELLDIM; ++jj) {
+            if ((col + jj) >= cols) { continue; }
+            int p = packed_i[(row) * cols_i + (col + jj)];
+#pragma OPENCL EXTENSION cl_khr_local_int32_base_atomics: enable
+            atom_add(&sbins[p & (NBINS - 1)], p >> 3);
+        }
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    // every row of the cell is in
+    if (active && i == 0) { save_histogram(cols, bins, row, col, sbins, cumsum); }
+
+}
+
+
+__kernel
+void window_hist_u8(__global const uchar* packed_i, int rows_i, int cols_i, __global float* bins,
+                    int r_start, int c_start, int w_rows, int w_cols) {
+
+    __global const uchar* packed_i_sub = packed_i + (r_start * cols_i + c_start);
+
+    int row = get_global_id(0);
+    int col = get_global_id(1);
+    int i = get_local_id(0);
+    int j = get_local_id(1);
+
+    // no early return: the whole group has to reach the barriers
+    bool active = row < w_rows && col < w_cols && i < CELLDIM && j == 0 &&
+                  r_start + row < rows_i && c_start + col < cols_i;
+
+    __local int sbins[NBINS];
+    __local int cumsum;
+
+    histograms_u8(packed_i_sub, w_rows, w_cols, bins, row, col, i, j, cols_i, active, sbins, &cumsum);
+
+}
+
+
 
 __kernel
 void classify(__global float* feats, __global float* w, __global int* res, int ncells) {
@@ -141,3 +199,37 @@ void classify(__global float* feats, __global float* w, __global int* res, int n
 }
 
 
+// svm response of every wcy x wcx cell window of the cell grid, one work
+// item per window: the weights are correlated with the grid, and windows
+// scoring at least thresh are appended to dets / det_scores
+__kernel
+void score_windows(__global float* grid, __global float* w, int grid_rows, int grid_cols,
+                   int wcy, int wcx, float b, float thresh,
+                   __global float* scores, __global int* dets, __global float* det_scores,
+                   __global int* ndets) {
+
+    int srows = grid_rows - wcy + 1;
+    int scols = grid_cols - wcx + 1;
+
+    int y = get_global_id(0);
+    int x = get_global_id(1);
+    if (y >= srows || x >= scols) { return; }
+
+    float dot = 0;
+    for (int cy = 0; cy < wcy; ++cy) {
+        __global float* g  = grid + ((y + cy) * grid_cols + x) * NBINS;
+        __global float* wr = w + cy * wcx * NBINS;
+        for (int k = 0; k < wcx * NBINS; ++k) { dot += g[k] * wr[k]; }
+    }
+
+    float score = dot - b;
+    scores[y * scols + x] = score;
+
+    if (score >= thresh) {
+#pragma OPENCL EXTENSION cl_khr_global_int32_base_atomics: enable
+        int d = atom_inc(ndets);
+        dets[d] = y * scols + x;
+        det_scores[d] = score;
+    }
+
+}
@@ -27,8 +27,12 @@
 #include <stdio.h>
 #include <math.h>
 #include <string.h>
+#include <map>
 #include "simpleCL.h"
 #include "timer.h"
+#include "hog_cpu.h"
+#include "hog_io.h"
+#include "sclKernel.h"
 
 #include <cv.h>
 #include <cxcore.h>
@@ -37,12 +41,30 @@
 using namespace std;
 using namespace cv;
 
-#define NBINS     8            // CHECK in kernels.cl also
+#define NBINS     8            // CHECK in kernels.cl and hog_cpu.cpp also
 #define CELLDIM  16
 #define BLOCK_SIZE_X CELLDIM   // lazy: make block sizes
 #define BLOCK_SIZE_Y CELLDIM   //       equal to celldim
 #define TIMING    0            // warmup, then average multiple runs
 #define DEMO_MODE 1
+#define SHOW_WINDOWS 0         // draw every window's hists, 5 ms per window (debug)
+#define CPU_HOG   0            // native cpu engine (hog_cpu.cpp) instead of the cl kernels
+#define TRAIN_WROWS 468        // from training:
+#define TRAIN_WCOLS 352        //  * avg bbox size xy 352.436 468.568
+#define SVM_THRESH  1.0f       // svm response of a detection
+#define MULTI_SCALE 0          // detect over an image pyramid
+#define SCALE_STEP  1.2f       //  * size ratio of pyramid levels
+#define MAX_LEVELS  10         //  * 1.2^9 covers 5x size variation
+#define NMS_OVERLAP 0.5f       //  * detections overlapping more are merged
+#define PIPELINE    0          // overlap capture, upload, compute and readback
+#define PIPELINE_DEPTH 3       //  * frames in flight
+#define PIPELINE_REPORT 30     //  * frames between stage timing reports
+#define HOG_U8      0          // int16 gradients and lut / octant bins from the 8-bit frame
+                               //  * CHECK in hog_extract.cpp also, so training sees the same features
+
+#if HOG_U8 && MULTI_SCALE
+#error "the pyramid is float only, so HOG_U8 models do not score on it"
+#endif
 
 
 // functions
@@ -51,7 +73,8 @@ void MatToFloat(const Mat& thing, float* thing2);
 void FloatToMat(float const* thing, Mat& thing2);
 void cell_hist_test(Mat& img);
 void display_cl_buffer(char* name, cl_mem d_img, int rows, int cols, bool convert);
-void run_hog(float* h_img, int rows, int cols, float* h_feats, int celldim);
+void run_hog(float* h_img, const unsigned char* h_img8, int rows, int cols, float* h_feats, int celldim);
+void run_hog_cpu(float* h_img, const unsigned char* h_img8, int rows, int cols, int celldim);
 void printFloatMat(const Mat& thing);
 
 // misc
@@ -62,36 +85,160 @@ size_t localWorkSize[] = {BLOCK_SIZE_Y, BLOCK_SIZE_X};
 cl_mem d_w;
 float h_b;
 float* h_w_vec;
+int h_w_nfeats;
+
+
+// kernels, built on first use
+static sclKernel<cl_mem, cl_mem, int, int> xfilter_k, yfilter_k;
+static sclKernel<cl_mem, cl_mem, cl_mem, cl_mem, int, int> cart2polar_k;
+static sclKernel<cl_mem, cl_mem, int, int, cl_mem, int, int, int, int> window_hist_k;
+static sclKernel<cl_mem, cl_mem, int, int> grad_bins_u8_k;
+static sclKernel<cl_mem, int, int, cl_mem, int, int, int, int> window_hist_u8_k;
+static sclKernel<cl_mem, cl_mem, int, int, int, int, float, float,
+                 cl_mem, cl_mem, cl_mem, cl_mem> score_windows_k;
+
+
+// device buffers of one frame size, allocated on first use and kept for
+// every later frame (and pyramid level) of that size; host transfers go
+// through the pinned, persistently mapped h_* staging.  The pipeline keeps
+// one set per frame in flight (slot).  Only the input buffers a caller asks
+// for are allocated: the float path's image, gradients, angles and
+// magnitudes (IN_FLOAT), or the HOG_U8 path's 8-bit image and packed bins
+// (IN_U8); the grid and score buffers are always there.
+enum { IN_FLOAT = 1, IN_U8 = 2 };
+struct hog_buffers {
+    cl_mem d_img, d_xfilt, d_yfilt, d_ang, d_mag, d_grid;
+    cl_mem d_img8, d_packed;
+    cl_mem d_scores, d_dets, d_det_scores, d_ndets;
+    cl_mem p_img, p_img8, p_grid, p_ndets, p_dets, p_det_scores;
+    float* h_img;
+    unsigned char* h_img8;
+    float* h_grid;
+    int* h_ndets;
+    int* h_dets;
+    float* h_det_scores;
+    int nscores;
+    int inputs;  // IN_* sets allocated
+};
+typedef std::pair<int, std::pair<int, int> > pool_key;
+static std::map<pool_key, hog_buffers> buffer_pool;
+
+// the input buffers of b in inputs that it does not have yet
+void pool_inputs(hog_buffers& b, int rows, int cols, int inputs) {
+
+    size_t mem_isize = sizeof(float) * rows * cols;
+    if ((inputs & IN_FLOAT) && !(b.inputs & IN_FLOAT)) {
+        b.d_img   = sclMalloc(hardware, CL_MEM_READ_WRITE,  mem_isize);
+        b.d_xfilt = sclMalloc(hardware, CL_MEM_READ_WRITE,  mem_isize);
+        b.d_yfilt = sclMalloc(hardware, CL_MEM_READ_WRITE,  mem_isize);
+        b.d_ang   = sclMalloc(hardware, CL_MEM_READ_WRITE,  mem_isize);
+        b.d_mag   = sclMalloc(hardware, CL_MEM_READ_WRITE,  mem_isize);
+        b.p_img   = sclMallocPinned(hardware, CL_MEM_READ_ONLY,  mem_isize, (void**)&b.h_img);
+    }
+    if ((inputs & IN_U8) && !(b.inputs & IN_U8)) {
+        b.d_img8   = sclMalloc(hardware, CL_MEM_READ_ONLY,  rows * cols);
+        b.d_packed = sclMalloc(hardware, CL_MEM_READ_WRITE, rows * cols);
+        b.p_img8   = sclMallocPinned(hardware, CL_MEM_READ_ONLY,  rows * cols, (void**)&b.h_img8);
+    }
+    b.inputs |= inputs;
+
+}
+
+// inputs: the IN_* sets the caller will upload to, allocated if missing
+hog_buffers& pool_buffers(int rows, int cols, int celldim, int slot = 0, int inputs = 0) {
 
+    pool_key key(slot, std::pair<int, int>(rows, cols));
+    std::map<pool_key, hog_buffers>::iterator it = buffer_pool.find(key);
+    if (it != buffer_pool.end()) {
+        pool_inputs(it->second, rows, cols, inputs);
+        return it->second;
+    }
+
+    size_t fargsize = sizeof(float);
+    size_t iargsize = sizeof(int);
+    int grows = rows / celldim, gcols = cols / celldim;
+    size_t mem_gsize = fargsize * grows * gcols * NBINS;
+    int srows = grows - TRAIN_WROWS / celldim + 1, scols = gcols - TRAIN_WCOLS / celldim + 1;
+
+    hog_buffers& b = buffer_pool[key];
+    b.inputs = 0;
+    pool_inputs(b, rows, cols, inputs);
+    b.d_grid  = sclMalloc(hardware, CL_MEM_READ_WRITE,  mem_gsize);
+    b.p_grid  = sclMallocPinned(hardware, CL_MEM_WRITE_ONLY, mem_gsize, (void**)&b.h_grid);
+
+    // score_windows outputs, when a training window fits
+    b.nscores = (srows > 0 && scols > 0) ? srows * scols : 0;
+    if (b.nscores > 0) {
+        b.d_scores     = sclMalloc(hardware, CL_MEM_WRITE_ONLY, fargsize * b.nscores);
+        b.d_dets       = sclMalloc(hardware, CL_MEM_WRITE_ONLY, iargsize * b.nscores);
+        b.d_det_scores = sclMalloc(hardware, CL_MEM_WRITE_ONLY, fargsize * b.nscores);
+        b.d_ndets      = sclMalloc(hardware, CL_MEM_READ_WRITE, iargsize);
+        b.p_ndets      = sclMallocPinned(hardware, CL_MEM_WRITE_ONLY, iargsize, (void**)&b.h_ndets);
+        b.p_dets       = sclMallocPinned(hardware, CL_MEM_WRITE_ONLY, iargsize * b.nscores, (void**)&b.h_dets);
+        b.p_det_scores = sclMallocPinned(hardware, CL_MEM_WRITE_ONLY, fargsize * b.nscores, (void**)&b.h_det_scores);
+    }
 
-// kernels
-#define NUM_KERNELS 6
-static sclSoft software[NUM_KERNELS];
-static bool comp_flag[NUM_KERNELS];
+    return b;
+
+}
+
+void release_buffer_pool() {
+
+    std::map<pool_key, hog_buffers>::iterator it;
+    for (it = buffer_pool.begin(); it != buffer_pool.end(); ++it) {
+        hog_buffers& b = it->second;
+        if (b.inputs & IN_FLOAT) {
+            sclReleaseMemObject(b.d_img);
+            sclReleaseMemObject(b.d_xfilt);
+            sclReleaseMemObject(b.d_yfilt);
+            sclReleaseMemObject(b.d_ang);
+            sclReleaseMemObject(b.d_mag);
+            sclReleasePinned(hardware, b.p_img, b.h_img);
+        }
+        if (b.inputs & IN_U8) {
+            sclReleaseMemObject(b.d_img8);
+            sclReleaseMemObject(b.d_packed);
+            sclReleasePinned(hardware, b.p_img8, b.h_img8);
+        }
+        sclReleaseMemObject(b.d_grid);
+        sclReleasePinned(hardware, b.p_grid, b.h_grid);
+        if (b.nscores > 0) {
+            sclReleaseMemObject(b.d_scores);
+            sclReleaseMemObject(b.d_dets);
+            sclReleaseMemObject(b.d_det_scores);
+            sclReleaseMemObject(b.d_ndets);
+            sclReleasePinned(hardware, b.p_ndets, b.h_ndets);
+            sclReleasePinned(hardware, b.p_dets, b.h_dets);
+            sclReleasePinned(hardware, b.p_det_scores, b.h_det_scores);
+        }
+    }
+    buffer_pool.clear();
+
+}
 
 
 // debug cl mem display
 void display_cl_buffer(char* name, cl_mem d_img, int rows, int cols, bool convert) {
 
-    size_t mem_size = sizeof(float) * rows * cols;
-    Mat disp = Mat::zeros(rows, cols, CV_32FC1);
-    float* h_img = (float*)malloc(mem_size);
-    sclRead(hardware, mem_size, d_img, h_img);
-    FloatToMat(h_img, disp);
-    if (convert) { disp.convertTo(disp, CV_8UC1); }
-    imshow(name, disp * 1.2); // scale hack for gradient image
-    free(h_img);
+    // read straight into a kept Mat, reallocated only when the size changes
+    static Mat disp;
+    disp.create(rows, cols, CV_32FC1);
+    sclRead(hardware, sizeof(float) * rows * cols, d_img, disp.data);
+    if (convert) {
+        Mat disp8;
+        disp.convertTo(disp8, CV_8UC1);
+        imshow(name, disp8 * 1.2);
+    } else {
+        imshow(name, disp * 1.2); // scale hack for gradient image
+    }
 
 }
 
 // ... so inefficient!
-void display_cl_bins(char* name, cl_mem d_img, int ncells, int nbins, int irows, int icols) {
+void display_bins(char* name, const float* h_bins, int ncells, int nbins, int irows, int icols) {
 
     Mat hbins = Mat::zeros(ncells, nbins, CV_32FC1);
-    size_t mem_size = sizeof(float) * ncells * nbins;
-    float* h_img = (float*)malloc(mem_size);
-    sclRead(hardware, mem_size, d_img, h_img);
-    FloatToMat(h_img, hbins);
+    FloatToMat(h_bins, hbins);
 
     // reshape to ncells_y by ncells_x*nbins rectangle
     hbins = hbins.reshape(0, irows / CELLDIM);
@@ -143,208 +290,252 @@ void display_cl_bins(char* name, cl_mem d_img, int ncells, int nbins, int irows,
     resize(large, larger, Size(), 1.6, 1.6);
     imshow(name, larger);
 
-    free(h_img);
-
 }
 
 
-void check_feats(cl_mem d_hists, int ncells, int nbins, int wi, int wj, cl_mem d_img) {
+// print the detections, in frame pixels
+void report_dets(const std::vector<hog_detection>& dets) {
 
-    //return;
+    for (size_t d = 0; d < dets.size(); ++d) {
+        printf("response %f at %d %d (%d x %d) \n", dets[d].score,
+               dets[d].row, dets[d].col, dets[d].rows, dets[d].cols);
+    }
 
-    // if (!comp_flag[4]) {
-    //     comp_flag[4] = true;
-    //     software[4] = sclGetCLSoftware("kernels.cl", "classify", hardware);
-    // }
+    if (!dets.empty()) { waitKey(0); }
 
-    // size_t fargsize = sizeof(float);
-    // size_t iargsize = sizeof(int);
-    // size_t globalWorkSize[] = {
-    //     ((ncells - 1) / localWorkSize[0] + 1)* localWorkSize[0],
-    //     ((nbins  - 1) / localWorkSize[1] + 1)* localWorkSize[1]
-    // };
+}
 
 
-    // cl_mem d_response = sclMalloc(hardware, CL_MEM_READ_WRITE,  iargsize * 1);
-    // int h_response = 0;
+// svm response of every training sized window of the cell grid in b, as
+// one correlation of the weights with the grid (see score_windows in
+// kernels.cl), enqueued on hw; false when no training window fits
+bool enqueue_score_windows(sclHard hw, hog_buffers& b, int irows, int icols, int celldim,
+                           cl_event* done) {
 
-    // sclSetKernelArgs(software[4], " %v %v %v %a ",
-    //                  &d_hists, &d_w,
-    //                  &d_response,
-    //                  iargsize, &ncells
-    //                 );
-    // sclLaunchKernel(hardware, software[4], globalWorkSize, localWorkSize);
+    int grows = irows / celldim, gcols = icols / celldim;
+    int wcy = TRAIN_WROWS / celldim, wcx = TRAIN_WCOLS / celldim;
+    int srows = grows - wcy + 1, scols = gcols - wcx + 1;
+    if (h_w_nfeats != wcy * wcx * NBINS || srows < 1 || scols < 1) { return false; }
 
-    // sclRead(hardware, iargsize * 1, d_response, &h_response);
-    // printf("response %d  class %f \n", h_response, h_response-h_b);
+    if (!score_windows_k.built()) {
+        score_windows_k.build(hardware, "kernels.cl", "score_windows");
+        d_w = sclMalloc(hardware, CL_MEM_READ_ONLY, sizeof(float) * h_w_nfeats);
+        sclWrite(hardware, sizeof(float) * h_w_nfeats, d_w, h_w_vec);
+    }
 
-    // if(h_response != 0) waitKey(0);
+    size_t iargsize = sizeof(int);
+    size_t globalWorkSize[] = {
+        ((srows - 1) / localWorkSize[0] + 1)* localWorkSize[0],
+        ((scols - 1) / localWorkSize[1] + 1)* localWorkSize[1]
+    };
 
+    // dense score map, plus the windows above threshold
+    static int zero = 0;
+    float thresh = SVM_THRESH;
+    clReleaseEvent(sclWriteAsync(hw, iargsize, b.d_ndets, &zero));
 
-    // sclReleaseMemObject(d_response);
+    score_windows_k.bind(b.d_grid, d_w, grows, gcols, wcy, wcx, h_b, thresh,
+                         b.d_scores, b.d_dets, b.d_det_scores, b.d_ndets);
+    score_windows_k.enqueue(hw, globalWorkSize, localWorkSize, done);
+    return true;
 
-    size_t mem_hsize = sizeof(float) * ncells * NBINS;
-    float* h_feats = (float*)malloc(mem_hsize);
-    sclRead(hardware, mem_hsize, d_hists, h_feats);
+}
 
-    float dot  = 0;
-    for (int i = 0; i < ncells * nbins; ++i) {
-        dot += h_feats[i] * h_w_vec[i];
+// the first ndets detections read back into b, in frame pixels
+void collect_dets(const hog_buffers& b, int ndets, int icols, int celldim, float scale,
+                  std::vector<hog_detection>& dets) {
+
+    int wcy = TRAIN_WROWS / celldim, wcx = TRAIN_WCOLS / celldim;
+    int scols = icols / celldim - wcx + 1;
+    for (int d = 0; d < ndets; ++d) {
+        hog_detection det;
+        det.row   = (b.h_dets[d] / scols) * celldim * scale;
+        det.col   = (b.h_dets[d] % scols) * celldim * scale;
+        det.rows  = wcy * celldim * scale;
+        det.cols  = wcx * celldim * scale;
+        det.score = b.h_det_scores[d];
+        dets.push_back(det);
     }
 
-    float res = dot - h_b;
-    printf("response %f \n", res);
-
-
-    if (abs(res) >= 1) { waitKey(0); }
-
 }
 
+// score the cell grid of a frame, or of a pyramid level scale times smaller
+void score_windows(int irows, int icols, int celldim, float scale,
+                   std::vector<hog_detection>& dets) {
 
-void save_feats(cl_mem d_hists, int ncells, int nbins, int positive) {
+    hog_buffers& b = pool_buffers(irows, icols, celldim);
+    cl_event done;
+    if (!enqueue_score_windows(hardware, b, irows, icols, celldim, &done)) { return; }
+    clReleaseEvent(done);
 
-    ofstream myfile;
-    myfile.open("feats.txt", ios::app);
-    int nfeats = 1;
+    // only the detections come back
+    size_t iargsize = sizeof(int);
+    sclRead(hardware, iargsize, b.d_ndets, b.h_ndets);
+    int ndets = *b.h_ndets;
+    if (ndets > 0) {
+        sclRead(hardware, iargsize * ndets, b.d_dets, b.h_dets);
+        sclRead(hardware, sizeof(float) * ndets, b.d_det_scores, b.h_det_scores);
+        collect_dets(b, ndets, icols, celldim, scale, dets);
+    }
 
-    size_t mem_hsize = sizeof(float) * ncells * NBINS;
-    float* h_feats = (float*)malloc(mem_hsize);
-    Mat hists  = Mat::zeros(ncells, NBINS, CV_32FC1);
+}
 
-    printf("%d ", positive);
-    myfile << positive << " ";
 
-    sclRead(hardware, mem_hsize, d_hists, h_feats);
-    FloatToMat(h_feats, hists);
-    for (int i = 0; i < hists.rows; ++i) {
-        for (int j = 0; j < NBINS; ++j) {
-            printf("%d:%d ", nfeats, (int)hists.at<float>(i, j));
-            myfile << nfeats << ":" << (int)hists.at<float>(i, j) << " ";
-            ++nfeats;
-        }
-        // printf("\n");
-        // myfile << "\n";
-    }
+// cpu version of score_windows, see hog_cpu.cpp
+void score_windows_cpu(const float* h_grid, int irows, int icols, int celldim,
+                       float scale, std::vector<hog_detection>& dets) {
+
+    int grows = irows / celldim, gcols = icols / celldim;
+    int wcy = TRAIN_WROWS / celldim, wcx = TRAIN_WCOLS / celldim;
+    int srows = grows - wcy + 1, scols = gcols - wcx + 1;
+    if (h_w_nfeats != wcy * wcx * NBINS || srows < 1 || scols < 1) { return; }
 
-    printf("\n");
-    myfile << "\n";
-    free(h_feats);
-    myfile.close();
+    static std::vector<float> scores;  // kept across frames
+    scores.resize(srows * scols);
+    hog_cpu_score_map(h_grid, grows, gcols, h_w_vec, wcy, wcx, h_b, &scores[0]);
+    hog_score_dets(&scores[0], srows, scols, wcy, wcx, scale, SVM_THRESH, dets);
 
 }
 
 
-void window_hists(cl_mem d_ang, cl_mem d_mag, cl_mem d_hists, int irows, int icols,
-                  int celldim, int wrows, int wcols, cl_mem d_img) {
+// training windows of a non demo run, one writer for the whole run
+static hog_feat_writer feats_out;
 
-    if (!comp_flag[0]) {
-        comp_flag[0] = true;
-        software[0] = sclGetCLSoftware("kernels.cl", "window_hist", hardware);
-    }
 
-    size_t iargsize = sizeof(int);
-    size_t globalWorkSize[] = {
-        ((wrows - 1) / localWorkSize[0] + 1)* localWorkSize[0],
-        ((wcols - 1) / localWorkSize[1] + 1)* localWorkSize[1]
-    };
+// slide windows over a frame's cell grid (see hog_cpu.h)
+void window_hists(const float* h_grid, int irows, int icols, int celldim) {
+
+    // windowed hists
+#if DEMO_MODE
+    // entire image
+    int wrows = irows;
+    int wcols = icols;
+#else
+    // sliding windows
+    int wrows = TRAIN_WROWS;
+    int wcols = TRAIN_WCOLS;
+#endif
+    int ncells = (wrows / celldim) * (wcols / celldim);
+    static std::vector<float> hists;  // kept across frames
+    hists.resize(ncells * NBINS);
+    float* h_hists = &hists[0];
 
+    // windows step by whole cells, so each one is a sub-grid
     int step = 16;
     for (int i = 0; i < irows - step; i += step) {
         for (int j = 0; j < icols - step; j += step) {
 
             if (i + wrows > irows || j + wcols > icols) { continue; }
-            sclSetKernelArgs(software[0], " %v %v %a %a %v %a %a %a %a ",
-                             &d_ang, &d_mag,
-                             iargsize, &irows, iargsize, &icols,
-                             &d_hists,
-                             iargsize, &i, iargsize, &j,
-                             iargsize, &wrows, iargsize, &wcols
-                            );
-            sclLaunchKernel(hardware, software[0], globalWorkSize, localWorkSize);
+            hog_window w = hog_grid_window(h_grid, icols, i, j, wrows, wcols);
+            hog_window_copy(w, h_hists);
 
             // debug
-            int ncells = (wcols / celldim) * (wrows / celldim);
-#if 1
+#if SHOW_WINDOWS
             //printf("%d %d \n",i,j);
-            // display_cl_buffer("ang", d_ang, irows, icols, false);
-            display_cl_bins("grid-hists", d_hists, ncells, NBINS, wrows, wcols);
+            display_bins("grid-hists", h_hists, ncells, NBINS, wrows, wcols);
             waitKey(5);
 #endif
 
             int positive_ex = 1;
             // classify
-#if DEMO_MODE
-            //          check_feats(d_hists, ncells, NBINS, i, j, d_img);
-#else
-            save_feats(d_hists, ncells, NBINS, positive_ex);
+#if !DEMO_MODE
+            if (feats_out.bin) { hog_feats_write(feats_out, &positive_ex, h_hists, 1); }
 #endif
         }
     }
 
+}
+
+
+// cell histograms of the whole frame, one launch on hw
+cl_event cell_grid(sclHard hw, cl_mem d_ang, cl_mem d_mag, cl_mem d_grid, int irows, int icols, int celldim) {
+
+    if (!window_hist_k.built()) { window_hist_k.build(hardware, "kernels.cl", "window_hist"); }
+
+    // only whole cells, as the windows see them
+    int wrows = (irows / celldim) * celldim;
+    int wcols = (icols / celldim) * celldim;
+    int r_start = 0, c_start = 0;
+
+    size_t globalWorkSize[] = {
+        ((wrows - 1) / localWorkSize[0] + 1)* localWorkSize[0],
+        ((wcols - 1) / localWorkSize[1] + 1)* localWorkSize[1]
+    };
+
+    cl_event done;
+    window_hist_k.bind(d_ang, d_mag, irows, icols, d_grid, r_start, c_start, wrows, wcols);
+    window_hist_k.enqueue(hw, globalWorkSize, localWorkSize, &done);
+    return done;
 
 }
 
 
-void run_hog(float* h_img, int rows, int cols, float* h_feats, int celldim) {
+// cpu version of run_hog, see hog_cpu.cpp
+void run_hog_cpu(float* h_img, const unsigned char* h_img8, int rows, int cols, int celldim) {
+
+    int ngrid = (rows / celldim) * (cols / celldim);
+    static std::vector<float> grid;  // kept across frames
+    grid.resize(ngrid * NBINS);
+    float* h_grid = &grid[0];
+
+#if HOG_U8
+    hog_cpu_cell_grid_u8(h_img8, rows, cols, h_grid);
+#else
+    hog_cpu_cell_grid(h_img, rows, cols, h_grid);
+#endif
+    window_hists(h_grid, rows, cols, celldim);
+#if DEMO_MODE
+    static std::vector<hog_detection> dets;
+    dets.clear();
+    score_windows_cpu(h_grid, rows, cols, celldim, 1.f, dets);
+    report_dets(dets);
+#endif
+
+}
+
+
+// detection over an image pyramid, the levels in parallel (see hog_cpu.cpp);
+// the pyramid, grids and score maps are kept across frames
+void run_hog_multiscale_cpu(float* h_img, int rows, int cols, int celldim) {
+
+    int wcy = TRAIN_WROWS / celldim, wcx = TRAIN_WCOLS / celldim;
+    if (h_w_nfeats != wcy * wcx * NBINS) { return; }
+
+    static hog_multiscale ms;
+    static std::vector<hog_detection> dets;
+    hog_cpu_detect_multiscale(h_img, rows, cols, h_w_vec, wcy, wcx, h_b, SVM_THRESH,
+                              SCALE_STEP, MAX_LEVELS, NMS_OVERLAP, ms, dets);
+    report_dets(dets);
+
+}
+
+
+// gradients, angles and cell grid of the image in b, enqueued on hw;
+// returns the events of the first and the last kernel
+cl_event enqueue_grid(sclHard hw, hog_buffers& b, int rows, int cols, int celldim, cl_event* first) {
 
     // sizes
-    size_t fargsize = sizeof(float);
-    size_t iargsize = sizeof(int);
-    size_t mem_isize = fargsize * rows * cols;
     size_t globalWorkSize[] = {
         ((rows - 1) / localWorkSize[0] + 1)* localWorkSize[0],
         ((cols - 1) / localWorkSize[1] + 1)* localWorkSize[1]
     };
-
-    // mem
-    cl_mem d_img   = sclMalloc(hardware, CL_MEM_READ_WRITE,  mem_isize);
-    cl_mem d_xfilt = sclMalloc(hardware, CL_MEM_READ_WRITE,  mem_isize);
-    cl_mem d_yfilt = sclMalloc(hardware, CL_MEM_READ_WRITE,  mem_isize);
-    cl_mem d_ang   = sclMalloc(hardware, CL_MEM_READ_WRITE,  mem_isize);
-    cl_mem d_mag   = sclMalloc(hardware, CL_MEM_READ_WRITE,  mem_isize);
-    sclWrite(hardware, mem_isize, d_img, h_img);
+    cl_mem d_img = b.d_img, d_xfilt = b.d_xfilt, d_yfilt = b.d_yfilt;
+    cl_mem d_ang = b.d_ang, d_mag = b.d_mag, d_grid = b.d_grid;
 
     // x gradients
-    if (!comp_flag[1]) {
-        comp_flag[1] = true;
-        software[1] = sclGetCLSoftware("1d-gradient-filters.cl", "xfilter", hardware);
-    }
-    sclSetKernelArgs(software[1],
-                     " %v %v %a %a",
-                     &d_img, &d_xfilt,
-                     iargsize, &rows,
-                     iargsize, &cols);
-    sclLaunchKernel(hardware, software[1], globalWorkSize, localWorkSize);
+    if (!xfilter_k.built()) { xfilter_k.build(hardware, "1d-gradient-filters.cl", "xfilter"); }
+    xfilter_k.bind(d_img, d_xfilt, rows, cols);
+    xfilter_k.enqueue(hw, globalWorkSize, localWorkSize, first);
 
     // y gradients
-    if (!comp_flag[2]) {
-        comp_flag[2] = true;
-        software[2] = sclGetCLSoftware("1d-gradient-filters.cl", "yfilter", hardware);
-    }
-    sclSetKernelArgs(software[2],
-                     " %v %v %a %a",
-                     &d_img, &d_yfilt,
-                     iargsize, &rows,
-                     iargsize, &cols);
-    sclLaunchKernel(hardware, software[2], globalWorkSize, localWorkSize);
+    if (!yfilter_k.built()) { yfilter_k.build(hardware, "1d-gradient-filters.cl", "yfilter"); }
+    yfilter_k.bind(d_img, d_yfilt, rows, cols);
+    yfilter_k.enqueue(hw, globalWorkSize, localWorkSize);
 
     // angles
-    if (!comp_flag[3]) {
-        comp_flag[3] = true;
-        software[3] = sclGetCLSoftware("cart-to-polar.cl", "cart2polar", hardware);
-    }
-    sclSetKernelArgs(software[3],
-                     " %v %v %v %v %a %a",
-                     &d_xfilt, &d_yfilt,
-                     &d_ang, &d_mag,
-                     iargsize, &rows,
-                     iargsize, &cols);
-    sclLaunchKernel(hardware, software[3], globalWorkSize, localWorkSize);
-
-    // debug
-    // display_cl_buffer("ang", d_ang, rows, cols, false);
-    display_cl_buffer("mag", d_mag, rows, cols, false);
-
+    if (!cart2polar_k.built()) { cart2polar_k.build(hardware, "cart-to-polar.cl", "cart2polar"); }
+    cart2polar_k.bind(d_xfilt, d_yfilt, d_ang, d_mag, rows, cols);
+    cart2polar_k.enqueue(hw, globalWorkSize, localWorkSize);
 
     // // histograms (OLD)
     // if (!comp_flag[0]) {
@@ -357,43 +548,192 @@ void run_hog(float* h_img, int rows, int cols, float* h_feats, int celldim) {
     //                  &d_hists);
     // sclLaunchKernel(hardware, software[0], globalWorkSize, localWorkSize);
 
+    // cell grid, once per frame
+    return cell_grid(hw, d_ang, d_mag, d_grid, rows, cols, celldim);
+}
+
+
+// as enqueue_grid, for the 8-bit image in b: packed bins and weights in
+// one pass (no float gradients, angles or magnitudes), then the cell grid
+cl_event enqueue_grid_u8(sclHard hw, hog_buffers& b, int rows, int cols, int celldim, cl_event* first) {
+
+    size_t globalWorkSize[] = {
+        ((rows - 1) / localWorkSize[0] + 1)* localWorkSize[0],
+        ((cols - 1) / localWorkSize[1] + 1)* localWorkSize[1]
+    };
+
+    // bins
+    if (!grad_bins_u8_k.built()) { grad_bins_u8_k.build(hardware, "cart-to-polar.cl", "grad_bins_u8"); }
+    grad_bins_u8_k.bind(b.d_img8, b.d_packed, rows, cols);
+    grad_bins_u8_k.enqueue(hw, globalWorkSize, localWorkSize, first);
+
+    // cell grid, only whole cells
+    if (!window_hist_u8_k.built()) { window_hist_u8_k.build(hardware, "kernels.cl", "window_hist_u8"); }
+    int wrows = (rows / celldim) * celldim;
+    int wcols = (cols / celldim) * celldim;
+    size_t gridWorkSize[] = {
+        ((wrows - 1) / localWorkSize[0] + 1)* localWorkSize[0],
+        ((wcols - 1) / localWorkSize[1] + 1)* localWorkSize[1]
+    };
+    cl_event done;
+    window_hist_u8_k.bind(b.d_packed, rows, cols, b.d_grid, 0, 0, wrows, wcols);
+    window_hist_u8_k.enqueue(hw, gridWorkSize, localWorkSize, &done);
+    return done;
+}
+
+
+// gradients, angles and cell grid of an image on the device; the returned
+// grid belongs to the buffer pool
+cl_mem hog_grid_cl(float* h_img, int rows, int cols, int celldim, bool show) {
+
+    // mem, from the pool; the frame goes up through pinned staging
+    size_t mem_isize = sizeof(float) * rows * cols;
+    hog_buffers& b = pool_buffers(rows, cols, celldim, 0, IN_FLOAT);
+    memcpy(b.h_img, h_img, mem_isize);
+    sclWrite(hardware, mem_isize, b.d_img, b.h_img);
+
+    cl_event first;
+    cl_event last = enqueue_grid(hardware, b, rows, cols, celldim, &first);
+    sclFinish(hardware);
+    clReleaseEvent(first);
+    clReleaseEvent(last);
+
+    // debug
+    // display_cl_buffer("ang", b.d_ang, rows, cols, false);
+    if (show) { display_cl_buffer("mag", b.d_mag, rows, cols, false); }
+
+    return b.d_grid;
+}
+
+
+// as hog_grid_cl, from the 8-bit frame, a quarter of the upload
+cl_mem hog_grid_cl_u8(const unsigned char* h_img8, int rows, int cols, int celldim) {
+
+    hog_buffers& b = pool_buffers(rows, cols, celldim, 0, IN_U8);
+    memcpy(b.h_img8, h_img8, rows * cols);
+    sclWrite(hardware, rows * cols, b.d_img8, b.h_img8);
+
+    cl_event first;
+    cl_event last = enqueue_grid_u8(hardware, b, rows, cols, celldim, &first);
+    sclFinish(hardware);
+    clReleaseEvent(first);
+    clReleaseEvent(last);
+
+    return b.d_grid;
+}
+
+
+// detection over an image pyramid, each level on its own command queue:
+// every level is uploaded, gridded, scored and read back without waiting
+// for the others, and the host waits once, for all of them
+static std::vector<sclHard> level_queues;
+
+void run_hog_multiscale(float* h_img, int rows, int cols, int celldim) {
+
+#if CPU_HOG
+    run_hog_multiscale_cpu(h_img, rows, cols, celldim);
+    return;
+#endif
+
+    int wcy = TRAIN_WROWS / celldim, wcx = TRAIN_WCOLS / celldim;
+    if (h_w_nfeats != wcy * wcx * NBINS) { return; }
+
+    static std::vector<hog_level> levels;
+    hog_pyramid(h_img, rows, cols, SCALE_STEP, MAX_LEVELS, TRAIN_WROWS, TRAIN_WCOLS, levels);
+    int nlevels = levels.size();
+    while ((int)level_queues.size() < nlevels) { level_queues.push_back(sclGetHardwareQueue(hardware)); }
+
+    static std::vector<char> scored;
+    scored.resize(nlevels);
+    for (int l = 0; l < nlevels; ++l) {
+        const hog_level& level = levels[l];
+        sclHard q = level_queues[l];
+        hog_buffers& b = pool_buffers(level.rows, level.cols, celldim, 0, IN_FLOAT);
+
+        // upload, through pinned staging
+        size_t mem_isize = sizeof(float) * level.rows * level.cols;
+        memcpy(b.h_img, &level.img[0], mem_isize);
+        clReleaseEvent(sclWriteAsync(q, mem_isize, b.d_img, b.h_img));
+
+        // cell grid and scores, in order on the level's queue
+        cl_event first, done;
+        cl_event last = enqueue_grid(q, b, level.rows, level.cols, celldim, &first);
+        clReleaseEvent(first);
+        clReleaseEvent(last);
+        scored[l] = enqueue_score_windows(q, b, level.rows, level.cols, celldim, &done);
+
+        // readback of the detections
+        if (scored[l]) {
+            clReleaseEvent(done);
+            clReleaseEvent(sclReadAsync(q, sizeof(int), b.d_ndets, b.h_ndets));
+            clReleaseEvent(sclReadAsync(q, sizeof(int) * b.nscores, b.d_dets, b.h_dets));
+            clReleaseEvent(sclReadAsync(q, sizeof(float) * b.nscores, b.d_det_scores, b.h_det_scores));
+        }
+        sclFlush(q);
+    }
+
+    static std::vector<hog_detection> dets;
+    dets.clear();
+    for (int l = 0; l < nlevels; ++l) {
+        sclFinish(level_queues[l]);
+        if (!scored[l]) { continue; }
+        const hog_level& level = levels[l];
+        hog_buffers& b = pool_buffers(level.rows, level.cols, celldim);
+        collect_dets(b, *b.h_ndets, level.cols, celldim, level.scale, dets);
+    }
+
+    hog_nms(dets, NMS_OVERLAP);
+    report_dets(dets);
+
+}
+
+
+// h_img8 is the same frame in 8 bits, for HOG_U8 (single scale only)
+void run_hog(float* h_img, const unsigned char* h_img8, int rows, int cols, float* h_feats, int celldim) {
+
+#if MULTI_SCALE
+    run_hog_multiscale(h_img, rows, cols, celldim);
+    return;
+#endif
+
+#if CPU_HOG
+    run_hog_cpu(h_img, h_img8, rows, cols, celldim);
+    return;
+#endif
+
+    // cell grid, once per frame
+#if HOG_U8
+    cl_mem d_grid = hog_grid_cl_u8(h_img8, rows, cols, celldim);
+#else
+    cl_mem d_grid = hog_grid_cl(h_img, rows, cols, celldim, true);
+#endif
+    size_t mem_gsize = sizeof(float) * (rows / celldim) * (cols / celldim) * NBINS;
+    float* h_grid = pool_buffers(rows, cols, celldim).h_grid;
+    sclRead(hardware, mem_gsize, d_grid, h_grid);
+
     // windowed hists
+    window_hists(h_grid, rows, cols, celldim);
 #if DEMO_MODE
-    // entire image
-    int w_rows = rows;
-    int w_cols = cols;
-#else
-    // sliding windows
-    int w_rows = 468; // from training:
-    int w_cols = 352; //  * avg bbox size xy 352.436 468.568
+    static std::vector<hog_detection> dets;
+    dets.clear();
+    score_windows(rows, cols, celldim, 1.f, dets);
+    report_dets(dets);
 #endif
-    int ncells = (w_rows / celldim) * (w_cols / celldim);
-    size_t mem_hsize = fargsize * ncells * NBINS;
-    cl_mem d_hists = sclMalloc(hardware, CL_MEM_READ_WRITE,  mem_hsize);
-    window_hists(d_ang, d_mag, d_hists, rows, cols, celldim, w_rows, w_cols, d_img);
 
     // // mem output
     // sclRead(hardware, mem_hsize, d_hists, h_feats);
 
-    // cleanup
-    sclReleaseMemObject(d_hists);
-    sclReleaseMemObject(d_xfilt);
-    sclReleaseMemObject(d_yfilt);
-    sclReleaseMemObject(d_img);
-    sclReleaseMemObject(d_ang);
-    sclReleaseMemObject(d_mag);
-
 }
 
 
 void cell_hist_test(Mat& m_I, Mat& m_F) {
 
-    // extract cv image
-    Mat mgray1(m_I.rows, m_I.cols, CV_8UC1);
-    cvtColor(m_I, mgray1, CV_BGR2GRAY);
-    mgray1.convertTo(mgray1, CV_32FC1);
-    mgray1 /= 255.0f;
+    // extract cv image, into Mats kept across frames of the same size
+    static Mat mgray8, mgray1;
+    cvtColor(m_I, mgray8, CV_BGR2GRAY);
+    mgray8.convertTo(mgray1, CV_32FC1, 1 / 255.0f);
     float* h_i = (float*)mgray1.data;
+    const unsigned char* h_i8 = mgray8.data;
 
     // setup
     unsigned int cols = m_I.cols, rows = m_I.rows;
@@ -403,19 +743,19 @@ void cell_hist_test(Mat& m_I, Mat& m_F) {
     // runs
     int nruns = 4;
     // warmup
-    run_hog(h_i, rows, cols, h_feats, CELLDIM);
+    run_hog(h_i, h_i8, rows, cols, h_feats, CELLDIM);
     // timing
     start_timer(0);
     for (int i = 0; i < nruns; ++i) {
         // go
-        run_hog(h_i, rows, cols, h_feats, CELLDIM);
+        run_hog(h_i, h_i8, rows, cols, h_feats, CELLDIM);
     }
     printf("fps: %f \n", 1.0f / (elapsed_time(0) / 1000.0f / (float)nruns));
 #else
     // timing
     start_timer(0);
     // go
-    run_hog(h_i, rows, cols, h_feats, CELLDIM);
+    run_hog(h_i, h_i8, rows, cols, h_feats, CELLDIM);
     // timing
     printf("fps: %f \n", 1.0f / (elapsed_time(0) / 1000.0f));
 #endif
@@ -432,6 +772,145 @@ void cell_hist_test(Mat& m_I, Mat& m_F) {
 }
 
 
+// one frame in flight
+struct pipeline_slot {
+    bool busy, scored;
+    int rows, cols;
+    hog_buffers* b;
+    long long t_grab;      // usec
+    double capture_ms;
+    cl_event up, first, last, rd_first, rd_last;
+};
+
+// per stage times, summed over the frames since the last report
+struct pipeline_stats {
+    double capture, upload, compute, readback, latency;
+    int frames;
+};
+
+// wait for a slot's frame, then report its detections and timings
+void retire_slot(pipeline_slot& p, int celldim, pipeline_stats& st) {
+
+    sclWaitEvent(p.scored ? p.rd_last : p.last);
+
+    st.capture  += p.capture_ms;
+    st.upload   += sclGetEventSpan(p.up, p.up) / 1e6;
+    st.compute  += sclGetEventSpan(p.first, p.last) / 1e6;
+    st.latency  += (user_time() - p.t_grab) / 1000.0;
+    st.frames   += 1;
+
+    if (p.scored) {
+        st.readback += sclGetEventSpan(p.rd_first, p.rd_last) / 1e6;
+        std::vector<hog_detection> dets;
+        collect_dets(*p.b, *p.b->h_ndets, p.cols, celldim, 1.f, dets);
+        report_dets(dets);
+        clReleaseEvent(p.rd_first);
+        clReleaseEvent(p.rd_last);
+    }
+    clReleaseEvent(p.up);
+    clReleaseEvent(p.first);
+    clReleaseEvent(p.last);
+    p.busy = false;
+
+}
+
+// camera loop with PIPELINE_DEPTH frames in flight: while frame n is
+// captured and converted into its slot's pinned staging, frame n-1 uploads
+// or computes and frame n-2 is read back.  Upload, compute and readback have
+// a queue each, chained by events, so transfers overlap kernels; a slot is
+// reused only after its frame has been retired.
+void run_pipeline(int celldim) {
+
+    sclHard q_up   = sclGetHardwareQueue(hardware);
+    sclHard q_comp = sclGetHardwareQueue(hardware);
+    sclHard q_rd   = sclGetHardwareQueue(hardware);
+
+    pipeline_slot slots[PIPELINE_DEPTH];
+    for (int i = 0; i < PIPELINE_DEPTH; ++i) { slots[i].busy = false; }
+    pipeline_stats st;
+    memset(&st, 0, sizeof(st));
+
+    Mat cam_img, mgray8;
+    int frame;
+    start_timer(1);
+    for (frame = 0; ; ++frame) {
+        int s = frame % PIPELINE_DEPTH;
+        pipeline_slot& p = slots[s];
+        if (p.busy) { retire_slot(p, celldim, st); }
+
+        // capture, straight into pinned staging
+        p.t_grab = user_time();
+        if (!grab_frame(cam_img, NULL)) { break; }
+        p.rows = cam_img.rows;
+        p.cols = cam_img.cols;
+        p.b = &pool_buffers(p.rows, p.cols, celldim, s, HOG_U8 ? IN_U8 : IN_FLOAT);
+#if HOG_U8
+        Mat staged(p.rows, p.cols, CV_8UC1, p.b->h_img8);
+        cvtColor(cam_img, staged, CV_BGR2GRAY);
+#else
+        Mat staged(p.rows, p.cols, CV_32FC1, p.b->h_img);
+        cvtColor(cam_img, mgray8, CV_BGR2GRAY);
+        mgray8.convertTo(staged, CV_32FC1, 1 / 255.0f);
+#endif
+        p.capture_ms = (user_time() - p.t_grab) / 1000.0;
+
+        // upload
+#if HOG_U8
+        p.up = sclWriteAsync(q_up, p.rows * p.cols, p.b->d_img8, p.b->h_img8);
+#else
+        p.up = sclWriteAsync(q_up, sizeof(float) * p.rows * p.cols, p.b->d_img, p.b->h_img);
+#endif
+        sclFlush(q_up);
+
+        // compute, once the frame is up
+        sclQueueWaitEvent(q_comp, p.up);
+#if HOG_U8
+        p.last = enqueue_grid_u8(q_comp, *p.b, p.rows, p.cols, celldim, &p.first);
+#else
+        p.last = enqueue_grid(q_comp, *p.b, p.rows, p.cols, celldim, &p.first);
+#endif
+        cl_event scored;
+        p.scored = enqueue_score_windows(q_comp, *p.b, p.rows, p.cols, celldim, &scored);
+        if (p.scored) {
+            clReleaseEvent(p.last);
+            p.last = scored;
+        }
+        sclFlush(q_comp);
+
+        // readback of the detections, once computed
+        if (p.scored) {
+            sclQueueWaitEvent(q_rd, p.last);
+            p.rd_first = sclReadAsync(q_rd, sizeof(int), p.b->d_ndets, p.b->h_ndets);
+            clReleaseEvent(sclReadAsync(q_rd, sizeof(int) * p.b->nscores, p.b->d_dets, p.b->h_dets));
+            p.rd_last = sclReadAsync(q_rd, sizeof(float) * p.b->nscores, p.b->d_det_scores, p.b->h_det_scores);
+            sclFlush(q_rd);
+        }
+        p.busy = true;
+
+        // sustained rate and mean stage times
+        if (st.frames >= PIPELINE_REPORT) {
+            double n = st.frames;
+            printf("capture %.2f upload %.2f compute %.2f readback %.2f latency %.2f ms, fps: %f \n",
+                   st.capture / n, st.upload / n, st.compute / n, st.readback / n, st.latency / n,
+                   n / (elapsed_time(1) / 1000.0));
+            memset(&st, 0, sizeof(st));
+            start_timer(1);
+        }
+    }
+
+    // drain, oldest first
+    for (int i = 1; i <= PIPELINE_DEPTH; ++i) {
+        pipeline_slot& p = slots[(frame + i) % PIPELINE_DEPTH];
+        if (p.busy) { retire_slot(p, celldim, st); }
+    }
+
+    sclReleaseHardwareQueue(q_up);
+    sclReleaseHardwareQueue(q_comp);
+    sclReleaseHardwareQueue(q_rd);
+
+}
+
+
 void printFloatMat(const Mat& thing) {
     for (int i = 0; i < thing.rows; i++) {
         const float* fptr = thing.ptr<float>(i);
@@ -591,64 +1070,6 @@ void training_loop(ifstream& myfile, ifstream& myfile2) {
 
 }
 
-float* load_svm(const char* fname, int& _numFeats, float& _b) {
-    ifstream inf;
-    char trash[256];
-    inf.open(fname);
-    string line;
-    //First, SVM_Light version string
-    inf.getline(trash, 256);
-    //kernel type
-    inf.getline(trash, 256);
-    //kernel parameter -d
-    inf.getline(trash, 256);
-    //kernel parameter -g
-    inf.getline(trash, 256);
-    //kernel parameter -s
-    inf.getline(trash, 256);
-    //kernel parameter -r
-    inf.getline(trash, 256);
-    //kernel parameter -u
-    inf.getline(trash, 256);
-    //Num features
-    int numFeats;
-    inf >> numFeats;
-    inf.getline(trash, 256);
-    //cout<<"Num features: "<<numFeats<<endl;
-    //Num training examples
-    inf.getline(trash, 256);
-    //Num support vectors
-    int numSV;
-    inf >> numSV;
-    //cout<<"Num SV's: "<<numSV<<endl;
-    inf.getline(trash, 256);
-    //B
-    float b;
-    inf >> b;
-    //cout<<"B: "<<b<<endl;
-    inf.getline(trash, 256);
-    float* w = new float[numFeats];
-    for (int i = 0; i < numFeats; i++) { w[i] = 0.0; }
-    for (int svCnt = 0; svCnt < numSV; svCnt++) {
-        double alphaTy, tmp;
-        inf >> alphaTy;
-        for (int fCnt = 0; fCnt > numFeats; fCnt++) {
-            //grab to the first :
-            inf.getline(trash, 256, ':');
-            inf >> tmp;
-            w[fCnt] += (float)tmp * alphaTy;
-        }
-    }
-    //cout<<"W = [ ";
-    //for(int i=0;i<numFeats;i++)
-    //	cout<<w[i]<<" ";
-    //cout<<"]"<<endl;
-    _b = b;
-    _numFeats = numFeats;
-    return w;
-}
-
-
 // =======================================
 
 int main(int argc, char** argv) {
@@ -668,11 +1089,12 @@ int main(int argc, char** argv) {
     }
 
     // simple-opencl
+#if !CPU_HOG
     int found;
     sclHard* allHardware;
     found = sclGetAllHardware(&allHardware);
     hardware = sclGetFastestDevice(allHardware, found);
-    for (int i = 0; i < NUM_KERNELS; ++i) { comp_flag[i] = false; }
+#endif
 
     // hist
     int ncells = (cam_img.rows / CELLDIM) * (cam_img.cols / CELLDIM);
@@ -680,13 +1102,20 @@ int main(int argc, char** argv) {
     printf("ncells = %d\n", ncells);
 
     // w
-    int numfeats;
-    float* h_w = load_svm("../data/learned_hog.txt", numfeats, h_b);
-    h_w_vec = h_w;
+    std::vector<float> h_w;
+    if (!hog_load_svm("../data/learned_hog.txt", h_w, h_b)) { cerr << "load svm fail" << endl; }
+    h_w_vec = h_w.empty() ? NULL : &h_w[0];
+    h_w_nfeats = h_w.size();
     // d_w = sclMalloc(hardware, CL_MEM_READ_WRITE,  sizeof(float) * ncells * NBINS);
     // sclWrite(hardware, sizeof(float) * ncells * NBINS, d_w, h_w);
 
 
+    // training features, binary plus svm-light (see hog_io.h)
+#if !DEMO_MODE
+    int nfeats = (TRAIN_WROWS / CELLDIM) * (TRAIN_WCOLS / CELLDIM) * NBINS;
+    if (!hog_feats_open(feats_out, "feats.bin", "feats.txt", nfeats)) { cerr << "open feats fail" << endl; }
+#endif
+
     // process main
     if (is_images) {
         // process file
@@ -695,16 +1124,31 @@ int main(int argc, char** argv) {
         training_loop(myfile, myfile2);
     } else {
         // process loop
+#if PIPELINE && !CPU_HOG
+        run_pipeline(CELLDIM);
+#else
         while (grab_frame(cam_img, NULL)) {
             cell_hist_test(cam_img, hists);
         }
+#endif
     }
 
     if (myfile.is_open()) { myfile.close(); }
     if (myfile2.is_open()) { myfile2.close(); }
-
-    free(h_w);
-    clReleaseMemObject(d_w);
+    if (feats_out.bin) { hog_feats_close(feats_out); }
+
+#if !CPU_HOG
+    release_buffer_pool();
+    for (size_t l = 0; l < level_queues.size(); ++l) { sclReleaseHardwareQueue(level_queues[l]); }
+    xfilter_k.release();
+    yfilter_k.release();
+    cart2polar_k.release();
+    window_hist_k.release();
+    grad_bins_u8_k.release();
+    window_hist_u8_k.release();
+    score_windows_k.release();
+    if (d_w) { clReleaseMemObject(d_w); }
+#endif
     return 0;
 }
 
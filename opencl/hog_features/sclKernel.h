@@ -0,0 +1,118 @@
+/*
+   Copyright [2011] [Chris McClanahan]
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+
+//
+// Typed kernel arguments for simpleCL
+//
+// sclKernel<Args...> is a kernel whose argument list is part of its type,
+// e.g. sclKernel<cl_mem, cl_mem, int, int> for xfilter.  bind() only takes
+// exactly those types, so a wrong count or type fails to compile instead of
+// being misread from a " %v %a" format string at runtime, and it only calls
+// clSetKernelArg for the arguments whose bytes changed since the last bind.
+// enqueue() neither finishes the queue nor, unless asked, creates an event,
+// so launches batch up until the caller flushes or reads.
+//
+
+#ifndef SCL_KERNEL_H_
+#define SCL_KERNEL_H_
+
+#include <string.h>
+#include <type_traits>
+#include <tuple>
+#include "simpleCL.h"
+
+// total bytes of a parameter pack
+template <typename... Ts> struct scl_sizeof_all;
+template <> struct scl_sizeof_all<> {
+    static const size_t value = 0;
+};
+template <typename T, typename... Ts> struct scl_sizeof_all<T, Ts...> {
+    static const size_t value = sizeof(T) + scl_sizeof_all<Ts...>::value;
+};
+
+template <typename... Args>
+class sclKernel {
+
+    static_assert(sizeof...(Args) > 0, "a kernel takes at least one argument");
+
+public:
+
+    sclKernel() : built_(false) {}
+
+    bool built() const { return built_; }
+
+    // compile (or load, see SCL_CACHE_DIR) the kernel; arguments are unset
+    void build(sclHard hardware, const char* path, const char* name) {
+        soft_ = sclGetCLSoftware((char*)path, (char*)name, hardware);
+        memset(bound_, 0, sizeof(bound_));
+        built_ = true;
+    }
+
+    void release() {
+        if (built_) { sclReleaseClSoft(soft_); }
+        built_ = false;
+    }
+
+    template <typename... Ts>
+    void bind(const Ts&... args) {
+        static_assert(std::is_same<std::tuple<Ts...>, std::tuple<Args...> >::value,
+                      "kernel arguments do not match the kernel's signature");
+        cl_uint index = 0;
+        size_t offset = 0;
+        int expand[] = { (set(index, offset, args), 0)... };
+        (void)expand;
+    }
+
+    // enqueue on hardware's queue; event, when given, must be released
+    void enqueue(sclHard hardware, size_t* global_work_size, size_t* local_work_size,
+                 cl_event* event = NULL) {
+#ifdef DEBUG
+        cl_int err;
+        err = clEnqueueNDRangeKernel(hardware.queue, soft_.kernel, 2, NULL,
+                                     global_work_size, local_work_size, 0, NULL, event);
+        if (err != CL_SUCCESS) {
+            printf("\nError on enqueue %s", soft_.kernelName);
+            sclPrintErrorFlags(err);
+        }
+#else
+        clEnqueueNDRangeKernel(hardware.queue, soft_.kernel, 2, NULL,
+                               global_work_size, local_work_size, 0, NULL, event);
+#endif
+    }
+
+private:
+
+    template <typename T>
+    void set(cl_uint& index, size_t& offset, const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "kernel arguments are copied as bytes");
+        if (!bound_[index] || memcmp(cache_ + offset, &value, sizeof(T)) != 0) {
+            memcpy(cache_ + offset, &value, sizeof(T));
+            sclSetKernelArg(soft_, index, sizeof(T), (void*)&value);
+            bound_[index] = true;
+        }
+        ++index;
+        offset += sizeof(T);
+    }
+
+    sclSoft soft_;
+    bool built_;
+    bool bound_[sizeof...(Args)];
+    unsigned char cache_[scl_sizeof_all<Args...>::value];
+
+};
+
+#endif /*SCL_KERNEL_H_*/
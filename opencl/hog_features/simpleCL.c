@@ -29,6 +29,7 @@ extern "C" {
 #endif
 
 #include "simpleCL.h"
+#include <unistd.h>
 
     void sclPrintErrorFlags(cl_int flag) {
         switch (flag) {
@@ -217,13 +218,128 @@ extern "C" {
         return program;
     }
 
-    void _sclBuildProgram(cl_program program, cl_device_id devices, const char* pName) {
+    const char* _sclBuildFlags(void) {
         // Build the program with 'mad' Optimization option
 #ifdef MAC
-        char* flags = "-cl-mad-enable -cl-fast-relaxed-math -DMAC";
+        return "-cl-mad-enable -cl-fast-relaxed-math -DMAC";
 #else
-        char* flags = "-cl-mad-enable -cl-fast-relaxed-math";
+        return "-cl-mad-enable -cl-fast-relaxed-math";
 #endif
+    }
+
+    /* 64 bit FNV-1a, chained over the strings of a cache key */
+    static unsigned long long _sclHash(unsigned long long hash, const char* s) {
+        while (*s) {
+            hash ^= (unsigned char)*s++;
+            hash *= 1099511628211ULL;
+        }
+        return hash ^ 0xff; /* separator, so "ab","c" != "a","bc" */
+    }
+
+    /* Cache file of the program in path as built for hardware.  Everything
+       the binary depends on goes into the name, so a new driver, device, flag
+       set or source simply misses and the stale file is never read. */
+    void _sclProgramCachePath(char* cachePath, size_t size, const char* path, const char* source, sclHard hardware) {
+        char info[1024];
+        const char* base;
+        unsigned long long hash = 14695981039346656037ULL;
+        cl_device_info keys[] = { CL_DEVICE_NAME, CL_DEVICE_VENDOR, CL_DEVICE_VERSION, CL_DRIVER_VERSION };
+        int i;
+        for (i = 0; i < 4; ++i) {
+            info[0] = '\0';
+            clGetDeviceInfo(hardware.device, keys[i], sizeof(info), info, NULL);
+            hash = _sclHash(hash, info);
+        }
+        info[0] = '\0';
+        clGetPlatformInfo(hardware.platform, CL_PLATFORM_VERSION, sizeof(info), info, NULL);
+        hash = _sclHash(hash, info);
+        hash = _sclHash(hash, _sclBuildFlags());
+        hash = _sclHash(hash, source);
+        base = strrchr(path, '/');
+        base = base ? base + 1 : path;
+        snprintf(cachePath, size, "%s/%s-%016llx.bin", SCL_CACHE_DIR, base, hash);
+    }
+
+    cl_program _sclLoadCachedProgram(const char* cachePath, sclHard hardware) {
+        cl_program program;
+        cl_int err, binStatus;
+        struct stat statbuf;
+        unsigned char* binary;
+        size_t size;
+        FILE* fh = fopen(cachePath, "rb");
+        if (fh == 0)
+        { return NULL; }
+        stat(cachePath, &statbuf);
+        size = statbuf.st_size;
+        binary = (unsigned char*)malloc(size);
+        if (size == 0 || fread(binary, size, 1, fh) != 1) {
+            fclose(fh);
+            free(binary);
+            return NULL;
+        }
+        fclose(fh);
+        program = clCreateProgramWithBinary(hardware.context, 1, &hardware.device, &size,
+                                            (const unsigned char**)&binary, &binStatus, &err);
+        free(binary);
+        if (err != CL_SUCCESS || binStatus != CL_SUCCESS) {
+            if (err == CL_SUCCESS) { clReleaseProgram(program); }
+            return NULL;
+        }
+        /* a binary still has to be built, which is only a link */
+        if (clBuildProgram(program, 1, &hardware.device, _sclBuildFlags(), NULL, NULL) != CL_SUCCESS) {
+            clReleaseProgram(program);
+            return NULL;
+        }
+        return program;
+    }
+
+    void _sclStoreCachedProgram(const char* cachePath, cl_program program, cl_device_id device) {
+        cl_uint nDevices = 0, i;
+        cl_device_id* devices;
+        size_t* sizes;
+        unsigned char** binaries;
+        char tmpPath[1024];
+        FILE* fh;
+        /* the program is built for every device of the context */
+        clGetProgramInfo(program, CL_PROGRAM_NUM_DEVICES, sizeof(cl_uint), &nDevices, NULL);
+        if (nDevices == 0)
+        { return; }
+        devices = (cl_device_id*)malloc(sizeof(cl_device_id) * nDevices);
+        sizes = (size_t*)malloc(sizeof(size_t) * nDevices);
+        binaries = (unsigned char**)malloc(sizeof(unsigned char*) * nDevices);
+        clGetProgramInfo(program, CL_PROGRAM_DEVICES, sizeof(cl_device_id) * nDevices, devices, NULL);
+        clGetProgramInfo(program, CL_PROGRAM_BINARY_SIZES, sizeof(size_t) * nDevices, sizes, NULL);
+        for (i = 0; i < nDevices; ++i) {
+            binaries[i] = (unsigned char*)malloc(sizes[i] ? sizes[i] : 1);
+        }
+        if (clGetProgramInfo(program, CL_PROGRAM_BINARIES, sizeof(unsigned char*) * nDevices, binaries, NULL) == CL_SUCCESS) {
+            for (i = 0; i < nDevices; ++i) {
+                if (devices[i] != device || sizes[i] == 0)
+                { continue; }
+                /* write aside, then rename, so a reader never sees half a file */
+                mkdir(SCL_CACHE_DIR, 0755);
+                snprintf(tmpPath, sizeof(tmpPath), "%s.%d.tmp", cachePath, (int)getpid());
+                fh = fopen(tmpPath, "wb");
+                if (fh == 0)
+                { break; }
+                if (fwrite(binaries[i], sizes[i], 1, fh) == 1 && fclose(fh) == 0) {
+                    rename(tmpPath, cachePath);
+                } else {
+                    remove(tmpPath);
+                }
+                break;
+            }
+        }
+        for (i = 0; i < nDevices; ++i) {
+            free(binaries[i]);
+        }
+        free(binaries);
+        free(sizes);
+        free(devices);
+    }
+
+    void _sclBuildProgram(cl_program program, cl_device_id devices, const char* pName) {
+        const char* flags = _sclBuildFlags();
 #ifdef DEBUG
         cl_int err;
         char build_c[4096];
@@ -281,7 +397,7 @@ extern "C" {
             sclPrintErrorFlags(err);
         }
 #else
-        clEnqueueNDRangeKernel(hardware.queue, software.kernel, 2, NULL, global_work_size, local_work_size, 0, NULL, NULL);
+        clEnqueueNDRangeKernel(hardware.queue, software.kernel, 2, NULL, global_work_size, local_work_size, 0, NULL, &myEvent);
 #endif
         return myEvent;
     }
@@ -735,18 +851,28 @@ extern "C" {
 
     sclSoft sclGetCLSoftware(char* path, char* name, sclHard hardware) {
         sclSoft software;
+        char cachePath[1024];
+        int cached;
         /* Load program source
          ########################################################### */
         char* source = _sclLoadProgramSource(path);
+        cached = SCL_CACHE_DIR[0] != '\0' && source != NULL;
         /* ########################################################### */
         sprintf(software.kernelName, "%s", name);
-        /* Create program objects from source
+        /* Reuse the binary of an earlier run, else build from source
+         and keep the binary for the next one
          ########################################################### */
-        software.program = _sclCreateProgram(source, hardware.context);
-        /* ########################################################### */
-        /* Build the program (compile it)
-         ############################################ */
-        _sclBuildProgram(software.program, hardware.device, name);
+        software.program = NULL;
+        if (cached) {
+            _sclProgramCachePath(cachePath, sizeof(cachePath), path, source, hardware);
+            software.program = _sclLoadCachedProgram(cachePath, hardware);
+        }
+        if (software.program == NULL) {
+            software.program = _sclCreateProgram(source, hardware.context);
+            _sclBuildProgram(software.program, hardware.device, name);
+            if (cached) { _sclStoreCachedProgram(cachePath, software.program, hardware.device); }
+        }
+        free(source);
         /* ############################################ */
         /* Create the kernel object
          ########################################################################## */
@@ -817,6 +943,77 @@ extern "C" {
 #endif
     }
 
+    /* Page locked host memory: a CL_MEM_ALLOC_HOST_PTR buffer, mapped once and
+       left mapped. *hostPointer is staging for sclWrite / sclRead, which then
+       skip the driver's own pinned copy. */
+    cl_mem sclMallocPinned(sclHard hardware, cl_int mode, size_t size, void** hostPointer) {
+        cl_mem buffer;
+#ifdef DEBUG
+        cl_int err;
+        buffer = clCreateBuffer(hardware.context, mode | CL_MEM_ALLOC_HOST_PTR, size, NULL, &err);
+        if (err != CL_SUCCESS) {
+            printf("\nclMallocPinned Error on clCreateBuffer\n  %lu \n", size);
+            sclPrintErrorFlags(err);
+        }
+        *hostPointer = clEnqueueMapBuffer(hardware.queue, buffer, CL_TRUE, CL_MAP_READ | CL_MAP_WRITE,
+                                          0, size, 0, NULL, NULL, &err);
+        if (err != CL_SUCCESS) {
+            printf("\nclMallocPinned Error on clEnqueueMapBuffer\n");
+            sclPrintErrorFlags(err);
+        }
+#else
+        buffer = clCreateBuffer(hardware.context, mode | CL_MEM_ALLOC_HOST_PTR, size, NULL, NULL);
+        *hostPointer = clEnqueueMapBuffer(hardware.queue, buffer, CL_TRUE, CL_MAP_READ | CL_MAP_WRITE,
+                                          0, size, 0, NULL, NULL, NULL);
+#endif
+        return buffer;
+    }
+
+    void sclReleasePinned(sclHard hardware, cl_mem buffer, void* hostPointer) {
+#ifdef DEBUG
+        cl_int err;
+        err = clEnqueueUnmapMemObject(hardware.queue, buffer, hostPointer, 0, NULL, NULL);
+        if (err != CL_SUCCESS) {
+            printf("\nclReleasePinned Error on clEnqueueUnmapMemObject\n");
+            sclPrintErrorFlags(err);
+        }
+#else
+        clEnqueueUnmapMemObject(hardware.queue, buffer, hostPointer, 0, NULL, NULL);
+#endif
+        clFinish(hardware.queue);
+        sclReleaseMemObject(buffer);
+    }
+
+    cl_event sclWriteAsync(sclHard hardware, size_t size, cl_mem buffer, void* hostPointer) {
+        cl_event myEvent;
+#ifdef DEBUG
+        cl_int err;
+        err = clEnqueueWriteBuffer(hardware.queue, buffer, CL_FALSE, 0, size, hostPointer, 0, NULL, &myEvent);
+        if (err != CL_SUCCESS) {
+            printf("\nclWriteAsync Error\n");
+            sclPrintErrorFlags(err);
+        }
+#else
+        clEnqueueWriteBuffer(hardware.queue, buffer, CL_FALSE, 0, size, hostPointer, 0, NULL, &myEvent);
+#endif
+        return myEvent;
+    }
+
+    cl_event sclReadAsync(sclHard hardware, size_t size, cl_mem buffer, void* hostPointer) {
+        cl_event myEvent;
+#ifdef DEBUG
+        cl_int err;
+        err = clEnqueueReadBuffer(hardware.queue, buffer, CL_FALSE, 0, size, hostPointer, 0, NULL, &myEvent);
+        if (err != CL_SUCCESS) {
+            printf("\nclReadAsync Error\n");
+            sclPrintErrorFlags(err);
+        }
+#else
+        clEnqueueReadBuffer(hardware.queue, buffer, CL_FALSE, 0, size, hostPointer, 0, NULL, &myEvent);
+#endif
+        return myEvent;
+    }
+
     cl_int sclFinish(sclHard hardware) {
         cl_int err;
 #ifdef DEBUG
@@ -831,6 +1028,56 @@ extern "C" {
         return err;
     }
 
+    void sclFlush(sclHard hardware) {
+#ifdef DEBUG
+        cl_int err;
+        err = clFlush(hardware.queue);
+        if (err != CL_SUCCESS) {
+            printf("\nError clFlush\n");
+            sclPrintErrorFlags(err);
+        }
+#else
+        clFlush(hardware.queue);
+#endif
+    }
+
+    /* The same device and context with a queue of its own, so transfers and
+       kernels on the two can overlap. */
+    sclHard sclGetHardwareQueue(sclHard hardware) {
+        sclHard other = hardware;
+#ifdef DEBUG
+        cl_int err;
+        other.queue = clCreateCommandQueue(hardware.context, hardware.device, CL_QUEUE_PROFILING_ENABLE, &err);
+        if (err != CL_SUCCESS) {
+            printf("\nError creating command queue");
+            sclPrintErrorFlags(err);
+        }
+#else
+        other.queue = clCreateCommandQueue(hardware.context, hardware.device, CL_QUEUE_PROFILING_ENABLE, NULL);
+#endif
+        return other;
+    }
+
+    void sclReleaseHardwareQueue(sclHard hardware) {
+        clFinish(hardware.queue);
+        clReleaseCommandQueue(hardware.queue);
+    }
+
+    /* Commands enqueued on hardware after this one wait for event, which may
+       come from another queue of the same context. */
+    void sclQueueWaitEvent(sclHard hardware, cl_event event) {
+#ifdef DEBUG
+        cl_int err;
+        err = clEnqueueWaitForEvents(hardware.queue, 1, &event);
+        if (err != CL_SUCCESS) {
+            printf("\nError clEnqueueWaitForEvents\n");
+            sclPrintErrorFlags(err);
+        }
+#else
+        clEnqueueWaitForEvents(hardware.queue, 1, &event);
+#endif
+    }
+
     cl_ulong sclGetEventTime(sclHard hardware, cl_event event) {
         cl_ulong elapsedTime, startTime, endTime;
         sclFinish(hardware);
@@ -840,6 +1087,18 @@ extern "C" {
         return elapsedTime;
     }
 
+    /* Device time from the start of first to the end of last, both complete. */
+    cl_ulong sclGetEventSpan(cl_event first, cl_event last) {
+        cl_ulong startTime, endTime;
+        clGetEventProfilingInfo(first, CL_PROFILING_COMMAND_START, sizeof(cl_ulong), &startTime, NULL);
+        clGetEventProfilingInfo(last, CL_PROFILING_COMMAND_END, sizeof(cl_ulong), &endTime, NULL);
+        return endTime - startTime;
+    }
+
+    void sclWaitEvent(cl_event event) {
+        clWaitForEvents(1, &event);
+    }
+
     void sclSetKernelArg(sclSoft software, int argnum, size_t typeSize, void* argument) {
 #ifdef DEBUG
         cl_int err;
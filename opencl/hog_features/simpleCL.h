@@ -41,6 +41,12 @@ extern "C" {
 
 #define DEBUG
 
+/* Compiled programs are kept here, one file per device, driver, build flags
+   and source; -DSCL_CACHE_DIR=\"\" turns the cache off. */
+#ifndef SCL_CACHE_DIR
+#define SCL_CACHE_DIR "sclcache"
+#endif
+
 #ifndef _OCLUTILS_STRUCTS
     typedef struct {
         cl_platform_id platform;
@@ -68,6 +74,10 @@ extern "C" {
     cl_mem 			sclMallocWrite(sclHard hardware, cl_int mode, size_t size, void* hostPointer);
     void 			sclWrite(sclHard hardware, size_t size, cl_mem buffer, void* hostPointer);
     void			sclRead(sclHard hardware, size_t size, cl_mem buffer, void* hostPointer);
+    cl_mem 			sclMallocPinned(sclHard hardware, cl_int mode, size_t size, void** hostPointer);
+    void 			sclReleasePinned(sclHard hardware, cl_mem buffer, void* hostPointer);
+    cl_event		sclWriteAsync(sclHard hardware, size_t size, cl_mem buffer, void* hostPointer);
+    cl_event		sclReadAsync(sclHard hardware, size_t size, cl_mem buffer, void* hostPointer);
 
     /* ######################################################## */
 
@@ -109,12 +119,18 @@ extern "C" {
     /* ####### Event queries ################################## */
 
     cl_ulong 		sclGetEventTime(sclHard hardware, cl_event event);
+    cl_ulong 		sclGetEventSpan(cl_event first, cl_event last);
+    void			sclWaitEvent(cl_event event);
 
     /* ######################################################## */
 
     /* ####### Queue management ############################### */
 
     cl_int			sclFinish(sclHard hardware);
+    void			sclFlush(sclHard hardware);
+    sclHard			sclGetHardwareQueue(sclHard hardware);
+    void			sclReleaseHardwareQueue(sclHard hardware);
+    void			sclQueueWaitEvent(sclHard hardware, cl_event event);
 
     /* ######################################################## */
 
@@ -148,6 +164,10 @@ extern "C" {
     cl_kernel 		_sclCreateKernel(sclSoft software);
     cl_program 		_sclCreateProgram(char* program_source, cl_context context);
     char* 			_sclLoadProgramSource(const char* filename);
+    const char*		_sclBuildFlags(void);
+    void			_sclProgramCachePath(char* cachePath, size_t size, const char* path, const char* source, sclHard hardware);
+    cl_program		_sclLoadCachedProgram(const char* cachePath, sclHard hardware);
+    void			_sclStoreCachedProgram(const char* cachePath, cl_program program, cl_device_id device);
 
     /* ######################################################## */
 